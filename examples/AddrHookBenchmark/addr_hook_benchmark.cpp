@@ -0,0 +1,62 @@
+#include <arion/arion.hpp>
+#include <arion/common/global_defs.hpp>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+#include "benchmark.hpp"
+
+using namespace arion;
+
+// Hooked addresses are spread over an area that is never executed, like entries of functions that are not called
+#define BENCH_HOOKS_ADDR 0x10000000
+#define BENCH_HOOKS_STEP 0x40
+#define BENCH_RUNS 10
+// Beyond this count, one Unicorn hook per address makes the run take minutes
+#define BENCH_MAX_UC_HOOKS 10000
+
+size_t hits = 0;
+
+void addr_hook(std::shared_ptr<Arion> arion, ADDR addr, size_t sz, void *user_data)
+{
+    hits++;
+}
+
+void run_benchmark(std::string name, size_t hooks_count, std::function<void(std::shared_ptr<Arion>, ADDR)> hook)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<LOG_LEVEL>("log_lvl", LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    // Arion::new_instance(args, fs_root, env, cwd, log_level, config)
+    std::shared_ptr<Arion> arion =
+        Arion::new_instance({"/bin/ls"}, "/", {}, std::filesystem::current_path(), std::move(config));
+    arion_group->add_arion_instance(arion);
+    for (size_t hook_i = 0; hook_i < hooks_count; hook_i++)
+        hook(arion, BENCH_HOOKS_ADDR + hook_i * BENCH_HOOKS_STEP);
+    std::shared_ptr<ARION_CONTEXT> ctxt = arion->context->save();
+    print_result(name + " x" + std::to_string(hooks_count), measure([&]() {
+                     for (size_t run_i = 0; run_i < BENCH_RUNS; run_i++)
+                     {
+                         arion_group->run();
+                         arion->context->restore(ctxt);
+                     }
+                 }),
+                 BENCH_RUNS, "run");
+}
+
+int main()
+{
+    std::cout << BENCH_RUNS << " executions of /bin/ls with address hooks on code that is never reached:" << std::endl;
+    for (size_t hooks_count = 1; hooks_count <= 100000; hooks_count *= 10)
+    {
+        run_benchmark("multiplexed (hook_addr)", hooks_count,
+                      [](std::shared_ptr<Arion> arion, ADDR addr) { arion->hooks->hook_addr(addr_hook, addr); });
+        if (hooks_count > BENCH_MAX_UC_HOOKS)
+            continue;
+        run_benchmark("per-address (hook_code)", hooks_count, [](std::shared_ptr<Arion> arion, ADDR addr) {
+            arion->hooks->hook_code(addr_hook, addr, addr);
+        });
+    }
+    return 0;
+}
@@ -1,7 +1,9 @@
 #include <arion/arion.hpp>
 #include <arion/common/global_defs.hpp>
 #include <arion/components/arion_afl.hpp>
+#include <cstdlib>
 #include <filesystem>
+#include <map>
 #include <memory>
 
 using namespace arion;
@@ -10,6 +12,12 @@ std::shared_ptr<ArionGroup> arion_group;
 ADDR read_buf = 0;
 size_t read_sz = 0;
 
+// Compare the exec/s reported by afl-fuzz for each strategy with : ARION_MEM_STRATEGY=UC_SNAPSHOT afl-fuzz ...
+std::map<std::string, ARION_MEM_STRATEGY> mem_strategies = {{"RECORD_EDITS", ARION_MEM_STRATEGY::RECORD_EDITS},
+                                                             {"RESTORE_MAPPINGS", ARION_MEM_STRATEGY::RESTORE_MAPPINGS},
+                                                             {"RAW_RESTORE", ARION_MEM_STRATEGY::RAW_RESTORE},
+                                                             {"UC_SNAPSHOT", ARION_MEM_STRATEGY::UC_SNAPSHOT}};
+
 bool input_callback(std::shared_ptr<Arion> arion, char *input, size_t input_sz, uint32_t persistent_round,
                     void *user_data)
 {
@@ -56,7 +64,11 @@ int main()
     HOOK_ID hook_sys_id = arion->hooks->hook_syscall(on_syscall_hook);
     arion_group->run();
     arion->hooks->unhook(hook_sys_id);
+    ARION_MEM_STRATEGY mem_strategy = ARION_MEM_STRATEGY::RECORD_EDITS;
+    char *mem_strategy_name = getenv("ARION_MEM_STRATEGY");
+    if (mem_strategy_name && mem_strategies.count(mem_strategy_name))
+        mem_strategy = mem_strategies.at(mem_strategy_name);
     ArionAfl afl(arion);
-    afl.fuzz(input_callback, crash_callback, {0});
+    afl.fuzz(input_callback, crash_callback, {0}, mem_strategy);
     return 0;
 }
@@ -0,0 +1,72 @@
+#include <arion/arion.hpp>
+#include <arion/common/baremetal_manager.hpp>
+#include <arion/common/global_defs.hpp>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include "benchmark.hpp"
+
+using namespace arion;
+
+#define BENCH_ADDR 0x10000000
+#define BENCH_SZ 0x10000
+#define BENCH_ITERATIONS 1000000
+
+int main()
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<LOG_LEVEL>("log_lvl", LOG_LEVEL::OFF);
+    std::unique_ptr<BaremetalManager> baremetal =
+        std::make_unique<BaremetalManager>(CPU_ARCH::X8664_ARCH, 0x400000, 0x400000);
+    // Arion::new_instance(baremetal, fs_root, env, cwd, log_level, config)
+    std::shared_ptr<Arion> arion =
+        Arion::new_instance(std::move(baremetal), "/", {}, std::filesystem::current_path(), std::move(config));
+    arion->mem->map(BENCH_ADDR, BENCH_SZ, 6);
+    // Builds a NULL terminated pointer array, as found in argv / envp
+    for (ADDR ptr_i = 0; ptr_i < 63; ptr_i++)
+        arion->mem->write<ADDR>(BENCH_ADDR + ptr_i * sizeof(ADDR), BENCH_ADDR + ptr_i);
+
+    volatile uint64_t sink = 0;
+    std::cout << BENCH_ITERATIONS << " iterations of each memory access:" << std::endl;
+    print_result("read(addr, 8) -> vector", measure([&]() {
+                     for (size_t i = 0; i < BENCH_ITERATIONS; i++)
+                         sink += arion->mem->read(BENCH_ADDR + (i % 0x100) * 8, 8).at(0);
+                 }),
+                 BENCH_ITERATIONS);
+    print_result("read_into(addr, buf, 8)", measure([&]() {
+                     uint64_t val;
+                     for (size_t i = 0; i < BENCH_ITERATIONS; i++)
+                     {
+                         arion->mem->read_into(BENCH_ADDR + (i % 0x100) * 8, &val, 8);
+                         sink += val;
+                     }
+                 }),
+                 BENCH_ITERATIONS);
+    print_result("read<uint64_t>(addr)", measure([&]() {
+                     for (size_t i = 0; i < BENCH_ITERATIONS; i++)
+                         sink += arion->mem->read<uint64_t>(BENCH_ADDR + (i % 0x100) * 8);
+                 }),
+                 BENCH_ITERATIONS);
+    print_result("read_ptr(addr)", measure([&]() {
+                     for (size_t i = 0; i < BENCH_ITERATIONS; i++)
+                         sink += arion->mem->read_ptr(BENCH_ADDR + (i % 0x100) * 8);
+                 }),
+                 BENCH_ITERATIONS);
+    print_result("write_val(addr, val, 8)", measure([&]() {
+                     for (size_t i = 0; i < BENCH_ITERATIONS; i++)
+                         arion->mem->write_val(BENCH_ADDR + 0x1000 + (i % 0x100) * 8, i, 8);
+                 }),
+                 BENCH_ITERATIONS);
+    print_result("write<uint64_t>(addr, val)", measure([&]() {
+                     for (size_t i = 0; i < BENCH_ITERATIONS; i++)
+                         arion->mem->write<uint64_t>(BENCH_ADDR + 0x1000 + (i % 0x100) * 8, i);
+                 }),
+                 BENCH_ITERATIONS);
+    print_result("read_ptr_arr(addr)", measure([&]() {
+                     for (size_t i = 0; i < BENCH_ITERATIONS / 64; i++)
+                         sink += arion->mem->read_ptr_arr(BENCH_ADDR).size();
+                 }),
+                 BENCH_ITERATIONS / 64, "array");
+    return 0;
+}
@@ -0,0 +1,65 @@
+#include <arion/arion.hpp>
+#include <arion/common/baremetal_manager.hpp>
+#include <arion/common/global_defs.hpp>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include "benchmark.hpp"
+
+using namespace arion;
+
+#define BENCH_ADDR 0x10000000
+#define BENCH_PAGE_SZ 0x1000
+#define BENCH_PAGES 10000
+
+void run_benchmark(bool host_backed_mem)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<LOG_LEVEL>("log_lvl", LOG_LEVEL::OFF);
+    config->set_field<bool>("host_backed_mem", host_backed_mem);
+    std::unique_ptr<BaremetalManager> baremetal =
+        std::make_unique<BaremetalManager>(CPU_ARCH::X8664_ARCH, 0x400000, 0x400000);
+    // Arion::new_instance(baremetal, fs_root, env, cwd, log_level, config)
+    std::shared_ptr<Arion> arion =
+        Arion::new_instance(std::move(baremetal), "/", {}, std::filesystem::current_path(), std::move(config));
+    // Heap whose every other page gets protected, as guard-page allocators and JIT engines do
+    arion->mem->map(BENCH_ADDR, BENCH_PAGES * 2 * BENCH_PAGE_SZ, 6);
+    for (size_t page_i = 0; page_i < BENCH_PAGES * 2; page_i++)
+        arion->mem->write<uint64_t>(BENCH_ADDR + page_i * BENCH_PAGE_SZ, page_i);
+
+    std::string suffix = host_backed_mem ? " (host memory)" : " (Unicorn memory)";
+    print_result("protect alternating pages" + suffix, measure([&]() {
+                     for (size_t page_i = 0; page_i < BENCH_PAGES; page_i++)
+                     {
+                         ADDR page_addr = BENCH_ADDR + page_i * 2 * BENCH_PAGE_SZ;
+                         arion->mem->protect(page_addr, page_addr + BENCH_PAGE_SZ, 4);
+                     }
+                 }),
+                 BENCH_PAGES, "page");
+    print_result("unprotect alternating pages" + suffix, measure([&]() {
+                     for (size_t page_i = 0; page_i < BENCH_PAGES; page_i++)
+                     {
+                         ADDR page_addr = BENCH_ADDR + page_i * 2 * BENCH_PAGE_SZ;
+                         arion->mem->protect(page_addr, page_addr + BENCH_PAGE_SZ, 6);
+                     }
+                 }),
+                 BENCH_PAGES, "page");
+    print_result("unmap alternating pages" + suffix, measure([&]() {
+                     for (size_t page_i = 0; page_i < BENCH_PAGES; page_i++)
+                     {
+                         ADDR page_addr = BENCH_ADDR + page_i * 2 * BENCH_PAGE_SZ;
+                         arion->mem->unmap(page_addr, page_addr + BENCH_PAGE_SZ);
+                     }
+                 }),
+                 BENCH_PAGES, "page");
+}
+
+int main()
+{
+    std::cout << BENCH_PAGES << " alternating pages of a " << BENCH_PAGES * 2 * BENCH_PAGE_SZ / 0x100000
+              << " MiB mapping:" << std::endl;
+    run_benchmark(false);
+    run_benchmark(true);
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <arion/arion.hpp>
+#include <arion/common/global_defs.hpp>
+#include <arion/unicorn/unicorn.h>
+#include <filesystem>
+#include <iostream>
+#include <memory>
+
+#include "benchmark.hpp"
+
+using namespace arion;
+
+#define BENCH_SWITCHES 1000000
+#define BENCH_RUNS 100
+
+std::shared_ptr<Arion> new_instance(std::string target, std::string fs_root)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<LOG_LEVEL>("log_lvl", LOG_LEVEL::OFF);
+    return Arion::new_instance({target}, fs_root, {}, std::filesystem::current_path(), std::move(config));
+}
+
+void bench_switch_primitives(std::shared_ptr<Arion> arion)
+{
+    // A thread switch saves the state of the current thread and loads the state of the next one
+    std::unique_ptr<RegisterFile> regs = arion->arch->dump_regs();
+    print_result("register file (dump/load_regs)", measure([&]() {
+                     for (size_t switch_i = 0; switch_i < BENCH_SWITCHES; switch_i++)
+                     {
+                         arion->arch->dump_regs(*regs);
+                         arion->arch->load_regs(*regs);
+                     }
+                 }),
+                 BENCH_SWITCHES);
+    uc_context *uc_ctxt;
+    uc_context_alloc(arion->uc, &uc_ctxt);
+    print_result("Unicorn context (save/restore)", measure([&]() {
+                     for (size_t switch_i = 0; switch_i < BENCH_SWITCHES; switch_i++)
+                     {
+                         uc_context_save(arion->uc, uc_ctxt);
+                         uc_context_restore(arion->uc, uc_ctxt);
+                     }
+                 }),
+                 BENCH_SWITCHES);
+    uc_context_free(uc_ctxt);
+}
+
+void bench_multi_thread(std::shared_ptr<Arion> arion)
+{
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    arion_group->add_arion_instance(arion);
+    std::shared_ptr<ARION_CONTEXT> ctxt = arion->context->save();
+    double elapsed = measure([&]() {
+        for (size_t run_i = 0; run_i < BENCH_RUNS; run_i++)
+        {
+            arion_group->run();
+            arion->context->restore(ctxt);
+        }
+    });
+    print_result("multi_thread executions", elapsed, BENCH_RUNS, "run");
+}
+
+int main(int argc, char **argv)
+{
+    if (argc < 2)
+    {
+        std::cerr << "Usage: " << argv[0] << " <multi_thread binary> [fs_root]" << std::endl;
+        std::cerr << "The multi_thread binary is built from tests/targets/multi_thread." << std::endl;
+        return 1;
+    }
+    std::string target = argv[1];
+    std::string fs_root = argc > 2 ? argv[2] : "/";
+
+    std::cout << BENCH_SWITCHES << " CPU state save/load pairs:" << std::endl;
+    bench_switch_primitives(new_instance(target, fs_root));
+    std::cout << BENCH_RUNS << " executions of " << target << ":" << std::endl;
+    bench_multi_thread(new_instance(target, fs_root));
+    return 0;
+}
@@ -0,0 +1,72 @@
+#include <arion/arion.hpp>
+#include <arion/common/code_tracer.hpp>
+#include <arion/common/global_defs.hpp>
+#include <filesystem>
+#include <functional>
+#include <iostream>
+#include <memory>
+
+#include "benchmark.hpp"
+
+using namespace arion;
+
+#define BENCH_RUNS 20
+
+void empty_hook(Arion &arion, ADDR addr, size_t sz, void *user_data)
+{
+}
+
+double bench_runs(std::shared_ptr<Arion> arion, std::function<void()> setup, std::function<void()> teardown)
+{
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    arion_group->add_arion_instance(arion);
+    std::shared_ptr<ARION_CONTEXT> ctxt = arion->context->save();
+    setup();
+    double elapsed = measure([&]() {
+        for (size_t run_i = 0; run_i < BENCH_RUNS; run_i++)
+        {
+            arion_group->run();
+            arion->context->restore(ctxt);
+        }
+    });
+    teardown();
+    return elapsed;
+}
+
+int main(int argc, char **argv)
+{
+    std::string target = argc > 1 ? argv[1] : "/bin/ls";
+    std::string fs_root = argc > 2 ? argv[2] : "/";
+    std::filesystem::path trace_path = std::filesystem::temp_directory_path() / "arion_tracer_benchmark.trc";
+
+    auto new_instance = [&]() {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<LOG_LEVEL>("log_lvl", LOG_LEVEL::OFF);
+        return Arion::new_instance({target}, fs_root, {}, std::filesystem::current_path(), std::move(config));
+    };
+    auto bench_tracer = [&](TRACE_MODE mode) {
+        std::shared_ptr<Arion> arion = new_instance();
+        return bench_runs(
+            arion, [&]() { arion->tracer->start(trace_path, mode); }, [&]() { arion->tracer->stop(); });
+    };
+
+    std::shared_ptr<Arion> arion = new_instance();
+    double base_elapsed = bench_runs(arion, []() {}, []() {});
+    arion = new_instance();
+    HOOK_ID hook_id;
+    double hook_elapsed = bench_runs(
+        arion, [&]() { hook_id = arion->hooks->hook_code_fast(empty_hook); },
+        [&]() { arion->hooks->unhook(hook_id); });
+    double instr_elapsed = bench_tracer(TRACE_MODE::INSTR);
+    double block_elapsed = bench_tracer(TRACE_MODE::BLOCK);
+    double ctxt_elapsed = bench_tracer(TRACE_MODE::CTXT);
+    std::filesystem::remove(trace_path);
+
+    std::cout << BENCH_RUNS << " executions of " << target << ":" << std::endl;
+    print_ratio("no hook", base_elapsed, base_elapsed);
+    print_ratio("empty code hook", hook_elapsed, base_elapsed);
+    print_ratio("tracer (INSTR)", instr_elapsed, base_elapsed);
+    print_ratio("tracer (BLOCK)", block_elapsed, base_elapsed);
+    print_ratio("tracer (CTXT)", ctxt_elapsed, base_elapsed);
+    return 0;
+}
@@ -0,0 +1,69 @@
+#ifndef ARION_EXAMPLES_BENCHMARK_HPP
+#define ARION_EXAMPLES_BENCHMARK_HPP
+
+#include <functional>
+#include <iomanip>
+#include <iostream>
+#include <string>
+#include <time.h>
+
+/// Width of the column holding the names of the measured operations.
+#define BENCH_NAME_WIDTH 40
+
+/**
+ * Measures the wall time taken by a function.
+ * @param[in] func The function to be measured.
+ * @return The elapsed time, in seconds.
+ */
+inline double measure(std::function<void()> func)
+{
+    struct timespec start, end;
+    clock_gettime(CLOCK_MONOTONIC, &start);
+    func();
+    clock_gettime(CLOCK_MONOTONIC, &end);
+    return (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+}
+
+/**
+ * Prints the time taken by a measured function, along with the mean time of one of its operations.
+ * @param[in] name Name of the measured operations.
+ * @param[in] elapsed Elapsed time, in seconds.
+ * @param[in] ops Number of operations performed by the measured function.
+ * @param[in] op_name Name of one operation, printed with its mean time.
+ */
+inline void print_result(std::string name, double elapsed, size_t ops, std::string op_name = "op")
+{
+    double op_elapsed = elapsed / ops;
+    std::string unit = "s";
+    if (op_elapsed < 1e-6)
+    {
+        op_elapsed *= 1e9;
+        unit = "ns";
+    }
+    else if (op_elapsed < 1e-3)
+    {
+        op_elapsed *= 1e6;
+        unit = "us";
+    }
+    else if (op_elapsed < 1)
+    {
+        op_elapsed *= 1e3;
+        unit = "ms";
+    }
+    std::cout << std::left << std::setw(BENCH_NAME_WIDTH) << name << +elapsed << " seconds (" << +op_elapsed << " "
+              << unit << "/" << op_name << ")" << std::endl;
+}
+
+/**
+ * Prints the time taken by a measured function, relative to a baseline.
+ * @param[in] name Name of the measured operations.
+ * @param[in] elapsed Elapsed time, in seconds.
+ * @param[in] base_elapsed Elapsed time of the baseline, in seconds.
+ */
+inline void print_ratio(std::string name, double elapsed, double base_elapsed)
+{
+    std::cout << std::left << std::setw(BENCH_NAME_WIDTH) << name << +elapsed << " seconds (x"
+              << +(elapsed / base_elapsed) << ")" << std::endl;
+}
+
+#endif // ARION_EXAMPLES_BENCHMARK_HPP
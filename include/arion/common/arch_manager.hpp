@@ -11,6 +11,7 @@
 #include <map>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 /// If this flag is set, the loader will map the VVAR segment
@@ -125,6 +126,121 @@ struct ARION_EXPORT ARCH_ATTRIBUTES
           calling_conv(calling_conv), syscalling_conv(syscalling_conv), name_by_syscall_no(name_by_syscall_no) {};
 };
 
+/// Layout of a RegisterFile, stored as a struct of arrays indexed by the position of a register in the file.
+struct ARION_EXPORT REG_FILE_LAYOUT
+{
+    /// Unicorn registers held in the file.
+    std::vector<REG> regs;
+    /// Unicorn registers held in the file, in the form expected by uc_reg_read_batch and uc_reg_write_batch.
+    std::vector<int> uc_regs;
+    /// Natural size in bytes of each register.
+    std::vector<uint8_t> regs_sz;
+    /// Offset of each register value in the file data.
+    std::vector<size_t> regs_off;
+    /// A map identifying the position of a register in the file, given the register.
+    std::unordered_map<REG, size_t> idx_by_reg;
+    /// Size in bytes of the file data.
+    size_t data_sz = 0;
+    /**
+     * Builder for REG_FILE_LAYOUT instances.
+     * @param[in] regs Unicorn registers held in the file.
+     * @param[in] regs_sz Natural size in bytes of each register.
+     */
+    REG_FILE_LAYOUT(std::vector<REG> regs, std::vector<uint8_t> regs_sz);
+};
+
+/// A flat set of register values sharing a precomputed layout, which can be dumped from or loaded to the CPU with a
+/// single batch call and without any allocation.
+class ARION_EXPORT RegisterFile
+{
+  private:
+    /// Layout shared by all register files holding the same registers.
+    std::shared_ptr<REG_FILE_LAYOUT> layout;
+    /// Register values, each stored at its layout offset.
+    std::vector<uint64_t> data;
+    /// Pointer to each register value, in the form expected by uc_reg_read_batch and uc_reg_write_batch.
+    std::vector<void *> vals;
+    /**
+     * Computes the pointer to each register value in the data.
+     */
+    void bind_vals();
+
+  public:
+    /**
+     * Builder for RegisterFile instances. Register values are zero-initialized.
+     * @param[in] layout Layout of the register file.
+     */
+    RegisterFile(std::shared_ptr<REG_FILE_LAYOUT> layout);
+    /**
+     * Builder for RegisterFile instances used to clone a RegisterFile instance.
+     * @param[in] regs The RegisterFile instance to be cloned.
+     */
+    RegisterFile(const RegisterFile &regs);
+    /**
+     * Copies the layout and values of another RegisterFile instance.
+     * @param[in] regs The RegisterFile instance to be copied.
+     * @return This instance.
+     */
+    RegisterFile &operator=(const RegisterFile &regs);
+    /**
+     * Retrieves the layout of the register file.
+     * @return The layout.
+     */
+    std::shared_ptr<REG_FILE_LAYOUT> ARION_EXPORT get_layout();
+    /**
+     * Retrieves the number of registers held in the file.
+     * @return The number of registers.
+     */
+    size_t ARION_EXPORT count();
+    /**
+     * Retrieves the register at a given position in the file.
+     * @param[in] reg_i The register position.
+     * @return The Unicorn register.
+     */
+    REG ARION_EXPORT get_reg_at(size_t reg_i);
+    /**
+     * Checks whether the file holds a given register.
+     * @param[in] reg The Unicorn register.
+     * @return True if the file holds the register.
+     */
+    bool ARION_EXPORT has_reg(REG reg);
+    /**
+     * Retrieves the value of the register at a given position in the file.
+     * @param[in] reg_i The register position.
+     * @return The register value, zero-extended.
+     */
+    RVAL ARION_EXPORT get_at(size_t reg_i);
+    /**
+     * Retrieves the value of a register.
+     * @param[in] reg The Unicorn register.
+     * @return The register value, zero-extended.
+     */
+    RVAL ARION_EXPORT get(REG reg);
+    /**
+     * Defines the value of the register at a given position in the file.
+     * @param[in] reg_i The register position.
+     * @param[in] val The new register value, truncated to the register size.
+     */
+    void ARION_EXPORT set_at(size_t reg_i, RVAL val);
+    /**
+     * Defines the value of a register.
+     * @param[in] reg The Unicorn register.
+     * @param[in] val The new register value, truncated to the register size.
+     */
+    void ARION_EXPORT set(REG reg, RVAL val);
+    /**
+     * Retrieves the registers held in the file, in the form expected by uc_reg_read_batch and uc_reg_write_batch.
+     * @return The Unicorn registers.
+     */
+    int ARION_EXPORT *get_uc_regs();
+    /**
+     * Retrieves the pointers to the register values, in the form expected by uc_reg_read_batch and
+     * uc_reg_write_batch.
+     * @return The pointers to the register values.
+     */
+    void ARION_EXPORT **get_uc_vals();
+};
+
 /// Fields for Interrupt Descriptor Tables.
 enum ARION_EXPORT CPU_INTR
 {
@@ -199,6 +315,8 @@ class ARION_EXPORT ArchManager
     std::map<REG, uint8_t> arch_regs_sz;
     /// Unicorn registers making up the context to save and restore.
     std::vector<REG> ctxt_regs;
+    /// Layout of the register files holding the context registers.
+    std::shared_ptr<REG_FILE_LAYOUT> ctxt_layout;
     /// Interrupt Descriptor Table for the CPU.
     std::map<uint64_t, CPU_INTR> cpu_idt;
     /// True if the ArchManager subclass uses hook_intr to intercept syscalls.
@@ -215,8 +333,14 @@ class ARION_EXPORT ArchManager
     ArchManager(std::shared_ptr<ARCH_ATTRIBUTES> attrs, std::map<std::string, REG> arch_regs,
                 std::map<REG, uint8_t> arch_regs_sz, std::vector<REG> ctxt_regs, std::map<uint64_t, CPU_INTR> cpu_idt,
                 bool hooks_intr)
-        : attrs(attrs), arch_regs(arch_regs), arch_regs_sz(arch_regs_sz), ctxt_regs(ctxt_regs), cpu_idt(cpu_idt),
-          hooks_intr(hooks_intr) {};
+        : attrs(attrs), arch_regs(arch_regs), arch_regs_sz(arch_regs_sz), ctxt_regs(ctxt_regs),
+          ctxt_layout(this->make_reg_file_layout(ctxt_regs)), cpu_idt(cpu_idt), hooks_intr(hooks_intr) {};
+    /**
+     * Builds the layout of register files holding a given list of registers, with their natural size.
+     * @param[in] regs The Unicorn registers.
+     * @return The register file layout.
+     */
+    std::shared_ptr<REG_FILE_LAYOUT> make_reg_file_layout(std::vector<REG> regs);
 
   public:
     /*
@@ -272,15 +396,31 @@ class ARION_EXPORT ArchManager
      */
     std::vector<REG> ARION_EXPORT get_context_regs();
     /**
-     * During emulation, dumps values of registers making up the context inside a map.
-     * @return A map identifying a value by its associated register.
+     * Creates a register file holding the registers making up the context.
+     * @return The zero-initialized register file.
      */
-    std::unique_ptr<std::map<REG, RVAL>> ARION_EXPORT dump_regs();
+    std::unique_ptr<RegisterFile> ARION_EXPORT new_reg_file();
     /**
-     * During emulation, loads values of registers making up the context from a map.
+     * Creates a register file holding the registers of a map, with their associated values.
      * @param[in] regs A map identifying a value by its associated register.
+     * @return The register file.
+     */
+    std::unique_ptr<RegisterFile> ARION_EXPORT new_reg_file(std::map<REG, RVAL> &regs);
+    /**
+     * During emulation, dumps values of registers making up the context inside a new register file.
+     * @return The register file.
+     */
+    std::unique_ptr<RegisterFile> ARION_EXPORT dump_regs();
+    /**
+     * During emulation, dumps values of the registers held in an existing register file, using a single batch read.
+     * @param[out] regs The register file to be filled.
+     */
+    void ARION_EXPORT dump_regs(RegisterFile &regs);
+    /**
+     * During emulation, loads values of the registers held in a register file, using a single batch write.
+     * @param[in] regs The register file.
      */
-    void ARION_EXPORT load_regs(std::unique_ptr<std::map<REG, RVAL>> regs);
+    void ARION_EXPORT load_regs(RegisterFile &regs);
     /**
      * Checks whether this CPU architecture has a given Interrupt Descriptor Table entry.
      * @param[in] intno The interrupt number.
@@ -294,13 +434,13 @@ class ARION_EXPORT ArchManager
      */
     CPU_INTR ARION_EXPORT get_idt_entry(uint64_t intno);
     /**
-     * Initializes a map of values associated to registers, with a PC and SP value. This method is used when
-     * instanciating a new thread, where only these two registers are initialized.
+     * Initializes a register file, with a PC and SP value. This method is used when instanciating a new thread, where
+     * only these two registers are initialized.
      * @param[in] pc The Unicorn PC register.
      * @param[in] sp The Unicorn SP register.
-     * @return The map of values associated to registers.
+     * @return The register file.
      */
-    std::unique_ptr<std::map<REG, RVAL>> init_thread_regs(ADDR pc, ADDR sp);
+    std::unique_ptr<RegisterFile> init_thread_regs(ADDR pc, ADDR sp);
     /**
      * Retrieves a Keystone engine associated with this instance, based on the current mode of the CPU.
      * @return The Keystone engine.
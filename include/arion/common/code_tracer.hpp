@@ -1,18 +1,23 @@
 #ifndef ARION_CODE_TRACER_HPP
 #define ARION_CODE_TRACER_HPP
 
+#include <arion/common/arch_manager.hpp>
 #include <arion/common/global_defs.hpp>
 #include <arion/common/hooks_manager.hpp>
 #include <arion/common/memory_manager.hpp>
+#include <condition_variable>
+#include <deque>
 #include <fstream>
 #include <iosfwd>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
 
-/// For a "light" TRACE_MODE, size at which the hits list should be flushed in the output trace file.
-#define ARION_MAX_LIGHT_HITS 1024
-/// For a "heavy" TRACE_MODE, size at which the hits list should be flushed in the output trace file.
-#define ARION_MAX_HEAVY_HITS 64
+/// For a "light" TRACE_MODE, size at which a hits buffer is handed over to the trace writer thread.
+#define ARION_MAX_LIGHT_HITS 0x10000
+/// For a "heavy" TRACE_MODE, size at which a hits buffer is handed over to the trace writer thread.
+#define ARION_MAX_HEAVY_HITS 0x400
 
 namespace arion
 {
@@ -22,7 +27,7 @@ class Arion;
 /// Magic string for headers of Arion tracer files.
 const char TRACER_FILE_MAGIC[] = "ARIONTRC";
 /// Version number of Arion tracer file format.
-const float TRACER_FILE_VERSION = 1.0;
+const float TRACER_FILE_VERSION = 2.0;
 /// Header size of Arion tracer files.
 const uint16_t TRACER_FILE_HEADER_SIZE = 0x28;
 
@@ -51,7 +56,7 @@ struct ARION_EXPORT CODE_HIT
     uint16_t sz;
     /// ID of the hit module.
     uint16_t mod_id;
-    /// CPU context as a map of register values. Only used in TRACE_MODE::CTXT.
+    /// CPU context as a map of register values. Only filled when reading TRACE_MODE::CTXT files.
     std::unique_ptr<std::map<REG, RVAL>> regs;
 
     /**
@@ -88,6 +93,65 @@ struct TRACER_MAPPING
     TRACER_MAPPING(ADDR start, ADDR end, std::string name) : start(start), end(end), name(name) {};
 };
 
+/// A hit waiting to be flushed in the output trace file, laid out as it is written.
+struct TRACER_HIT
+{
+    /// Offset of the hit relative to the start address of its module.
+    uint32_t off;
+    /// Size of the hit.
+    uint16_t sz;
+    /// ID of the hit module.
+    uint16_t mod_id;
+};
+
+/// A buffer of hits filled by the emulation thread, then written in the output trace file by the trace writer thread.
+struct TRACER_BUFFER
+{
+    /// Preallocated hits (instructions or basic blocks).
+    std::vector<TRACER_HIT> hits;
+    /// CPU context of each hit, preallocated in TRACE_MODE::CTXT.
+    std::vector<RegisterFile> regs;
+    /// Number of hits stored in the buffer.
+    size_t count = 0;
+};
+
+/// Flag of an encoded hit, set when its module ID differs from the one of the previous hit.
+const uint8_t TRACER_HIT_MOD_FLAG = 0x1;
+/// Flag of an encoded hit, set when its size differs from the one of the previous hit.
+const uint8_t TRACER_HIT_SZ_FLAG = 0x2;
+/// Number of flag bits at the start of an encoded hit.
+const uint8_t TRACER_HIT_FLAGS_BITS = 2;
+
+/// Header of a chunk of encoded hits, in the data section of a version 2 trace file. Chunks can be decoded
+/// independently from each other.
+struct TRACER_CHUNK_HEADER
+{
+    /// Number of hits in the chunk.
+    uint32_t hits;
+    /// Size in bytes of the encoded hits following the header.
+    uint32_t data_sz;
+};
+
+/// Entry of the chunks section of a version 2 trace file, used to seek to a hit without decoding the previous chunks.
+struct TRACER_CHUNK
+{
+    /// Offset in the trace file to the chunk header.
+    off_t off;
+    /// Index of the first hit of the chunk.
+    uint64_t first_hit;
+};
+
+/// Address range of a traced module, used to find the module of a hit.
+struct TRACER_RANGE
+{
+    /// Start address of the module.
+    ADDR start;
+    /// End address of the module.
+    ADDR end;
+    /// ID of the module.
+    uint16_t mod_id;
+};
+
 /// This class is used to perform tracing operations over an Arion emulation and store the result in a dedicated file.
 class ARION_EXPORT CodeTracer
 {
@@ -111,10 +175,47 @@ class ARION_EXPORT CodeTracer
     off_t total_hits_off;
     /// Offset in the output trace file to the modules section.
     off_t mod_sec_off;
-    /// List of code hits (instructions or basic blocks) which have not yet been flushed in the output trace file.
-    std::vector<std::unique_ptr<CODE_HIT>> hits;
+    /// Offset in the output trace file to the chunks section.
+    off_t chunks_sec_off;
+    /// Position of every chunk written in the output trace file.
+    std::vector<TRACER_CHUNK> chunks;
+    /// Number of hits written in the output trace file.
+    uint64_t written_hits = 0;
+    /// All the hits buffers allocated for the current trace.
+    std::vector<std::unique_ptr<TRACER_BUFFER>> buffers;
+    /// Buffer currently filled by the emulation thread.
+    TRACER_BUFFER *curr_buf = nullptr;
+    /// Buffers waiting to be filled by the emulation thread.
+    std::deque<TRACER_BUFFER *> free_bufs;
+    /// Buffers waiting to be written by the trace writer thread.
+    std::deque<TRACER_BUFFER *> full_bufs;
+    /// Protects "free_bufs", "full_bufs" and "writer_stop".
+    std::mutex bufs_mutex;
+    /// Notifies the trace writer thread that a buffer was filled or that it should stop.
+    std::condition_variable full_cv;
+    /// Notifies the emulation thread that a buffer was written.
+    std::condition_variable free_cv;
+    /// Thread writing the filled buffers in the output trace file.
+    std::thread writer;
+    /// True if the trace writer thread should exit once all filled buffers are written.
+    bool writer_stop = false;
+    /// True if the emulation thread waits for a written buffer when all buffers are full. Otherwise, a new buffer is
+    /// allocated.
+    bool blocking = true;
+    /// Encoded hits of a buffer, used by the trace writer thread to issue a single write.
+    std::vector<BYTE> out_buf;
+    /// Register values of the previous encoded hit in TRACE_MODE::CTXT, at their RegisterFile layout offsets.
+    std::vector<BYTE> prev_regs;
     /// List of general data concerning memory mappings.
     std::vector<std::unique_ptr<TRACER_MAPPING>> mappings;
+    /// Address ranges of the modules, sorted by start address.
+    std::vector<TRACER_RANGE> ranges;
+    /// Range of the module of the last hit, checked before searching "ranges".
+    TRACER_RANGE last_range = {0, 0, 0};
+    /**
+     * Rebuilds the sorted address ranges of the modules, after "mappings" was edited.
+     */
+    void index_mappings();
     /**
      * This hook is triggered at every instruction. Of course it is disabled when only basic blocks are traced.
      * @param[in] arion The Arion instance that produced the instruction hit.
@@ -122,7 +223,7 @@ class ARION_EXPORT CodeTracer
      * @param[in] sz The size of the instruction that was hit.
      * @param[in] user_data Additional user data.
      */
-    static void instr_hook(std::shared_ptr<Arion> arion, ADDR addr, size_t sz, void *user_data);
+    static void instr_hook(Arion &arion, ADDR addr, size_t sz, void *user_data);
     /**
      * This hook is triggered at every basic block. Of course it is disabled when every instructions are traced.
      * @param[in] arion The Arion instance that produced the block hit.
@@ -130,7 +231,7 @@ class ARION_EXPORT CodeTracer
      * @param[in] sz The size of the block that was hit.
      * @param[in] user_data Additional user data.
      */
-    static void block_hook(std::shared_ptr<Arion> arion, ADDR addr, size_t sz, void *user_data);
+    static void block_hook(Arion &arion, ADDR addr, size_t sz, void *user_data);
     /**
      * Creates and initializes the output trace file with already known data.
      */
@@ -140,17 +241,45 @@ class ARION_EXPORT CodeTracer
      */
     void release_file();
     /**
-     * Called at every hit (instruction or basic block). Stores the hit in the "hits" vector and flushes the whole in
-     * the output trace file if necessary.
+     * Called at every hit (instruction or basic block). Stores the hit in the current buffer and hands it over to the
+     * trace writer thread when full.
+     * @param[in] arion The Arion instance that produced the hit.
      * @param[in] addr Address of the hit.
      * @param[in] sz Size of the hit. It can either be the size of the hit instruction or basic block depending on the
      * used TRACE_MODE.
      */
-    void process_hit(ADDR addr, size_t sz);
+    void process_hit(Arion &arion, ADDR addr, size_t sz);
     /**
-     * Flushes all hits in the "hits" vector into the output trace file.
+     * Hands the buffer being filled over to the trace writer thread and replaces it with a free one. Waits for the
+     * trace writer thread or allocates a new buffer if none is free, depending on the "trace_blocking" configuration.
      */
     void flush_hits();
+    /**
+     * Allocates a new hits buffer, sized after the used TRACE_MODE.
+     * @return The new buffer, owned by the "buffers" list.
+     */
+    TRACER_BUFFER *new_buffer();
+    /**
+     * Main loop of the trace writer thread. Writes filled buffers until "writer_stop" is set and all of them are
+     * written.
+     */
+    void writer_loop();
+    /**
+     * Writes all hits of a buffer into the output trace file. Called from the trace writer thread.
+     * @param[in] buf The buffer to be written.
+     */
+    void write_buffer(TRACER_BUFFER *buf);
+    /**
+     * Encodes all hits of a buffer as a chunk into "out_buf". Offsets are delta-encoded from the end of the previous
+     * hit, the module ID and size are only stored when they change and, in TRACE_MODE::CTXT, registers are stored at
+     * their natural size when their value changed since the previous hit.
+     * @param[in] buf The buffer to be encoded.
+     */
+    void encode_chunk(TRACER_BUFFER *buf);
+    /**
+     * Hands the last buffer over to the trace writer thread, waits for all buffers to be written and releases them.
+     */
+    void stop_writer();
 
   public:
     /**
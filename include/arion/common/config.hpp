@@ -14,8 +14,15 @@ class ARION_EXPORT Config
   private:
     /// A map identifying a configuration value given its name. The value can be of any type for genericity purpose and
     /// must be casted.
-    std::map<std::string, std::any> config_map = {
-        {"log_lvl", LOG_LEVEL::INFO}, {"enable_sleep_syscalls", false}, {"thread_blocking_io", false}};
+    std::map<std::string, std::any> config_map = {{"log_lvl", LOG_LEVEL::INFO},
+                                                  {"enable_sleep_syscalls", false},
+                                                  {"thread_blocking_io", false},
+                                                  {"host_backed_mem", false},
+                                                  {"adaptive_quantum", true},
+                                                  {"min_quantum", (size_t)ARION_MIN_CYCLES_PER_THREAD},
+                                                  {"max_quantum", (size_t)ARION_MAX_CYCLES_PER_THREAD},
+                                                  {"trace_buffers", (size_t)ARION_TRACE_BUFFERS},
+                                                  {"trace_blocking", true}};
 
   public:
     /**
@@ -34,6 +34,9 @@ struct ARION_EXPORT ARION_CONTEXT
     std::vector<std::unique_ptr<ARION_FILE>> file_list;
     /// List of all open socket connections in the Arion context.
     std::vector<std::unique_ptr<ARION_SOCKET>> socket_list;
+    /// Unicorn engine copy-on-write snapshot of the guest memory, when saved with ContextManager::save_snapshot. The
+    /// mappings in mapping_list then hold no data.
+    uc_context *uc_snapshot = nullptr;
     /*
      * Builder for ARION_CONTEXT instances.
      */
@@ -55,6 +58,15 @@ struct ARION_EXPORT ARION_CONTEXT
         : running_tid(running_tid), thread_list(std::move(thread_list)), futex_list(std::move(futex_list)),
           mapping_list(std::move(mapping_list)), file_list(std::move(file_list)),
           socket_list(std::move(socket_list)) {};
+    /**
+     * Destructor for ARION_CONTEXT instances.
+     */
+    ~ARION_CONTEXT()
+    {
+        if (uc_snapshot)
+            uc_context_free(uc_snapshot);
+        uc_snapshot = nullptr;
+    }
 };
 
 /// This class is used to operate over ARION_CONTEXT instances. It is able to save and load contexts with different
@@ -64,6 +76,13 @@ class ARION_EXPORT ContextManager
   private:
     /// The Arion instance which context is being managed.
     std::weak_ptr<Arion> arion;
+    /**
+     * Saves the current context of the associated Arion instance into an ARION_CONTEXT instance.
+     * @param[in] share_mem True if host-backed mappings should be shared copy-on-write with the context.
+     * @param[in] save_data True if the mappings data should be saved, false to only save their layout.
+     * @return The ARION_CONTEXT instance.
+     */
+    std::shared_ptr<ARION_CONTEXT> save_context(bool share_mem, bool save_data);
 
   public:
     /**
@@ -79,9 +98,11 @@ class ARION_EXPORT ContextManager
     ContextManager(std::weak_ptr<Arion> arion) : arion(arion) {};
     /**
      * Saves the current context of the associated Arion instance into an ARION_CONTEXT instance.
+     * @param[in] share_mem True if host-backed mappings should be shared copy-on-write with the context (see
+     * MemoryManager::share_mapping) instead of being copied. Such a context can't be saved to a file.
      * @return The ARION_CONTEXT instance.
      */
-    std::shared_ptr<ARION_CONTEXT> ARION_EXPORT save();
+    std::shared_ptr<ARION_CONTEXT> ARION_EXPORT save(bool share_mem = false);
     /**
      * Restores a saved ARION_CONTEXT into the associated Arion instance.
      * @param[in] ctx The ARION_CONTEXT to be restored.
@@ -98,6 +119,19 @@ class ARION_EXPORT ContextManager
      * @param[in] edits The history of memory operations to be reversed.
      */
     void ARION_EXPORT restore(std::shared_ptr<ARION_CONTEXT> ctx, std::vector<std::shared_ptr<ARION_MEM_EDIT>> edits);
+    /**
+     * Saves the current context of the associated Arion instance, taking a Unicorn engine copy-on-write snapshot of the
+     * guest memory instead of copying it. Host-backed mappings are first moved to memory owned by Unicorn engine. The
+     * restrictions of Unicorn engine on memory operations (e.g. changing protections) apply while the snapshot is used.
+     * @return The ARION_CONTEXT instance, which can only be restored with restore_snapshot.
+     */
+    std::shared_ptr<ARION_CONTEXT> ARION_EXPORT save_snapshot();
+    /**
+     * Restores an ARION_CONTEXT saved with save_snapshot into the associated Arion instance. Unicorn engine reverts the
+     * guest memory to the snapshot, only pages written since then are copied.
+     * @param[in] ctx The ARION_CONTEXT to be restored.
+     */
+    void ARION_EXPORT restore_snapshot(std::shared_ptr<ARION_CONTEXT> ctx);
     /**
      * Saves the current context of the associated Arion instance into a dedicated file.
      * @param[in] file_path The path of the output context file.
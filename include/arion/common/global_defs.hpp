@@ -25,10 +25,18 @@
 #define ARION_MAX_U32 0xFFFFFFFF
 /// Maximum number for an unsigned 64-bit integer.
 #define ARION_MAX_U64 0xFFFFFFFFFFFFFFFF
+/// Maximum size in bytes of a 64-bit integer encoded as a variable-length integer.
+#define ARION_MAX_VARINT_SZ 0xA
 /// First PID value to be associated with an emulated process.
 #define ARION_PROCESS_PID 0x1
 /// Number of CPU cycles for a thread before switching to another one.
 #define ARION_CYCLES_PER_THREAD 0x1000
+/// Default lower bound of the adaptive number of CPU cycles for a thread before switching to another one.
+#define ARION_MIN_CYCLES_PER_THREAD 0x100
+/// Default upper bound of the adaptive number of CPU cycles for a thread before switching to another one.
+#define ARION_MAX_CYCLES_PER_THREAD 0x40000
+/// Default number of hit buffers shared by the emulation thread and the trace writer thread.
+#define ARION_TRACE_BUFFERS 0x4
 
 namespace arion
 {
@@ -6,6 +6,7 @@
 #include <arion/keystone/keystone.h>
 #include <arion/unicorn/unicorn.h>
 #include <arion/utils/convert_utils.hpp>
+#include <cerrno>
 #include <cstdint>
 #include <dlfcn.h>
 #include <execinfo.h>
@@ -343,6 +344,20 @@ class CantUnmapOutsideSegmentException : public ArionException
                          std::string("].")) {};
 };
 
+/// Thrown when host memory backing a memory segment can't be allocated.
+class HostMemAllocException : public ArionException
+{
+  public:
+    /**
+     * Builder for HostMemAllocException instances.
+     * @param[in] sz The size of the host memory that was attempted to be allocated.
+     */
+    explicit HostMemAllocException(size_t sz)
+        : ArionException(std::string("An error occurred while allocating host memory with size ") +
+                         arion::int_to_hex<size_t>(sz) + std::string(" : \"") + strerror(errno) +
+                         std::string("\".")) {};
+};
+
 /// Thrown when the CPU architecture is not supported.
 class UnsupportedCpuArchException : public ArionException
 {
@@ -642,6 +657,19 @@ class UnicornCtlException : public ArionException
                          std::string("\".")) {};
 };
 
+/// Thrown when an error occurs while saving or restoring a context with the Unicorn engine.
+class UnicornContextException : public ArionException
+{
+  public:
+    /**
+     * Builder for UnicornContextException instances.
+     * @param[in] err Error code returned by the Unicorn engine.
+     */
+    explicit UnicornContextException(uc_err err)
+        : ArionException(std::string("An error occurred while saving or restoring a context with Unicorn engine : \"") +
+                         uc_strerror(err) + std::string("\".")) {};
+};
+
 /// Thrown when an error occurs while mapping a memory segment with the Unicorn engine.
 class UnicornMapException : public ArionException
 {
@@ -1125,6 +1153,61 @@ class MemoryRecorderAlreadyStoppedException : public ArionException
         : ArionException(std::string("MemoryRecorder is already stopped.")) {};
 };
 
+/// Thrown when attempting to start an EdgeCoverage collector that is already started.
+class EdgeCoverageAlreadyStartedException : public ArionException
+{
+  public:
+    /**
+     * Builder for EdgeCoverageAlreadyStartedException instances.
+     */
+    explicit EdgeCoverageAlreadyStartedException()
+        : ArionException(std::string("EdgeCoverage is already started.")) {};
+};
+
+/// Thrown when attempting to stop an EdgeCoverage collector that is already stopped.
+class EdgeCoverageAlreadyStoppedException : public ArionException
+{
+  public:
+    /**
+     * Builder for EdgeCoverageAlreadyStoppedException instances.
+     */
+    explicit EdgeCoverageAlreadyStoppedException()
+        : ArionException(std::string("EdgeCoverage is already stopped.")) {};
+};
+
+/// Thrown when attempting to start a CmpLog tracer that is already started.
+class CmpLogAlreadyStartedException : public ArionException
+{
+  public:
+    /**
+     * Builder for CmpLogAlreadyStartedException instances.
+     */
+    explicit CmpLogAlreadyStartedException() : ArionException(std::string("CmpLog is already started.")) {};
+};
+
+/// Thrown when attempting to stop a CmpLog tracer that is already stopped.
+class CmpLogAlreadyStoppedException : public ArionException
+{
+  public:
+    /**
+     * Builder for CmpLogAlreadyStoppedException instances.
+     */
+    explicit CmpLogAlreadyStoppedException() : ArionException(std::string("CmpLog is already stopped.")) {};
+};
+
+/// Thrown when a coverage bitmap size is not a non-zero power of two.
+class WrongCoverageMapSizeException : public ArionException
+{
+  public:
+    /**
+     * Builder for WrongCoverageMapSizeException instances.
+     * @param[in] map_sz The wrong bitmap size.
+     */
+    explicit WrongCoverageMapSizeException(size_t map_sz)
+        : ArionException(std::string("Coverage bitmap size ") + arion::int_to_hex<size_t>(map_sz) +
+                         std::string(" is not a power of two.")) {};
+};
+
 /// Thrown when the specified log level does not exist.
 class WrongLogLevelException : public ArionException
 {
@@ -8,12 +8,26 @@
 #include <map>
 #include <memory>
 #include <stack>
+#include <string>
+#include <unordered_map>
 #include <variant>
+#ifdef ARION_HOOK_PROFILING
+#include <chrono>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#endif
+
+/// Size of the memory area covered by a single Unicorn hook multiplexing address hooks.
+#define ARION_ADDR_HOOK_GROUP_SZ 0x1000
+/// Default number of memory accesses a batched memory trace hook buffers before delivering them.
+#define ARION_MEM_TRACE_SZ 0x4000
 
 namespace arion
 {
 
 class Arion; // forward declaration to prevent circular dependencies
+class HooksManager;
 
 /// ID associated with a hook when created.
 using HOOK_ID = uint64_t;
@@ -107,6 +121,71 @@ using PROCESS_HOOK_CALLBACK =
  */
 using SYSCALL_HOOK_CALLBACK = std::function<void(std::shared_ptr<Arion> arion, uint64_t sysno,
                                                  std::vector<SYS_PARAM> params, bool *handled, void *user_data)>;
+/// A memory access recorded by a batched memory trace hook.
+struct ARION_MEM_ACCESS
+{
+    /// Address of the instruction performing the access.
+    ADDR pc;
+    /// The memory address being accessed.
+    ADDR addr;
+    /// Value being written, or read for UC_MEM_READ_AFTER accesses.
+    int64_t val;
+    /// Size of the memory access.
+    uint32_t size;
+    /// Type of memory access (e.g., UC_MEM_READ, UC_MEM_WRITE, UC_MEM_READ_AFTER).
+    uc_mem_type type;
+};
+
+/**
+ * Hook that receives a batch of memory accesses, recorded in execution order.
+ * @param[in] arion Arion instance that triggered the hook.
+ * @param[in] accesses The recorded memory accesses, only valid during the call.
+ * @param[in] count Number of recorded memory accesses.
+ * @param[in] user_data Optional user-defined data passed to the hook.
+ */
+using MEM_TRACE_HOOK_CALLBACK = std::function<void(std::shared_ptr<Arion> arion, const ARION_MEM_ACCESS *accesses,
+                                                   size_t count, void *user_data)>;
+/**
+ * Low-overhead hook that takes address and size parameters and returns void. It is called through a plain function
+ * pointer with a reference to the Arion instance, which makes it suited to hooks triggered at every instruction.
+ * @param[in] arion Arion instance that triggered the hook.
+ * @param[in] addr A memory address, specific to the hook context.
+ * @param[in] sz A memory size, specific to the hook context.
+ * @param[in] user_data Optional user-defined data passed to the hook.
+ */
+using FAST_ADDR_SZ_HOOK_CALLBACK = void (*)(Arion &arion, ADDR addr, size_t sz, void *user_data);
+/**
+ * Low-overhead hook associated with a memory operation. It is called through a plain function pointer with a reference
+ * to the Arion instance, which makes it suited to hooks triggered at every memory access.
+ * @param[in] arion Arion instance that triggered the hook.
+ * @param[in] type Type of memory access (e.g., UC_MEM_READ, UC_MEM_WRITE, UC_MEM_FETCH).
+ * @param[in] addr The memory address being accessed.
+ * @param[in] size Size of the memory access.
+ * @param[in] val Value being read or written (if applicable).
+ * @param[in] user_data Optional user-defined data passed to the hook.
+ * @return True if the hook handled the event and should suppress default behavior; false otherwise.
+ */
+using FAST_MEM_HOOK_CALLBACK = bool (*)(Arion &arion, uc_mem_type type, uint64_t addr, int size, int64_t val,
+                                        void *user_data);
+/**
+ * Low-overhead hook that is called when execution transitions between two translation blocks.
+ * @param[in] arion Arion instance that triggered the hook.
+ * @param[in] cur Current translation block.
+ * @param[in] prev Previous translation block.
+ * @param[in] user_data Optional user-defined data passed to the hook.
+ */
+using FAST_EDGE_HOOK_CALLBACK = void (*)(Arion &arion, uc_tb *cur, uc_tb *prev, void *user_data);
+/**
+ * Low-overhead hook for TCG-level emulation events.
+ * @param[in] arion Arion instance that triggered the hook.
+ * @param[in] addr Guest address where the event occurred.
+ * @param[in] arg1 First argument associated with the event.
+ * @param[in] arg2 Second argument associated with the event.
+ * @param[in] size Size (in bytes) of the operation or data.
+ * @param[in] user_data Optional user-defined data passed to the hook.
+ */
+using FAST_TCG_HOOK_CALLBACK = void (*)(Arion &arion, uint64_t addr, uint64_t arg1, uint64_t arg2, int size,
+                                        void *user_data);
 /// Variant type that represents any possible hook callback type supported by Arion.
 using HOOK_CALLBACK = std::variant<NO_PARAM_HOOK_CALLBACK, NO_PARAM_BOOL_HOOK_CALLBACK, U32_HOOK_CALLBACK,
                                    ADDR_SZ_HOOK_CALLBACK, MEM_HOOK_CALLBACK, EDGE_HOOK_CALLBACK, TCG_HOOK_CALLBACK,
@@ -135,13 +214,144 @@ enum ARION_HOOK_TYPE
     TLB_FILL_HOOK,           ///< Triggered when the TLB is filled or a translation lookup occurs.
     FORK_HOOK,               ///< Triggered when a process forks or clones (child Arion instance is created).
     EXECVE_HOOK,             ///< Triggered when a process performs an execve-like operation (program replacement).
-    SYSCALL_HOOK             ///< Triggered on system call invocation (before or after handling).
+    SYSCALL_HOOK,            ///< Triggered on system call invocation (before or after handling).
+    ADDR_HOOK,               ///< Triggered when code execution reaches an exact address (multiplexed).
+    MEM_TRACE_HOOK           ///< Triggered with batches of memory accesses recorded in a buffer.
 };
 
 /// A map identifying a Unicorn hook type given its associated Arion hook type.
 extern std::map<ARION_HOOK_TYPE, uc_hook_type> ARION_UC_HOOK_TYPES;
 /// A map identifying a hook function given its associated Arion hook type.
 extern std::map<ARION_HOOK_TYPE, void *> ARION_UC_HOOK_FUNCS;
+/// A map identifying a low-overhead hook function given its associated Arion hook type.
+extern std::map<ARION_HOOK_TYPE, void *> ARION_UC_FAST_HOOK_FUNCS;
+
+/// Profiling counters of a hook, only updated when Arion is built with ARION_HOOK_PROFILING.
+struct ARION_HOOK_COUNTERS
+{
+    /// Number of times the hook was called.
+    uint64_t calls = 0;
+    /// Cumulative host CPU cycles (or timer ticks on hosts without a cycle counter) spent in the hook.
+    uint64_t cycles = 0;
+    /// Cumulative wall time spent in the hook, in nanoseconds.
+    uint64_t ns = 0;
+};
+
+/// Snapshot of the profiling counters of a hook.
+struct ARION_HOOK_STATS
+{
+    /// Arion type for the hook.
+    ARION_HOOK_TYPE type;
+    /// Label identifying the hook owner, empty if none was set.
+    std::string label;
+    /// Profiling counters of the hook.
+    ARION_HOOK_COUNTERS counters;
+};
+
+#ifdef ARION_HOOK_PROFILING
+/**
+ * Reads the host CPU cycles counter, or a monotonic timer on hosts without a cycle counter.
+ * @return The counter value.
+ */
+inline uint64_t read_host_cycles()
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#elif defined(__aarch64__)
+    uint64_t cycles;
+    asm volatile("mrs %0, cntvct_el0" : "=r"(cycles));
+    return cycles;
+#else
+    return std::chrono::steady_clock::now().time_since_epoch().count();
+#endif
+}
+
+/// Scoped profiler updating the counters of a hook with the time spent in its scope.
+class HookProfiler
+{
+  private:
+    /// Profiling counters being updated, shared so that a hook removing itself during its call can still be accounted.
+    std::shared_ptr<ARION_HOOK_COUNTERS> counters;
+    /// Host CPU cycles counter when the scope was entered.
+    uint64_t start_cycles;
+    /// Wall time in nanoseconds when the scope was entered.
+    uint64_t start_ns;
+
+  public:
+    /**
+     * Builder for HookProfiler instances, entering the profiled scope.
+     * @param[in] counters Profiling counters being updated.
+     */
+    HookProfiler(std::shared_ptr<ARION_HOOK_COUNTERS> counters) : counters(counters)
+    {
+        this->start_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                             std::chrono::steady_clock::now().time_since_epoch())
+                             .count();
+        this->start_cycles = read_host_cycles();
+    }
+    /**
+     * Destructor for HookProfiler instances, leaving the profiled scope.
+     */
+    ~HookProfiler()
+    {
+        uint64_t end_cycles = read_host_cycles();
+        uint64_t end_ns = std::chrono::duration_cast<std::chrono::nanoseconds>(
+                              std::chrono::steady_clock::now().time_since_epoch())
+                              .count();
+        this->counters->calls++;
+        this->counters->cycles += end_cycles - this->start_cycles;
+        this->counters->ns += end_ns - this->start_ns;
+    }
+};
+
+/// Profiles the rest of the enclosing scope into the given hook counters.
+#define ARION_PROFILE_HOOK(hook_counters) HookProfiler hook_profiler(hook_counters)
+/// Allocates the profiling counters of a new hook.
+#define ARION_NEW_HOOK_COUNTERS() std::make_shared<ARION_HOOK_COUNTERS>()
+#else
+#define ARION_PROFILE_HOOK(hook_counters)
+#define ARION_NEW_HOOK_COUNTERS() nullptr
+#endif
+
+/// Declarative filters which a filtered memory hook evaluates before calling its callback.
+struct ARION_MEM_HOOK_FILTER
+{
+    /// Lowest address of the instructions whose memory accesses trigger the hook.
+    ADDR pc_start = 0;
+    /// Highest address of the instructions whose memory accesses trigger the hook.
+    ADDR pc_end = ARION_MAX_U64;
+    /// Bitwise OR of the access sizes in bytes triggering the hook (e.g., 4 | 8 for 4-byte and 8-byte accesses).
+    uint32_t sizes = ARION_MAX_U32;
+    /// Lowest accessed value triggering the hook, compared as unsigned. Not supported by read hooks.
+    uint64_t val_min = 0;
+    /// Highest accessed value triggering the hook, compared as unsigned. Equal to val_min for an equality check.
+    uint64_t val_max = ARION_MAX_U64;
+    /// Number of hits after which the hook gets removed, 0 for no limit.
+    uint64_t budget = 0;
+};
+
+/// Runtime state of a filtered memory hook.
+struct ARION_HOOK_FILTER_STATE
+{
+    /// Filters evaluated before calling the hook callback.
+    ARION_MEM_HOOK_FILTER filter;
+    /// Unicorn PC register, only read when a PC range is set.
+    REG pc_reg;
+    /// Number of hits which passed the filters.
+    uint64_t hits = 0;
+    /// The HooksManager owning the hook, which removes it once its budget is exhausted.
+    HooksManager *hooks;
+    /// ID of the hook.
+    HOOK_ID hook_id = 0;
+    /**
+     * Builder for ARION_HOOK_FILTER_STATE instances.
+     * @param[in] filter Filters evaluated before calling the hook callback.
+     * @param[in] pc_reg Unicorn PC register.
+     * @param[in] hooks The HooksManager owning the hook.
+     */
+    ARION_HOOK_FILTER_STATE(ARION_MEM_HOOK_FILTER filter, REG pc_reg, HooksManager *hooks)
+        : filter(filter), pc_reg(pc_reg), hooks(hooks) {};
+};
 
 /// This structure is placed in the Unicorn user_data parameter of hooks.
 struct ARION_HOOK_PARAM
@@ -152,6 +362,10 @@ struct ARION_HOOK_PARAM
     HOOK_CALLBACK callback;
     /// Optional user-defined data passed to the hook.
     void *user_data;
+    /// Filters and state of a filtered memory hook, nullptr for other hooks.
+    std::unique_ptr<ARION_HOOK_FILTER_STATE> filter_state;
+    /// Profiling counters of the hook, nullptr unless Arion is built with ARION_HOOK_PROFILING.
+    std::shared_ptr<ARION_HOOK_COUNTERS> counters = ARION_NEW_HOOK_COUNTERS();
     /**
      * Builder for ARION_HOOK_PARAM instances.
      * @param[in] arion Arion instance that triggered the hook.
@@ -162,6 +376,60 @@ struct ARION_HOOK_PARAM
         : arion(arion), callback(callback), user_data(user_data) {};
 };
 
+/// This structure is placed in the Unicorn user_data parameter of low-overhead hooks. The Arion instance owns its hooks
+/// and outlives them, which allows to keep a plain reference to it.
+struct ARION_FAST_HOOK_PARAM
+{
+    /// Arion instance that triggered the hook.
+    Arion &arion;
+    /// A user-defined callback for the hook, whose type depends on the hook type.
+    void *callback;
+    /// Optional user-defined data passed to the hook.
+    void *user_data;
+    /// Profiling counters of the hook, nullptr unless Arion is built with ARION_HOOK_PROFILING.
+    std::shared_ptr<ARION_HOOK_COUNTERS> counters = ARION_NEW_HOOK_COUNTERS();
+    /**
+     * Builder for ARION_FAST_HOOK_PARAM instances.
+     * @param[in] arion Arion instance that triggered the hook.
+     * @param[in] callback A user-defined callback for the hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     */
+    ARION_FAST_HOOK_PARAM(Arion &arion, void *callback, void *user_data)
+        : arion(arion), callback(callback), user_data(user_data) {};
+};
+
+/// This structure is placed in the Unicorn user_data parameter of batched memory trace hooks and holds their buffer.
+struct ARION_MEM_TRACE
+{
+    /// Arion instance that triggered the hook.
+    std::weak_ptr<Arion> arion;
+    /// Unicorn PC register, read on every recorded access.
+    REG pc_reg;
+    /// Preallocated buffer of recorded memory accesses.
+    std::vector<ARION_MEM_ACCESS> accesses;
+    /// Number of memory accesses currently recorded in the buffer.
+    size_t count = 0;
+    /// A user-defined callback receiving the recorded memory accesses.
+    MEM_TRACE_HOOK_CALLBACK callback;
+    /// Optional user-defined data passed to the hook.
+    void *user_data;
+    /// Unicorn hook id of the block hook delivering the memory accesses at block boundaries, 0 if disabled.
+    uc_hook block_uc_id = 0;
+    /// Profiling counters of the hook, nullptr unless Arion is built with ARION_HOOK_PROFILING.
+    std::shared_ptr<ARION_HOOK_COUNTERS> counters = ARION_NEW_HOOK_COUNTERS();
+    /**
+     * Builder for ARION_MEM_TRACE instances.
+     * @param[in] arion Arion instance that triggered the hook.
+     * @param[in] pc_reg Unicorn PC register.
+     * @param[in] capacity Number of memory accesses the buffer can hold.
+     * @param[in] callback A user-defined callback receiving the recorded memory accesses.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     */
+    ARION_MEM_TRACE(std::weak_ptr<Arion> arion, REG pc_reg, size_t capacity, MEM_TRACE_HOOK_CALLBACK callback,
+                    void *user_data)
+        : arion(arion), pc_reg(pc_reg), accesses(capacity), callback(callback), user_data(user_data) {};
+};
+
 /// This structure holds information about an Arion hook.
 struct ARION_HOOK
 {
@@ -169,8 +437,23 @@ struct ARION_HOOK
     ARION_HOOK_TYPE type;
     /// Unicorn hook id associated with this Arion hook.
     uc_hook uc_id;
-    /// A structure holding data to be passed to the Arion hook when its associated Unicorn hook gets triggered.
+    /// A structure holding data to be passed to the Arion hook when its associated Unicorn hook gets triggered, nullptr
+    /// for low-overhead hooks.
     ARION_HOOK_PARAM *param;
+    /// A structure holding data to be passed to the low-overhead Arion hook when its associated Unicorn hook gets
+    /// triggered, nullptr for other hooks.
+    ARION_FAST_HOOK_PARAM *fast_param = nullptr;
+    /// Buffer of a batched memory trace hook, nullptr for other hooks.
+    ARION_MEM_TRACE *mem_trace = nullptr;
+    /// Exact address at which the hook triggers, for ADDR_HOOK hooks only.
+    ADDR addr = 0;
+    /// Label identifying the hook owner in profiling statistics.
+    std::string label;
+    /// System call number on which the hook triggers, for SYSCALL_HOOK hooks only. ARION_MAX_U64 means any system
+    /// call.
+    uint64_t sysno = ARION_MAX_U64;
+    /// True if the hook was removed while hooks were being triggered. It then gets swept once the triggers are done.
+    bool to_delete = false;
     /**
      * Builder for ARION_HOOK instances.
      * @param[in] type Arion type for the hook.
@@ -180,6 +463,15 @@ struct ARION_HOOK
      */
     ARION_HOOK(ARION_HOOK_TYPE type, uc_hook uc_id, ARION_HOOK_PARAM *param)
         : type(type), uc_id(uc_id), param(param) {};
+    /**
+     * Builder for ARION_HOOK instances.
+     * @param[in] type Arion type for the hook.
+     * @param[in] uc_id Unicorn hook id associated with this Arion hook.
+     * @param[in] fast_param A structure holding data to be passed to the low-overhead Arion hook when its associated
+     * Unicorn hook gets triggered.
+     */
+    ARION_HOOK(ARION_HOOK_TYPE type, uc_hook uc_id, ARION_FAST_HOOK_PARAM *fast_param)
+        : type(type), uc_id(uc_id), param(nullptr), fast_param(fast_param) {};
 };
 
 /**
@@ -363,6 +655,105 @@ void arion_tcg_opcode_hook(uc_engine *uc, uint64_t addr, uint64_t arg1, uint64_t
  * @return True if the hook handled the translation and default behavior should be suppressed.
  */
 bool arion_tlb_fill_hook(uc_engine *uc, uint64_t addr, uc_mem_type type, uc_tlb_entry *result, void *user_data);
+/// This structure holds information about the Unicorn hook shared by all address hooks of a memory area.
+struct ARION_ADDR_HOOK_GROUP
+{
+    /// Unicorn hook id associated with this group.
+    uc_hook uc_id = 0;
+    /// Lowest hooked address of the group.
+    ADDR start = 0;
+    /// Highest hooked address of the group.
+    ADDR end = 0;
+    /// Number of address hooks registered in the group.
+    size_t hooks_count = 0;
+};
+
+/**
+ * Unicorn hook that gets triggered when code execution reaches an address covered by an address hooks group, and
+ * dispatches it to the Arion hooks registered at this exact address.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] address Memory address of the instruction being executed.
+ * @param[in] size Size of the executed instruction in bytes.
+ * @param[in] user_data The HooksManager instance which owns the address hooks.
+ */
+void arion_addr_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data);
+/**
+ * Delivers the memory accesses recorded by a batched memory trace hook to its callback, and empties its buffer.
+ * @param[in] mem_trace The batched memory trace hook.
+ */
+void arion_flush_mem_trace(ARION_MEM_TRACE *mem_trace);
+/**
+ * Unicorn hook that gets triggered on a memory access and forwards it to an Arion hook only if the access passes the
+ * hook filters.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] access Type of memory access (e.g., UC_MEM_READ, UC_MEM_WRITE, UC_MEM_FETCH).
+ * @param[in] addr Memory address being accessed.
+ * @param[in] size Size of the memory access.
+ * @param[in] val Value read or written.
+ * @param[in] user_data A ARION_HOOK_PARAM structure which holds data and filters related to the associated Arion hook.
+ * @return True if the hook handled the access and default behavior should be suppressed.
+ */
+bool arion_filtered_mem_hook(uc_engine *uc, uc_mem_type access, uint64_t addr, int size, int64_t val,
+                             void *user_data);
+/**
+ * Unicorn hook that gets triggered on a memory access and records it in the buffer of a batched memory trace hook.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] access Type of memory access (e.g., UC_MEM_READ, UC_MEM_WRITE, UC_MEM_FETCH).
+ * @param[in] addr Memory address being accessed.
+ * @param[in] size Size of the memory access.
+ * @param[in] val Value read or written.
+ * @param[in] user_data A ARION_MEM_TRACE structure which holds the buffer of the associated Arion hook.
+ * @return Always false, the access is only recorded.
+ */
+bool arion_mem_trace_hook(uc_engine *uc, uc_mem_type access, uint64_t addr, int size, int64_t val, void *user_data);
+/**
+ * Unicorn hook that gets triggered at the start of a new basic block and delivers the memory accesses recorded by a
+ * batched memory trace hook.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] address Memory address of the block being executed.
+ * @param[in] size Size of the block in bytes.
+ * @param[in] user_data A ARION_MEM_TRACE structure which holds the buffer of the associated Arion hook.
+ */
+void arion_mem_trace_block_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data);
+/**
+ * Unicorn hook that gets triggered when code execution reaches a specified address or range, or at the start of a new
+ * basic block, and forwards it to a low-overhead Arion hook.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] address Memory address of the instruction or block being executed.
+ * @param[in] size Size of the executed instruction or block in bytes.
+ * @param[in] user_data A ARION_FAST_HOOK_PARAM structure which holds data related to the associated Arion hook.
+ */
+void arion_fast_code_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data);
+/**
+ * Unicorn hook that gets triggered on a memory access and forwards it to a low-overhead Arion hook.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] access Type of memory access (e.g., UC_MEM_READ, UC_MEM_WRITE, UC_MEM_FETCH).
+ * @param[in] addr Memory address being accessed.
+ * @param[in] size Size of the memory access.
+ * @param[in] val Value read or written.
+ * @param[in] user_data A ARION_FAST_HOOK_PARAM structure which holds data related to the associated Arion hook.
+ * @return True if the hook handled the access and default behavior should be suppressed.
+ */
+bool arion_fast_mem_hook(uc_engine *uc, uc_mem_type access, uint64_t addr, int size, int64_t val, void *user_data);
+/**
+ * Unicorn hook that gets triggered when a new control-flow edge is generated and forwards it to a low-overhead Arion
+ * hook.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] cur Current translation block.
+ * @param[in] prev Previous translation block.
+ * @param[in] user_data A ARION_FAST_HOOK_PARAM structure which holds data related to the associated Arion hook.
+ */
+void arion_fast_edge_generated_hook(uc_engine *uc, uc_tb *cur, uc_tb *prev, void *user_data);
+/**
+ * Unicorn hook that gets triggered for each TCG opcode and forwards it to a low-overhead Arion hook.
+ * @param[in] uc The unicorn engine that triggered the hook.
+ * @param[in] addr Guest address of the instruction or opcode.
+ * @param[in] arg1 First argument associated with the opcode.
+ * @param[in] arg2 Second argument associated with the opcode.
+ * @param[in] size Size of the operation or data in bytes.
+ * @param[in] user_data A ARION_FAST_HOOK_PARAM structure which holds data related to the associated Arion hook.
+ */
+void arion_fast_tcg_opcode_hook(uc_engine *uc, uint64_t addr, uint64_t arg1, uint64_t arg2, int size, void *user_data);
 
 /// This class purpose is to manage user-defined Arion hooks including hook creation, deletion, trigger handling...
 class ARION_EXPORT HooksManager
@@ -372,17 +763,41 @@ class ARION_EXPORT HooksManager
     std::weak_ptr<Arion> arion;
     /// The Unicorn engine associated with this instance.
     uc_engine *uc;
+    /// The Arion instance associated with this instance, referenced by low-overhead hooks.
+    Arion *arion_ref;
     /// ID of the next hook to be created.
     HOOK_ID curr_id = 1;
     /// A map identifying an Arion hook given its ID.
     std::map<HOOK_ID, std::shared_ptr<ARION_HOOK>> hooks;
     /// A stack of hook IDs that got deleted and that can be reused.
     std::stack<HOOK_ID> free_hook_ids;
+    /// Whether hooks got deleted by themselves, in which case IDs are never restarted from 1.
+    bool retired_hook_ids = false;
+    /// A map identifying the address hooks registered at a given address, in creation order.
+    std::unordered_map<ADDR, std::vector<std::shared_ptr<ARION_HOOK>>> addr_hooks;
+    /// A map identifying an address hooks group given its aligned base address.
+    std::unordered_map<ADDR, ARION_ADDR_HOOK_GROUP> addr_hook_groups;
+    /// A map identifying the hooks which are not related to the Unicorn engine given their type, in creation order.
+    std::map<ARION_HOOK_TYPE, std::vector<std::shared_ptr<ARION_HOOK>>> arion_hooks;
+    /// A map identifying the SYSCALL_HOOK hooks filtered on a system call number given this number.
+    std::unordered_map<uint64_t, std::vector<std::shared_ptr<ARION_HOOK>>> sysno_hooks;
+    /// Batched memory trace hooks, whose buffers are delivered when the emulation stops.
+    std::vector<std::shared_ptr<ARION_HOOK>> mem_trace_hooks;
+    /// Number of hooks lists being triggered, which defers the removal of hooks from these lists.
+    uint32_t triggers_depth = 0;
+    /// Hooks which were removed while hooks were being triggered, waiting to be swept.
+    std::vector<std::shared_ptr<ARION_HOOK>> deleted_hooks;
     /**
      * Generates a new hook ID.
      * @return The new ID.
      */
     HOOK_ID gen_next_id();
+    /**
+     * Deletes an Arion hook, preventing it from being triggered.
+     * @param[in] hook_id ID of the hook which must get deleted.
+     * @param[in] reuse_id Whether the ID can be given to a new hook.
+     */
+    void remove_hook(HOOK_ID hook_id, bool reuse_id);
     /**
      * Creates a new hook related to the Unicorn engine, which means every hooks that are defined in Unicorn.
      * @tparam UcParams Additional parameters for genericity purpose.
@@ -405,6 +820,111 @@ class ARION_EXPORT HooksManager
      * @return The new hook ID.
      */
     HOOK_ID hook_arion(ARION_HOOK_TYPE type, HOOK_CALLBACK callback, void *user_data);
+    /**
+     * Creates a new memory hook related to the Unicorn engine, whose filters are evaluated before calling its callback.
+     * @param[in] type Arion type for the hook.
+     * @param[in] callback Arion callback which gets called when an access passes the filters.
+     * @param[in] filter Filters evaluated before calling the callback.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @param[in] start Start memory address where the hook should trigger.
+     * @param[in] end End memory address where the hook should trigger.
+     * @return The new hook ID.
+     */
+    HOOK_ID hook_uc_filtered(ARION_HOOK_TYPE type, MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter,
+                             void *user_data, ADDR start, ADDR end);
+    /**
+     * Removes a hook which is not related to the Unicorn engine, or an address hook, from the lists it is triggered
+     * from.
+     * @param[in] arion_hook The hook to be removed.
+     */
+    void remove_arion_hook(std::shared_ptr<ARION_HOOK> arion_hook);
+    /**
+     * Removes the hooks which were removed while hooks were being triggered, once no trigger is in progress.
+     */
+    void sweep_deleted_hooks();
+    /**
+     * Triggers a list of hooks which are not related to the Unicorn engine. Hooks added by the callbacks are only
+     * triggered next time, and hooks removed by the callbacks are skipped and swept once the triggers are done.
+     * @tparam HookParams Additional parameters for genericity purpose.
+     * @param[in] hooks_list The hooks to be triggered.
+     * @param[in] params Additional parameters for the hooks.
+     */
+    template <typename... HookParams>
+    void trigger_hooks_list(std::vector<std::shared_ptr<ARION_HOOK>> &hooks_list, HookParams &&...params)
+    {
+        size_t hooks_sz = hooks_list.size();
+        if (!hooks_sz)
+            return;
+        this->triggers_depth++;
+        try
+        {
+            // The list may grow while being iterated, so hooks are accessed by index
+            for (size_t hook_i = 0; hook_i < hooks_sz; hook_i++)
+            {
+                ARION_HOOK *hook = hooks_list[hook_i].get();
+                if (hook->to_delete)
+                    continue;
+                ARION_HOOK_PARAM *param = hook->param;
+                ARION_PROFILE_HOOK(param->counters);
+                std::shared_ptr<Arion> arion = param->arion.lock();
+                if (!arion)
+                    throw arion_exception::ExpiredWeakPtrException("Arion");
+
+                std::visit(
+                    [&](auto &&cb) {
+                        using CallbackType = std::decay_t<decltype(cb)>;
+                        if constexpr (std::is_invocable_v<CallbackType, std::shared_ptr<Arion>, HookParams..., void *>)
+                            cb(arion, params..., param->user_data);
+                        else
+                            throw arion_exception::WrongHookParamsException();
+                    },
+                    param->callback);
+            }
+        }
+        catch (...)
+        {
+            this->triggers_depth--;
+            this->sweep_deleted_hooks();
+            throw;
+        }
+        this->triggers_depth--;
+        this->sweep_deleted_hooks();
+    }
+    /**
+     * Creates a new low-overhead hook related to the Unicorn engine.
+     * @tparam UcParams Additional parameters for genericity purpose.
+     * @param[in] type Arion type for the hook.
+     * @param[in] callback Arion callback which gets called when the Unicorn hook is triggered, as a function pointer.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @param[in] start Start memory address where the hook should trigger.
+     * @param[in] end End memory address where the hook should trigger.
+     * @param[in] uc_params Additional parameters for the hook.
+     * @return The new hook ID.
+     */
+    template <typename... UcParams>
+    HOOK_ID hook_uc_fast(ARION_HOOK_TYPE type, void *callback, void *user_data, ADDR start = 0,
+                         ADDR end = ARION_MAX_U64, UcParams... uc_params);
+    /**
+     * (Re)binds the Unicorn hook of an address hooks group to a new range. The previous Unicorn hook is only removed
+     * once the new one is installed.
+     * @param[in] group The address hooks group.
+     * @param[in] start Lowest hooked address of the group.
+     * @param[in] end Highest hooked address of the group.
+     */
+    void bind_addr_hook_group(ARION_ADDR_HOOK_GROUP &group, ADDR start, ADDR end);
+    /**
+     * Registers an address hook in the dispatch table and in its address hooks group.
+     * @param[in] addr Exact memory address where the hook should trigger.
+     * @param[in] arion_hook The address hook.
+     */
+    void add_addr_hook(ADDR addr, std::shared_ptr<ARION_HOOK> arion_hook);
+    /**
+     * Unregisters an address hook from the dispatch table and from its address hooks group. The group Unicorn hook is
+     * removed along with the last address hook of the group.
+     * @param[in] addr Exact memory address where the hook triggers.
+     * @param[in] arion_hook The address hook.
+     */
+    void remove_addr_hook(ADDR addr, std::shared_ptr<ARION_HOOK> arion_hook);
 
   public:
     /**
@@ -454,7 +974,9 @@ class ARION_EXPORT HooksManager
     HOOK_ID ARION_EXPORT hook_code(ADDR_SZ_HOOK_CALLBACK callback, ADDR start = 0, ADDR end = ARION_MAX_U64,
                                    void *user_data = nullptr);
     /**
-     * Creates a new hook that gets triggered when execution reaches a specific address.
+     * Creates a new hook that gets triggered when execution reaches a specific address. Address hooks are multiplexed
+     * over a single Unicorn hook per ARION_ADDR_HOOK_GROUP_SZ memory area, so that registering thousands of them does
+     * not slow down code which is not covered by any group.
      * @param[in] callback Callback being called when this hook gets triggered.
      * @param[in] addr Exact memory address where the hook should trigger.
      * @param[in] user_data Optional user-defined data passed to the hook.
@@ -635,11 +1157,197 @@ class ARION_EXPORT HooksManager
      * @return The new hook ID.
      */
     HOOK_ID ARION_EXPORT hook_syscall(SYSCALL_HOOK_CALLBACK callback, void *user_data = nullptr);
+    /**
+     * Creates a new hook that gets triggered when a specific system call is invoked. Other system calls do not pay for
+     * this hook.
+     * @param[in] callback Callback being called when this hook gets triggered.
+     * @param[in] sysno System call number on which the hook should trigger.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_sysno(SYSCALL_HOOK_CALLBACK callback, uint64_t sysno, void *user_data = nullptr);
+    /**
+     * Calls the address hooks registered at the address being executed, if any.
+     * @param[in] addr Memory address of the instruction being executed.
+     * @param[in] sz Size of the executed instruction in bytes.
+     */
+    void dispatch_addr_hooks(ADDR addr, size_t sz);
+    /**
+     * Creates a new hook that gets triggered on valid memory read accesses passing some filters. Filters are evaluated
+     * before the Arion instance is retrieved, so that discarded accesses stay cheap. The value is not known yet when a
+     * read gets triggered, so value filters are only supported by hook_mem_read_after_filtered.
+     * @param[in] callback Callback being called when this hook gets triggered.
+     * @param[in] filter Filters evaluated before calling the callback. val_min and val_max must keep their defaults.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     * @throws arion_exception::WrongHookParamsException If the filter compares the accessed value.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_read_filtered(MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter,
+                                                ADDR start = 0, ADDR end = ARION_MAX_U64, void *user_data = nullptr);
+    /**
+     * Creates a new hook that gets triggered on valid memory write accesses passing some filters. Filters are
+     * evaluated before the Arion instance is retrieved, so that discarded accesses stay cheap.
+     * @param[in] callback Callback being called when this hook gets triggered.
+     * @param[in] filter Filters evaluated before calling the callback.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_write_filtered(MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter,
+                                                 ADDR start = 0, ADDR end = ARION_MAX_U64, void *user_data = nullptr);
+    /**
+     * Creates a new hook that gets triggered after memory read operations passing some filters complete. Filters are
+     * evaluated before the Arion instance is retrieved, so that discarded accesses stay cheap.
+     * @param[in] callback Callback being called when this hook gets triggered.
+     * @param[in] filter Filters evaluated before calling the callback.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_read_after_filtered(MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter,
+                                                      ADDR start = 0, ADDR end = ARION_MAX_U64,
+                                                      void *user_data = nullptr);
+    /**
+     * Creates a new batched memory trace hook. Memory accesses are recorded in a preallocated buffer from the Unicorn
+     * callback, and handed to the Arion callback when the buffer is full, when the emulation stops and optionally at
+     * every basic block.
+     * @param[in] callback Callback being called with every batch of memory accesses.
+     * @param[in] types Unicorn memory hook types to be recorded (e.g., UC_HOOK_MEM_READ | UC_HOOK_MEM_WRITE).
+     * @param[in] capacity Number of memory accesses a batch can hold.
+     * @param[in] flush_on_block Whether recorded accesses should also be delivered at the start of every basic block.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_trace(MEM_TRACE_HOOK_CALLBACK callback,
+                                        int types = UC_HOOK_MEM_READ | UC_HOOK_MEM_WRITE,
+                                        size_t capacity = ARION_MEM_TRACE_SZ, bool flush_on_block = false,
+                                        ADDR start = 0, ADDR end = ARION_MAX_U64, void *user_data = nullptr);
+    /**
+     * Delivers the memory accesses recorded by all batched memory trace hooks. This is called when the emulation
+     * stops.
+     */
+    void flush_mem_traces();
+    /**
+     * Creates a new low-overhead hook that gets triggered when code execution reaches a specified address or range.
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] start Start memory address where the hook should trigger.
+     * @param[in] end End memory address where the hook should trigger.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_code_fast(FAST_ADDR_SZ_HOOK_CALLBACK callback, ADDR start = 0, ADDR end = ARION_MAX_U64,
+                                        void *user_data = nullptr);
+    /**
+     * Creates a new low-overhead hook that gets triggered at the start of a new basic block or translation block (TB).
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] start Start memory address where the hook should trigger.
+     * @param[in] end End memory address where the hook should trigger.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_block_fast(FAST_ADDR_SZ_HOOK_CALLBACK callback, ADDR start = 0, ADDR end = ARION_MAX_U64,
+                                         void *user_data = nullptr);
+    /**
+     * Creates a new low-overhead hook that gets triggered on every valid memory read access.
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_read_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start = 0, ADDR end = ARION_MAX_U64,
+                                            void *user_data = nullptr);
+    /**
+     * Creates a new low-overhead hook that gets triggered on every valid memory write access.
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_write_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start = 0, ADDR end = ARION_MAX_U64,
+                                             void *user_data = nullptr);
+    /**
+     * Creates a new low-overhead hook that gets triggered when fetching instructions from valid mapped memory.
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_fetch_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start = 0, ADDR end = ARION_MAX_U64,
+                                             void *user_data = nullptr);
+    /**
+     * Creates a new low-overhead hook that gets triggered after a memory read operation completes.
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_mem_read_after_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start = 0,
+                                                  ADDR end = ARION_MAX_U64, void *user_data = nullptr);
+    /**
+     * Creates a new low-overhead hook that gets triggered when a new control-flow edge (translation block to
+     * translation block) is generated.
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] start Start memory address range monitored by this hook.
+     * @param[in] end End memory address range monitored by this hook.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_edge_generated_fast(FAST_EDGE_HOOK_CALLBACK callback, ADDR start = 0,
+                                                  ADDR end = ARION_MAX_U64, void *user_data = nullptr);
+    /**
+     * Creates a new low-overhead hook that gets triggered for each TCG opcode during translation or emulation.
+     * @param[in] callback Function being called when this hook gets triggered.
+     * @param[in] aux1 Auxiliary value (architecture-specific argument 1).
+     * @param[in] aux2 Auxiliary value (architecture-specific argument 2).
+     * @param[in] start Start memory address where the hook should trigger.
+     * @param[in] end End memory address where the hook should trigger.
+     * @param[in] user_data Optional user-defined data passed to the hook.
+     * @return The new hook ID.
+     */
+    HOOK_ID ARION_EXPORT hook_tcg_opcode_fast(FAST_TCG_HOOK_CALLBACK callback, uint64_t aux1, uint64_t aux2,
+                                              ADDR start = 0, ADDR end = ARION_MAX_U64, void *user_data = nullptr);
+    /**
+     * Sets the label identifying the owner of a hook in profiling statistics.
+     * @param[in] hook_id ID of the hook.
+     * @param[in] label The new label.
+     */
+    void ARION_EXPORT set_hook_label(HOOK_ID hook_id, std::string label);
+    /**
+     * Tells whether hooks profiling was compiled in, using the ARION_HOOK_PROFILING option.
+     * @return True if profiling counters get updated.
+     */
+    static bool ARION_EXPORT is_profiling_enabled();
+    /**
+     * Retrieves a snapshot of the profiling counters of every active hook, including the hooks registered internally
+     * by Arion components. Counters stay at 0 unless Arion is built with ARION_HOOK_PROFILING.
+     * @return A map identifying the hook statistics given the hook ID.
+     */
+    std::map<HOOK_ID, ARION_HOOK_STATS> ARION_EXPORT get_stats();
+    /**
+     * Resets the profiling counters of every active hook.
+     */
+    void ARION_EXPORT reset_stats();
     /**
      * Deletes an Arion hook, preventing it from being triggered.
      * @param[in] hook_id ID of the hook which must get deleted.
      */
     void ARION_EXPORT unhook(HOOK_ID hook_id);
+    /**
+     * Deletes an Arion hook from within its own callback. Its ID is never reused, so that a later call to unhook with
+     * this ID cannot delete another hook.
+     * @param[in] hook_id ID of the hook which must get deleted.
+     */
+    void ARION_EXPORT retire_hook(HOOK_ID hook_id);
     /**
      * Deletes all Arion hooks, preventing them from being triggered.
      */
@@ -651,30 +1359,20 @@ class ARION_EXPORT HooksManager
      * @param[in] type Arion type for the hooks to be triggered.
      * @param[in] params Additional parameters for the hooks.
      */
-    template <typename... HookParams> void trigger_arion_hook(ARION_HOOK_TYPE type, HookParams... params)
+    template <typename... HookParams> void trigger_arion_hook(ARION_HOOK_TYPE type, HookParams &&...params)
     {
-        for (auto &hook : this->hooks)
-        {
-            if (hook.second->type == type)
-            {
-                HOOK_CALLBACK &callback = hook.second->param->callback;
-                std::shared_ptr<Arion> arion = hook.second->param->arion.lock();
-                if (!arion)
-                    throw arion_exception::ExpiredWeakPtrException("Arion");
-                void *user_data = hook.second->param->user_data;
-
-                std::visit(
-                    [&](auto &&cb) {
-                        using CallbackType = std::decay_t<decltype(cb)>;
-                        if constexpr (std::is_invocable_v<CallbackType, std::shared_ptr<Arion>, HookParams..., void *>)
-                            cb(arion, params..., user_data);
-                        else
-                            throw arion_exception::WrongHookParamsException();
-                    },
-                    callback);
-            }
-        }
+        auto hooks_it = this->arion_hooks.find(type);
+        if (hooks_it != this->arion_hooks.end())
+            this->trigger_hooks_list(hooks_it->second, params...);
     }
+    /**
+     * Triggers the SYSCALL_HOOK hooks matching a system call, starting with those that trigger on any system call.
+     * @param[in] sysno System call number.
+     * @param[in] params Vector of system call parameters.
+     * @param[out] handled Output flag; set to true if a hook fully handled the syscall and default handling should be
+     * skipped.
+     */
+    void trigger_syscall_hook(uint64_t sysno, std::vector<SYS_PARAM> &params, bool *handled);
 };
 
 }; // namespace arion
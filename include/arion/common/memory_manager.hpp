@@ -6,15 +6,50 @@
 #include <arion/common/hooks_manager.hpp>
 #include <arion/unicorn/unicorn.h>
 #include <cstdint>
+#include <map>
 #include <memory>
+#include <set>
 #include <string>
+#include <type_traits>
+#include <unistd.h>
 #include <vector>
 
+/// Number of host page map entries read at once when sharing mappings copy-on-write.
+#define ARION_PAGEMAP_BATCH_SZ 0x200
+/// Host page map flag set for pages present in RAM.
+#define ARION_PAGEMAP_PRESENT (1ULL << 63)
+/// Host page map flag set for swapped pages.
+#define ARION_PAGEMAP_SWAPPED (1ULL << 62)
+/// Host page map flag set for file pages (or shared anonymous ones).
+#define ARION_PAGEMAP_FILE (1ULL << 61)
+
 namespace arion
 {
 
 class Arion;
 
+/// This structure holds a host file descriptor whose content backs the host memory of mappings. The descriptor is
+/// closed when the last mapping using it is destroyed.
+struct ARION_EXPORT ARION_HOST_FILE
+{
+    /// Host file descriptor.
+    int fd;
+
+    /**
+     * Builder for ARION_HOST_FILE instances.
+     * @param[in] fd Host file descriptor, owned by the new instance.
+     */
+    ARION_HOST_FILE(int fd) : fd(fd) {};
+    /**
+     * Destructor for ARION_HOST_FILE instances.
+     */
+    ~ARION_HOST_FILE()
+    {
+        if (fd >= 0)
+            close(fd);
+    }
+};
+
 /// This structure holds data associated with a memory mapping.
 struct ARION_EXPORT ARION_MAPPING
 {
@@ -28,6 +63,17 @@ struct ARION_EXPORT ARION_MAPPING
     std::string info;
     /// This buffer is used to store the mapping data for serialization operations.
     BYTE *saved_data = nullptr;
+    /// Host buffer backing the mapping when it was registered with uc_mem_map_ptr, nullptr otherwise. It is owned by
+    /// the MemoryManager and is not copied when cloning the mapping.
+    BYTE *host_ptr = nullptr;
+    /// Host file privately mapped in host_ptr, providing the content of the pages that were not written yet, if any. In
+    /// saved contexts, holds the memory shared copy-on-write with the context instead of saved_data.
+    std::shared_ptr<ARION_HOST_FILE> host_file;
+    /// Offset of the mapping start in host_file.
+    off_t host_off = 0;
+    /// Bitmap of the pages written while dirty pages were tracked (see MemoryRecorder), one bit per page from
+    /// start_addr. Empty when no page was written.
+    std::vector<uint64_t> dirty_pages;
     /**
      * Builder for ARION_MAPPING instances.
      */
@@ -87,34 +133,16 @@ struct ARION_MEM_EDIT
     ARION_MEM_EDIT(ADDR addr, size_t sz) : addr(addr), sz(sz) {};
 };
 
-/// This class is responsible for recording memory accesses to an Arion instance.
+/// This class is responsible for recording memory accesses to an Arion instance. Written pages are tracked at page
+/// granularity by the MemoryManager: while recording, writable pages are write-protected in Unicorn engine until their
+/// first write, so that next writes to the same page have no overhead.
 class MemoryRecorder
 {
   private:
     /// The Arion instance being recorded.
     std::weak_ptr<Arion> arion;
-    /// Recorded memory accesses.
-    std::vector<std::shared_ptr<ARION_MEM_EDIT>> edits;
-    /// ID of the hook used to record memory writes.
-    HOOK_ID write_mem_hook_id;
     /// Indicates whether recording is currently active.
     bool started = false;
-    /**
-     * The function called when a memory write occurs to the associated Arion instance.
-     * @param[in] arion Arion instance that triggered the hook.
-     * @param[in] type Type of memory being access.
-     * @param[in] addr Memory address where the write occurred.
-     * @param[in] size Size of the write in bytes.
-     * @param[in] val Value written to memory.
-     * @param[in] user_data Optional user-defined data passed to the hook.
-     */
-    static bool write_mem_hook(std::shared_ptr<Arion> arion, uc_mem_type type, uint64_t addr, int size, int64_t val,
-                               void *user_data);
-    /**
-     * Records a new memory access.
-     * @param[in] edit The memory access to record.
-     */
-    void add_edit(std::shared_ptr<ARION_MEM_EDIT> edit);
 
   public:
     /**
@@ -129,7 +157,7 @@ class MemoryRecorder
      */
     static std::unique_ptr<MemoryRecorder> initialize(std::weak_ptr<Arion> arion);
     /**
-     * Clears all recorded memory accesses.
+     * Clears all recorded memory accesses. Cleared pages are write-protected again if recording is active.
      */
     void clear();
     /**
@@ -140,9 +168,15 @@ class MemoryRecorder
      * Stops recording memory accesses.
      */
     void stop();
+    /**
+     * Checks whether recording is currently active.
+     * @return True if recording is active.
+     */
+    bool is_started();
     /**
      * Retrieves all recorded memory accesses.
-     * @return A vector of ARION_MEM_EDIT instances representing the recorded memory accesses.
+     * @return A vector of ARION_MEM_EDIT instances representing the recorded memory accesses, as ranges of contiguous
+     * written pages.
      */
     std::vector<std::shared_ptr<ARION_MEM_EDIT>> get_edits();
 };
@@ -158,14 +192,26 @@ class ARION_EXPORT MemoryManager
     size_t page_sz;
     /// The current break address (brk). This is used to determine where new memory should be allocated.
     ADDR brk = 0;
-    /// A vector of all mappings currently present within the Arion instance.
-    std::vector<std::shared_ptr<ARION_MAPPING>> mappings;
+    /// All mappings currently present within the Arion instance, indexed by their start address. Since mappings never
+    /// overlap, this also acts as an interval index.
+    std::map<ADDR, std::shared_ptr<ARION_MAPPING>> mappings;
+    /// Start addresses of the mappings associated with a given info string.
+    std::map<std::string, std::set<ADDR>> mappings_by_info;
+    /// Indicates whether written pages are currently tracked.
+    bool dirty_tracking = false;
     /**
      * Converts Arion memory protection rights to Unicorn ones.
      * @param[in] perms Arion memory protection rights.
      * @return Unicorn memory protection rights.
      */
     uint32_t to_uc_perms(PROT_FLAGS perms);
+    /**
+     * Checks whether a chunk of memory only contains zeros.
+     * @param[in] data Pointer to the chunk.
+     * @param[in] data_sz Size of the chunk in bytes.
+     * @return True if all bytes of the chunk are zeros.
+     */
+    bool is_zero_chunk(const BYTE *data, size_t data_sz);
     /**
      * Inserts a new mapping in Arion memory.
      * @param[in] mapping The ARION_MAPPING to insert.
@@ -176,6 +222,29 @@ class ARION_EXPORT MemoryManager
      * @param[in] mapping The ARION_MAPPING to remove.
      */
     void remove_mapping(std::shared_ptr<ARION_MAPPING> mapping);
+    /**
+     * Adds a mapping to the address and info indexes.
+     * @param[in] mapping The ARION_MAPPING to index.
+     */
+    void index_mapping(std::shared_ptr<ARION_MAPPING> mapping);
+    /**
+     * Removes a mapping from the address and info indexes. Must be called before editing the bounds of a mapping.
+     * @param[in] mapping The ARION_MAPPING to unindex.
+     */
+    void unindex_mapping(std::shared_ptr<ARION_MAPPING> mapping);
+    /**
+     * Finds the mapping containing a given address in O(log n).
+     * @param[in] addr The address to look up.
+     * @return An iterator to the mapping containing the address, or the end iterator if it is not mapped.
+     */
+    std::map<ADDR, std::shared_ptr<ARION_MAPPING>>::iterator find_mapping_it(ADDR addr);
+    /**
+     * Retrieves all mappings intersecting a memory range.
+     * @param[in] start_addr Start of the range.
+     * @param[in] end_addr End of the range.
+     * @return A vector of the intersecting mappings, sorted by address.
+     */
+    std::vector<std::shared_ptr<ARION_MAPPING>> get_mappings_in(ADDR start_addr, ADDR end_addr);
     /**
      * Merges contiguous memory mappings in a given range.
      * @param[in] start Start memory address of the mappings that should be merged.
@@ -186,6 +255,65 @@ class ARION_EXPORT MemoryManager
      * Merges all contiguous memory mappings (expensive operation).
      */
     void merge_contiguous_uc_mappings();
+    /**
+     * Moves the data of a mapping owned by Unicorn engine into a host buffer, so that it can later be split without
+     * Unicorn engine copying it. Does nothing if the mapping is already host-backed or host memory can't be used.
+     * @param[in] mapping The ARION_MAPPING to back with host memory.
+     */
+    void attach_host_mem(std::shared_ptr<ARION_MAPPING> mapping);
+    /**
+     * Converts Arion memory protection rights to the Unicorn ones applied to pages that were not written yet. While
+     * dirty pages are tracked, write access is withheld so that the first write to each page can be recorded.
+     * @param[in] perms Arion memory protection rights.
+     * @return Unicorn memory protection rights.
+     */
+    uint32_t to_tracked_uc_perms(PROT_FLAGS perms);
+    /**
+     * Extracts the dirty pages bitmap of a range from the one of a mapping.
+     * @param[in] mapping The ARION_MAPPING whose bitmap is sliced.
+     * @param[in] start_addr Start address of the range.
+     * @param[in] end_addr End address of the range.
+     * @return The dirty pages bitmap of the range.
+     */
+    std::vector<uint64_t> slice_dirty_pages(std::shared_ptr<ARION_MAPPING> mapping, ADDR start_addr, ADDR end_addr);
+    /**
+     * Checks whether the host page size allows backing Arion mappings with host memory.
+     * @return True if Arion pages are made of whole host pages.
+     */
+    bool host_mem_compatible();
+    /**
+     * Copies the data extents of a host file into another one, skipping its holes.
+     * @param[in] src_fd Source host file descriptor.
+     * @param[in] src_off Offset of the copied content in the source file.
+     * @param[in] dst_fd Destination host file descriptor. Content is copied at its start.
+     * @param[in] sz Size of the copied content in bytes.
+     */
+    void copy_host_file(int src_fd, off_t src_off, int dst_fd, size_t sz);
+    /**
+     * Checks whether new mappings should be backed by host memory, depending on the "host_backed_mem" configuration
+     * field and on the host page size.
+     * @return True if new mappings should be backed by host memory, false otherwise.
+     */
+    bool use_host_mem();
+    /**
+     * Allocates a zeroed host buffer used to back a mapping.
+     * @param[in] sz Size of the buffer in bytes.
+     * @return The allocated buffer.
+     */
+    BYTE *alloc_host_mem(size_t sz);
+    /**
+     * Releases a host buffer, or a part of it, that was used to back a mapping.
+     * @param[in] host_ptr Start of the memory to release.
+     * @param[in] sz Size of the memory to release in bytes.
+     */
+    void free_host_mem(BYTE *host_ptr, size_t sz);
+    /**
+     * Resizes a mapping backed by host memory. The backing buffer is grown or shrunk in place when possible.
+     * @param[in] mapping The mapping to resize.
+     * @param[in] start_addr New start address.
+     * @param[in] end_addr New end address.
+     */
+    void resize_host_mapping(std::shared_ptr<ARION_MAPPING> mapping, ADDR start_addr, ADDR end_addr);
 
   public:
     /// Used to record memory accesses to the associated Arion instance.
@@ -196,6 +324,10 @@ class ARION_EXPORT MemoryManager
      * @param[in] page_sz The size of a memory page in bytes. Used when allocating new pages.
      */
     MemoryManager(std::weak_ptr<Arion> arion, size_t page_sz) : arion(arion), page_sz(page_sz) {};
+    /**
+     * Destructor for MemoryManager instances. Releases host memory backing the mappings.
+     */
+    ~MemoryManager();
     /**
      * Instanciates and initializes new MemoryManager objects with some parameters.
      * @param[in] arion The Arion instance associated with this instance.
@@ -250,6 +382,18 @@ class ARION_EXPORT MemoryManager
      * @return A vector of shared pointers to ARION_MAPPING structures.
      */
     std::vector<std::shared_ptr<ARION_MAPPING>> ARION_EXPORT get_mappings();
+    /**
+     * Replaces all tracked memory mappings with the layout of a list of mappings, without mapping or unmapping anything
+     * in Unicorn engine. This is meant to be called once Unicorn engine memory was restored on its own (e.g. from a
+     * snapshot), the host buffers of the replaced mappings are freed.
+     * @param[in] mapping_list The mappings to track, none of them being backed by host memory.
+     */
+    void ARION_EXPORT reset_mappings(std::vector<std::unique_ptr<ARION_MAPPING>> &mapping_list);
+    /**
+     * Moves the data of a host-backed mapping into memory owned by Unicorn engine, and frees its host buffer.
+     * @param[in] mapping The ARION_MAPPING to detach from host memory.
+     */
+    void ARION_EXPORT detach_host_mem(std::shared_ptr<ARION_MAPPING> mapping);
     /**
      * Returns a string representation of all mappings.
      * @return A formatted string describing each memory mapping.
@@ -264,6 +408,35 @@ class ARION_EXPORT MemoryManager
      * @return The starting address of the mapped region.
      */
     ADDR ARION_EXPORT map(ADDR start_addr, size_t sz, PROT_FLAGS perms, std::string info = "");
+    /**
+     * Maps a file at a specific address. When possible, the mapping is backed by a private host mapping of the file, so
+     * that its pages are loaded lazily, shared in the host page cache and only copied on their first write. Otherwise,
+     * the file content is copied in a new mapping.
+     * @param[in] start_addr The starting address for the mapping.
+     * @param[in] sz Size of the region to map.
+     * @param[in] perms Memory protection flags.
+     * @param[in] fd Host file descriptor of the file to map.
+     * @param[in] off Offset of the mapped content in the file.
+     * @param[in] info Optional string identifying the mapping.
+     * @return The starting address of the mapped region.
+     */
+    ADDR ARION_EXPORT map_file(ADDR start_addr, size_t sz, PROT_FLAGS perms, int fd, off_t off, std::string info = "");
+    /**
+     * Finds a free memory region near a specific address, without mapping it.
+     * @param[in] addr Preferred starting address.
+     * @param[in] sz Size of the region.
+     * @param[in] asc If true, search upwards in memory; otherwise downwards.
+     * @return The starting address of the free region.
+     */
+    ADDR ARION_EXPORT find_free_addr(ADDR addr, size_t sz, bool asc = true);
+    /**
+     * Shares the host memory of a mapping copy-on-write. Its current content is frozen in a host memory file, which the
+     * mapping then maps privately, as other Arion instances can with map_file. A page is only duplicated on its first
+     * write by either side, and freezing only copies pages that were populated.
+     * @param[in] mapping The host-backed ARION_MAPPING to share.
+     * @return The host memory file holding the frozen content of the mapping.
+     */
+    std::shared_ptr<ARION_HOST_FILE> ARION_EXPORT share_mapping(std::shared_ptr<ARION_MAPPING> mapping);
     /**
      * Maps a memory region near a specific address, automatically finding a suitable place.
      * @param[in] addr Preferred starting address.
@@ -358,6 +531,44 @@ class ARION_EXPORT MemoryManager
      * @return Vector containing the read bytes.
      */
     std::vector<BYTE> ARION_EXPORT read(ADDR addr, size_t data_sz);
+    /**
+     * Reads raw bytes from memory into a caller-provided buffer, without any heap allocation.
+     * @param[in] addr Starting address.
+     * @param[out] buf Buffer receiving the read bytes, at least `data_sz` bytes long.
+     * @param[in] data_sz Number of bytes to read.
+     */
+    void ARION_EXPORT read_into(ADDR addr, void *buf, size_t data_sz);
+    /**
+     * Reads raw bytes from memory into a zero-initialized buffer, page by page, skipping pages that only contain zeros.
+     * Pages that were never touched by the emulated program are thus never committed in the destination buffer.
+     * @param[in] addr Starting address.
+     * @param[out] buf Zero-initialized buffer receiving the read bytes, at least `data_sz` bytes long.
+     * @param[in] data_sz Number of bytes to read.
+     */
+    void ARION_EXPORT read_sparse(ADDR addr, BYTE *buf, size_t data_sz);
+    /**
+     * Reads a trivially copyable value from memory, without any heap allocation.
+     * @tparam T Type of the value to read.
+     * @param[in] addr Address to read from.
+     * @return The read value.
+     */
+    template <typename T> T read(ADDR addr)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "MemoryManager::read<T> requires a trivially copyable T");
+        T val;
+        this->read_into(addr, &val, sizeof(T));
+        return val;
+    }
+    /**
+     * Retrieves a direct pointer to the host memory backing a range of Arion memory, without copying it. Accesses
+     * through this pointer bypass Unicorn engine, so it should not be used to patch code that may already be
+     * translated. Writes through this pointer must be reported with mark_written.
+     * @param[in] addr Starting address.
+     * @param[in] data_sz Size of the range in bytes.
+     * @return A pointer to the host memory of the range, or nullptr if the range is not entirely backed by a contiguous
+     * host buffer (see the "host_backed_mem" configuration field).
+     */
+    BYTE ARION_EXPORT *view(ADDR addr, size_t data_sz);
     /**
      * Reads an integer value of a given size from memory.
      * @param[in] addr Address to read from.
@@ -424,6 +635,66 @@ class ARION_EXPORT MemoryManager
      * @param[in] data_sz Size of the data.
      */
     void ARION_EXPORT write(ADDR addr, BYTE *data, size_t data_sz);
+    /**
+     * Writes raw bytes to memory, page by page, skipping pages that only contain zeros. The destination is expected to
+     * be zero-initialized already (e.g. freshly mapped), so that its untouched pages remain lazily allocated.
+     * @param[in] addr Destination address.
+     * @param[in] data Pointer to the data.
+     * @param[in] data_sz Size of the data.
+     */
+    void ARION_EXPORT write_sparse(ADDR addr, BYTE *data, size_t data_sz);
+    /**
+     * Starts or stops tracking written pages. Tracking write-protects writable pages in Unicorn engine until their
+     * first write, which is then caught by handle_dirty_fault.
+     * @param[in] enabled True to start tracking, false to stop.
+     */
+    void ARION_EXPORT set_dirty_tracking(bool enabled);
+    /**
+     * Checks whether written pages are currently tracked.
+     * @return True if written pages are tracked.
+     */
+    bool ARION_EXPORT is_dirty_tracking();
+    /**
+     * Marks the pages of a memory range as written.
+     * @param[in] addr Start address of the range.
+     * @param[in] data_sz Size of the range in bytes.
+     */
+    void ARION_EXPORT mark_dirty(ADDR addr, size_t data_sz);
+    /**
+     * Reports a write made through a pointer retrieved with view. The pages of the range are marked as written and
+     * the code translated by Unicorn engine from its executable part is invalidated, as uc_mem_write would do.
+     * @param[in] addr Start address of the range.
+     * @param[in] data_sz Size of the range in bytes.
+     */
+    void ARION_EXPORT mark_written(ADDR addr, size_t data_sz);
+    /**
+     * Handles a write protection fault raised by Unicorn engine. If the fault was caused by dirty pages tracking, the
+     * pages are marked as written and write access is restored on them.
+     * @param[in] addr Address of the faulting write.
+     * @param[in] data_sz Size of the faulting write in bytes.
+     * @return True if the fault was caused by dirty pages tracking, false if it is a genuine protection fault.
+     */
+    bool ARION_EXPORT handle_dirty_fault(ADDR addr, size_t data_sz);
+    /**
+     * Clears all dirty pages bitmaps. While tracking, cleared pages are write-protected again.
+     */
+    void ARION_EXPORT clear_dirty();
+    /**
+     * Retrieves the ranges of contiguous written pages.
+     * @return A vector of ARION_MEM_EDIT instances, sorted by address.
+     */
+    std::vector<std::shared_ptr<ARION_MEM_EDIT>> ARION_EXPORT get_dirty_ranges();
+    /**
+     * Writes a trivially copyable value to memory, without any heap allocation.
+     * @tparam T Type of the value to write.
+     * @param[in] addr Destination address.
+     * @param[in] val The value to write.
+     */
+    template <typename T> void write(ADDR addr, const T &val)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "MemoryManager::write<T> requires a trivially copyable T");
+        this->write(addr, (BYTE *)&val, sizeof(T));
+    }
     /**
      * Writes a string to memory (without null-termination unless included).
      * @param[in] addr Destination address.
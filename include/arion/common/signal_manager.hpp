@@ -1,6 +1,7 @@
 #ifndef ARION_SIGNAL_MANAGER_HPP
 #define ARION_SIGNAL_MANAGER_HPP
 
+#include <arion/common/arch_manager.hpp>
 #include <arion/common/global_defs.hpp>
 #include <arion/platforms/linux/lnx_kernel_utils.hpp>
 #include <arion/unicorn/unicorn.h>
@@ -22,8 +23,10 @@ class SignalManager
     std::map<int, std::shared_ptr<struct arion_lnx_type::ksigaction>> sighandlers;
     /// A map identifying a process (ID) given the process (ID) it is waiting for.
     std::map<pid_t, pid_t> sigwait_list;
-    /// A map identifying a saved register value to be restored, given the Unicorn register it is associated to.
-    std::unique_ptr<std::map<REG, RVAL>> ucontext_regs;
+    /// Saved register values to be restored when the signal handler returns.
+    std::unique_ptr<RegisterFile> ucontext_regs;
+    /// Saved TLS address to be restored when the signal handler returns, as loading the segment selectors resets it.
+    ADDR ucontext_tls = 0;
     /// A map identifying a signal description string given its signal number.
     static std::map<int, std::string> signals;
     /**
@@ -1,8 +1,10 @@
 #ifndef ARION_THREADING_MANAGER_HPP
 #define ARION_THREADING_MANAGER_HPP
 
+#include <arion/common/arch_manager.hpp>
 #include <arion/common/global_defs.hpp>
 #include <arion/unicorn/unicorn.h>
+#include <deque>
 #include <map>
 #include <memory>
 #include <stack>
@@ -72,14 +74,25 @@ struct ARION_EXPORT ARION_THREAD
     /// The address in the parent process where the TID of the newly created thread is stored (used with
     /// CLONE_PARENT_SETTID).
     ADDR parent_tid_addr;
-    /// The saved register state of the thread, mapping each Unicorn register (REG) to its corresponding value (RVAL).
-    std::unique_ptr<std::map<REG, RVAL>> regs_state = nullptr;
+    /// The saved register state of the thread, as a register file. It is outdated while the thread is running, and
+    /// when uc_ctxt_saved is true.
+    std::unique_ptr<RegisterFile> regs_state = nullptr;
+    /// Preallocated Unicorn CPU context used to switch from and to this thread.
+    uc_context *uc_ctxt = nullptr;
+    /// True if the latest state of the thread is stored in uc_ctxt rather than in regs_state. It is cleared when the
+    /// thread is switched to.
+    bool uc_ctxt_saved = false;
     /// The address of the thread’s thread-local storage (TLS) block.
     ADDR tls_addr;
     /// The address where the thread’s wait status is stored, used for synchronization with other threads.
     ADDR wait_status_addr = 0;
-    /// Indicates whether the thread is currently stopped.
+    /// Indicates whether the thread is currently stopped. Use ThreadingManager::park_thread and
+    /// ThreadingManager::unpark_thread to edit it, so that the run queue stays up to date.
     bool stopped = false;
+    /// Indicates whether the thread has an entry in the run queue of its ThreadingManager.
+    bool queued = false;
+    /// Number of CPU cycles the thread runs before switching to another one, 0 until it first runs.
+    size_t quantum = 0;
     /// The head of the robust futex list, used for robust mutex handling by the Linux kernel.
     ADDR robust_list_head = 0;
     /// The address of the restartable sequences (rseq) structure for this thread.
@@ -102,12 +115,11 @@ struct ARION_EXPORT ARION_THREAD
      * CLONE_CHILD_SETTID).
      * @param[in] parent_tid_addr The address in the parent process where the TID of the newly created thread is stored
      * (used with CLONE_PARENT_SETTID).
-     * @param[in] regs_state The saved register state of the thread, mapping each Unicorn register (REG) to its
-     * corresponding value (RVAL).
+     * @param[in] regs_state The saved register state of the thread, as a register file.
      * @param[in] tls_addr The address of the thread’s thread-local storage (TLS) block.
      */
     ARION_THREAD(int exit_signal, uint64_t flags, ADDR child_cleartid_addr, ADDR child_settid_addr,
-                 ADDR parent_tid_addr, std::unique_ptr<std::map<REG, RVAL>> regs_state, ADDR tls_addr)
+                 ADDR parent_tid_addr, std::unique_ptr<RegisterFile> regs_state, ADDR tls_addr)
         : exit_signal(exit_signal), flags(flags), child_cleartid_addr(child_cleartid_addr),
           child_settid_addr(child_settid_addr), parent_tid_addr(parent_tid_addr), regs_state(std::move(regs_state)),
           tls_addr(tls_addr) {};
@@ -118,9 +130,28 @@ struct ARION_EXPORT ARION_THREAD
     ARION_THREAD(ARION_THREAD *arion_t)
         : tid(arion_t->tid), tgid(arion_t->tgid), exit_signal(arion_t->exit_signal), flags(arion_t->flags),
           child_cleartid_addr(arion_t->child_cleartid_addr), child_settid_addr(arion_t->child_settid_addr),
-          parent_tid_addr(arion_t->parent_tid_addr),
-          regs_state(arion_t->regs_state ? std::make_unique<std::map<REG, RVAL>>(*arion_t->regs_state) : nullptr),
-          tls_addr(arion_t->tls_addr), wait_status_addr(arion_t->wait_status_addr), stopped(arion_t->stopped) {};
+          parent_tid_addr(arion_t->parent_tid_addr), tls_addr(arion_t->tls_addr),
+          wait_status_addr(arion_t->wait_status_addr), stopped(arion_t->stopped)
+    {
+        if (!arion_t->regs_state)
+            return;
+        this->regs_state = std::make_unique<RegisterFile>(*arion_t->regs_state);
+        arion_t->read_uc_ctxt(*this->regs_state);
+    };
+    /**
+     * Destructor for ARION_THREAD instances.
+     */
+    ~ARION_THREAD();
+    /**
+     * Reads the registers of a register file from uc_ctxt when the latest state of the thread is stored in the Unicorn
+     * context. The thread itself is left untouched.
+     * @param[in,out] regs The register file to be updated.
+     */
+    void read_uc_ctxt(RegisterFile &regs) const;
+    /**
+     * Updates regs_state from uc_ctxt when the latest state of the thread is stored in the Unicorn context.
+     */
+    void sync_regs_state();
 };
 /*
  * Serializes an ARION_THREAD instance into a vector of bytes.
@@ -167,6 +198,16 @@ class ARION_EXPORT ThreadingManager
     pid_t running_tid = 1;
     /// Stack of reusable thread IDs from previously terminated threads.
     std::stack<pid_t> free_thread_ids;
+    /// Runnable threads waiting for their turn, in round-robin order. Entries of threads stopped after being queued are
+    /// skipped when dequeued.
+    std::deque<pid_t> run_queue;
+    /// True if the running thread handed off to other threads through a futex during its current time slice.
+    bool slice_handoff = false;
+    /**
+     * Appends a thread to the run queue if it is runnable and not queued yet.
+     * @param[in] arion_t The thread.
+     */
+    void enqueue_thread(ARION_THREAD *arion_t);
     /**
      * Generates the next available Thread ID.
      * @return The next unique Thread ID.
@@ -246,9 +287,36 @@ class ARION_EXPORT ThreadingManager
      */
     void switch_to_thread(pid_t tid);
     /**
-     * Switches execution context to the next available thread.
+     * Switches execution context to the next runnable thread in the run queue. The running thread stays scheduled if
+     * no other thread is runnable.
      */
     void switch_to_next_thread();
+    /**
+     * Rebuilds the run queue from the stopped state of all threads, after threads_map was edited directly.
+     */
+    void ARION_EXPORT rebuild_run_queue();
+    /**
+     * Marks a thread as stopped, so that it is not scheduled anymore.
+     * @param[in] tid The thread ID.
+     */
+    void ARION_EXPORT park_thread(pid_t tid);
+    /**
+     * Marks a thread as runnable and schedules it.
+     * @param[in] tid The thread ID.
+     */
+    void ARION_EXPORT unpark_thread(pid_t tid);
+    /**
+     * Retrieves the number of CPU cycles the running thread should run before switching to another one.
+     * @return The number of CPU cycles.
+     */
+    size_t ARION_EXPORT get_quantum();
+    /**
+     * Adapts the quantum of the running thread at the end of its time slice. It grows for threads that used their
+     * whole time slice and shrinks for threads that handed off to other threads through a futex.
+     * @param[in] slice_cut True if the emulation stopped before the quantum was consumed, for instance to synchronize
+     * threads after a system call.
+     */
+    void ARION_EXPORT end_time_slice(bool slice_cut);
     /**
      * Makes the specified thread wait on a futex.
      * @param[in] tid The thread ID that will wait.
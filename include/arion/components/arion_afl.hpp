@@ -36,10 +36,11 @@ using ARION_AFL_CRASH_CALLBACK = std::function<bool(std::shared_ptr<Arion> arion
 /// Memory restoring strategies for the fuzzed Arion instance.
 enum ARION_MEM_STRATEGY
 {
-    RECORD_EDITS,     ///< All memory changes are tracked, in order to restore only edited regions.
-    RESTORE_MAPPINGS, ///< Memory regions are restored, without caring about the data they contain.
-    RAW_RESTORE,      ///< Everything is restored.
-    MANUAL_MANAGEMENT ///< Nothing is restored.
+    RECORD_EDITS,      ///< All memory changes are tracked, in order to restore only edited regions.
+    RESTORE_MAPPINGS,  ///< Memory regions are restored, without caring about the data they contain.
+    RAW_RESTORE,       ///< Everything is restored.
+    MANUAL_MANAGEMENT, ///< Nothing is restored.
+    UC_SNAPSHOT        ///< Memory is restored from a Unicorn engine copy-on-write snapshot.
 };
 
 /// This structure is placed in the UnicornAFL user_data parameter.
@@ -0,0 +1,163 @@
+#ifndef ARION_CMP_LOG_HPP
+#define ARION_CMP_LOG_HPP
+
+#include <arion/arion.hpp>
+#include <arion/common/global_defs.hpp>
+#include <arion/common/hooks_manager.hpp>
+#include <memory>
+#include <vector>
+
+/// Number of comparison sites in a cmplog table, the same as AFL++.
+#define ARION_CMP_MAP_W 0x10000
+/// Number of operand pairs logged for each comparison site, the same as AFL++.
+#define ARION_CMP_MAP_H 32
+/// Type of a cmplog entry that logs instruction operands, the same as AFL++.
+#define ARION_CMP_TYPE_INS 0
+
+namespace arion
+{
+
+/// Header of a comparison site in a cmplog table, matching AFL++ struct cmp_header.
+struct __attribute__((packed)) ARION_CMP_HEADER
+{
+    /// Number of times the comparison was executed, wrapping.
+    unsigned hits : 6;
+    /// Size of the operands in bytes, minus one.
+    unsigned shape : 5;
+    /// Kind of entry, always ARION_CMP_TYPE_INS, so that zeroed headers are valid entries.
+    unsigned type : 1;
+    /// Comparison predicate, left to zero as it is unknown at TCG level.
+    unsigned attribute : 4;
+};
+
+/// Operands of an executed comparison in a cmplog table, matching AFL++ struct cmp_operands.
+struct __attribute__((packed)) ARION_CMP_OPERANDS
+{
+    /// First operand.
+    uint64_t v0;
+    /// High part of a 128-bit first operand.
+    uint64_t v0_128;
+    /// Unused 256-bit parts of the first operand.
+    uint64_t v0_256[2];
+    /// Second operand.
+    uint64_t v1;
+    /// High part of a 128-bit second operand.
+    uint64_t v1_128;
+    /// Unused 256-bit parts of the second operand.
+    uint64_t v1_256[2];
+    /// Unused.
+    uint8_t unused[8];
+};
+
+/// A cmplog table, matching the AFL++ struct cmp_map shared-memory layout.
+struct ARION_CMP_MAP
+{
+    /// Header of every comparison site.
+    ARION_CMP_HEADER headers[ARION_CMP_MAP_W];
+    /// Last operands of every comparison site, indexed by hits modulo ARION_CMP_MAP_H.
+    ARION_CMP_OPERANDS log[ARION_CMP_MAP_W][ARION_CMP_MAP_H];
+};
+
+/// A comparison logged by CmpLog, as exposed to in-process mutators.
+struct ARION_CMP_ENTRY
+{
+    /// Address of the comparison instruction.
+    ADDR pc;
+    /// First operand.
+    uint64_t op1;
+    /// Second operand.
+    uint64_t op2;
+    /// Size of the operands in bytes.
+    uint8_t size;
+};
+
+/// This class logs the operands of executed comparisons into an AFL++-compatible cmplog table, for input-to-state
+/// (RedQueen) mutations. Comparisons are caught at TCG level as subtractions which set the condition flags.
+class ARION_EXPORT CmpLog
+{
+  private:
+    /// The Arion instance whose comparisons are being logged.
+    std::weak_ptr<Arion> arion;
+    /// Table owned by this instance, used when no external table is provided.
+    std::unique_ptr<ARION_CMP_MAP> own_map;
+    /// The table being filled, which may be an external shared-memory area.
+    ARION_CMP_MAP *map = nullptr;
+    /// Address of the comparison instruction of every site, as the table only stores hashes.
+    std::vector<ADDR> sites_pc;
+    /// ID of the TCG opcode hook filling the table.
+    HOOK_ID hook_id = 0;
+    /// Whether comparisons are currently being logged.
+    bool started = false;
+    /**
+     * This hook is triggered at every executed comparison and logs its operands.
+     * @param[in] arion The Arion instance that executed the comparison.
+     * @param[in] addr The address of the comparison instruction.
+     * @param[in] arg1 The first operand.
+     * @param[in] arg2 The second operand.
+     * @param[in] size The width of the operation in bits.
+     * @param[in] user_data The CmpLog instance.
+     */
+    static void cmp_hook(Arion &arion, uint64_t addr, uint64_t arg1, uint64_t arg2, int size, void *user_data);
+
+  public:
+    /**
+     * Builder for CmpLog instances.
+     * @param[in] arion The Arion instance whose comparisons are logged.
+     */
+    ARION_EXPORT CmpLog(std::weak_ptr<Arion> arion) : arion(arion) {};
+    /**
+     * Destructor for CmpLog instances, stopping comparisons logging.
+     */
+    ARION_EXPORT ~CmpLog();
+    /**
+     * Computes the index of a comparison site in a cmplog table, the same way as AFL++ QEMU mode.
+     * @param[in] addr The comparison instruction address.
+     * @return The comparison site index.
+     */
+    static inline uint32_t get_site_index(ADDR addr)
+    {
+        return ((addr >> 4) ^ (addr << 8)) & (ARION_CMP_MAP_W - 1);
+    }
+    /**
+     * Starts logging comparisons. Code translated before this call is not instrumented, hence this should be called
+     * before the emulation starts.
+     * @param[in] map An external table to be filled (e.g : AFL++ cmplog shared memory), or nullptr to use an internal
+     * one.
+     * @param[in] start Start of the code range whose comparisons are logged.
+     * @param[in] end End of the code range whose comparisons are logged.
+     */
+    void ARION_EXPORT start(ARION_CMP_MAP *map = nullptr, ADDR start = 0, ADDR end = ARION_MAX_U64);
+    /**
+     * Stops logging comparisons. The table content is kept.
+     */
+    void ARION_EXPORT stop();
+    /**
+     * Tells whether comparisons are currently being logged.
+     * @return True if comparisons are being logged.
+     */
+    bool ARION_EXPORT is_started();
+    /**
+     * Clears the table headers, which is typically done before running a new input.
+     */
+    void ARION_EXPORT reset();
+    /**
+     * Retrieves the table being filled.
+     * @return The table, nullptr if logging was never started.
+     */
+    const ARION_CMP_MAP ARION_EXPORT *get_map();
+    /**
+     * Retrieves every comparison logged in the table, up to ARION_CMP_MAP_H per comparison site.
+     * @return The logged comparisons.
+     */
+    std::vector<ARION_CMP_ENTRY> ARION_EXPORT get_cmps();
+    /**
+     * Retrieves the comparisons logged for a given comparison instruction.
+     * @param[in] pc Address of the comparison instruction.
+     * @return The logged comparisons, which may belong to another instruction sharing the same site.
+     */
+    std::vector<ARION_CMP_ENTRY> ARION_EXPORT get_cmps(ADDR pc);
+};
+
+}; // namespace arion
+
+#endif // ARION_CMP_LOG_HPP
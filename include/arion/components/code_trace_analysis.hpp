@@ -3,7 +3,7 @@
 
 #include <arion/common/code_tracer.hpp>
 #include <arion/common/global_defs.hpp>
-#include <fstream>
+#include <arion/components/code_trace_index.hpp>
 #include <map>
 #include <string>
 
@@ -46,14 +46,29 @@ struct TRACE_MODULE
         : mod_id(mod->mod_id), name(mod->name), hash(mod->hash), start(mod->start), end(mod->end) {};
 };
 
-/// This class is used to read and parse an execution trace generated by an arion::CodeTracer instance.
+/// A lightweight view over a hit of a trace file. It is owned by the CodeTraceReader and only valid until the reader
+/// moves to another hit.
+struct ARION_EXPORT CODE_HIT_VIEW
+{
+    /// Offset of the hit relative to the start address of its module.
+    uint32_t off;
+    /// Size of the hit. It can either be the instruction size or the basic block size depending on the used TRACE_MODE.
+    uint16_t sz;
+    /// ID of the hit module.
+    uint16_t mod_id;
+    /// CPU context, in the order of the trace context registers. Only set when reading TRACE_MODE::CTXT files.
+    const RVAL *regs;
+};
+
+/// This class is used to read and parse an execution trace generated by an arion::CodeTracer instance. The trace file
+/// is memory-mapped and hits are exposed as views over the mapping, without any per-hit allocation.
 class CodeTraceReader
 {
   private:
     /// Path to the trace file.
     std::string trace_path;
-    /// Stream instance for the trace file.
-    std::ifstream trace_f;
+    /// Read-only mapping of the trace file.
+    const BYTE *trace_data = nullptr;
     /// Size in bytes of the trace file.
     size_t trace_f_sz;
     /// Version of the trace file.
@@ -64,6 +79,8 @@ class CodeTraceReader
     size_t total_hits;
     /// List of registers making up the context for TRACE_MODE::CTXT traces.
     std::vector<REG> ctxt_regs;
+    /// Natural size in bytes of each context register, stored since version 2.
+    std::vector<uint8_t> ctxt_regs_sz;
     /// Offset in bytes to the sections table of the trace file.
     off_t secs_table_off;
     /// Offset in bytes to the modules section of the trace file.
@@ -72,10 +89,44 @@ class CodeTraceReader
     off_t regs_sec_off;
     /// Offset in bytes to the data section of the trace file.
     off_t data_sec_off;
+    /// Offset in bytes to the chunks section of the trace file, since version 2.
+    off_t chunks_sec_off;
+    /// Size in bytes of a hit in the data section, before version 2.
+    size_t hit_sz;
+    /// Position in "ctxt_regs" of each register value of a hit, before version 2. These values are stored in ascending
+    /// register order rather than in the order of "ctxt_regs".
+    std::vector<size_t> fixed_regs_order;
     /// Current hit index.
     off_t hit_i;
     /// Map of modules in the trace file, given their id.
     std::map<uint16_t, std::unique_ptr<TRACE_MODULE>> modules;
+    /// Position of every chunk of encoded hits, since version 2.
+    std::vector<TRACER_CHUNK> chunks;
+    /// Index of the chunk being decoded.
+    size_t chunk_i;
+    /// Number of hits in the chunk being decoded.
+    uint32_t chunk_hits;
+    /// Encoded hits of the chunk being decoded, inside the trace file mapping.
+    const BYTE *chunk_data;
+    /// Size in bytes of the encoded hits of the chunk being decoded.
+    size_t chunk_data_sz;
+    /// Position of the next hit to be decoded in "chunk_data".
+    size_t chunk_pos;
+    /// The last read hit. Since version 2, the next encoded hit is relative to it.
+    CODE_HIT_VIEW last_hit;
+    /// Register values of the last read hit, in the order of "ctxt_regs".
+    std::vector<RVAL> last_regs;
+    /// True if searches may use a CodeTraceIndex.
+    bool use_index;
+    /// Index of the trace file, loaded or built on first use.
+    std::unique_ptr<CodeTraceIndex> index;
+    /**
+     * Copies bytes from the trace file mapping, after checking that they are in the file bounds.
+     * @param[in] off Offset of the bytes in the trace file.
+     * @param[out] out Buffer receiving the bytes.
+     * @param[in] sz Number of bytes to be copied.
+     */
+    void read_data(off_t off, void *out, size_t sz);
     /**
      * Reads and parses the header section of the trace file.
      */
@@ -92,17 +143,81 @@ class CodeTraceReader
      * Reads and parses the registers section of the trace file.
      */
     void read_regs_section();
+    /**
+     * Reads and parses the chunks section of the trace file.
+     */
+    void read_chunks_section();
     /**
      * Prepares the parser to read the data section containing all the hits.
      */
     void prepare_file();
+    /**
+     * Loads a chunk of encoded hits and resets the decoding state. Only used since version 2.
+     * @param[in] chunk_i Index of the chunk to be loaded.
+     */
+    void load_chunk(size_t chunk_i);
+    /**
+     * Checks that the loaded chunk holds enough bytes past the decoding position.
+     * @param[in] sz Number of bytes to be decoded.
+     */
+    void check_chunk_data(size_t sz);
+    /**
+     * Decodes a variable-length integer at the decoding position of the loaded chunk.
+     * @return The decoded value.
+     */
+    uint64_t read_chunk_varint();
+    /**
+     * Decodes the next hit of the loaded chunk into "last_hit". Only used since version 2.
+     */
+    void decode_hit();
+    /**
+     * Reads the hit at a given index into "last_hit", in constant time. Only used before version 2.
+     * @param[in] hit_i The hit index.
+     */
+    void read_fixed_hit(off_t hit_i);
 
   public:
     /**
      * Builder for CodeTraceReader instances.
      * @param[in] trace_path Path to the trace file.
+     * @param[in] use_index True if searches may use a CodeTraceIndex, stored next to the trace file.
+     */
+    CodeTraceReader(std::string trace_path, bool use_index = true);
+    CodeTraceReader(const CodeTraceReader &) = delete;
+    CodeTraceReader &operator=(const CodeTraceReader &) = delete;
+    /**
+     * Destructor for CodeTraceReader instances. Unmaps the trace file.
      */
-    CodeTraceReader(std::string trace_path);
+    ~CodeTraceReader();
+    /**
+     * Retrieves a view over the current hit being parsed.
+     * @return The current hit view, or nullptr past the last hit.
+     */
+    const CODE_HIT_VIEW *curr_hit_view();
+    /**
+     * Retrieves a view over the next hit to be parsed.
+     * @return The next hit view, or nullptr past the last hit.
+     */
+    const CODE_HIT_VIEW *next_hit_view();
+    /**
+     * Retrieves a view over the next hit in the given module to be parsed.
+     * @param[in] mod_id ID of the module to find next hit from.
+     * @return The next hit view in the given module, or nullptr past the last hit.
+     */
+    const CODE_HIT_VIEW *next_mod_hit_view(uint16_t mod_id);
+    /**
+     * Moves the reader to a given hit index and retrieves a view over this hit. Constant time before version 2,
+     * bounded by the size of a chunk since.
+     * @param[in] hit_i The hit index.
+     * @return The hit view, or nullptr past the last hit.
+     */
+    const CODE_HIT_VIEW *seek_hit_view(off_t hit_i);
+    /**
+     * Builds a new CODE_HIT from a hit view.
+     * @param[in] view The hit view.
+     * @return The new CODE_HIT instance, or nullptr if the view is nullptr.
+     */
+    std::unique_ptr<CODE_HIT> make_hit(const CODE_HIT_VIEW *view);
     /**
      * Retrieves the current hit being parsed.
      * @return The current hit being parsed.
@@ -146,6 +261,16 @@ class CodeTraceReader
      * Resets the reading cursor in the input trace file.
      */
     void reset_hit_cursor();
+    /**
+     * Retrieves the amount of hits in the trace file.
+     * @return The amount of hits.
+     */
+    size_t get_total_hits();
+    /**
+     * Retrieves the index of the trace file, loading or building it on first call. The reading cursor is preserved.
+     * @return The index, or nullptr if the reader does not use one.
+     */
+    CodeTraceIndex *get_index();
     /**
      * Retrieves the TRACE_MODE used to generate the trace file.
      * @return The TRACE_MODE used to generate the trace file.
@@ -157,12 +282,24 @@ class CodeTraceReader
      * @return The TRACE_MODULE instance.
      */
     std::unique_ptr<TRACE_MODULE> get_module(uint16_t mod_id);
+    /**
+     * Retrieves a TRACE_MODULE given its ID, without copying it.
+     * @param[in] mod_id ID of the module to be retrieved.
+     * @return The TRACE_MODULE instance, owned by the reader.
+     */
+    TRACE_MODULE *peek_module(uint16_t mod_id);
     /**
      * Retrieves a TRACE_MODULE given its name.
      * @param[in] name Name of the module to be retrieved.
      * @return The TRACE_MODULE instance.
      */
     std::unique_ptr<TRACE_MODULE> find_module_from_name(std::string name);
+    /**
+     * Retrieves the TRACE_MODULE instances whose address range contains a given address, without copying them.
+     * @param[in] addr The address.
+     * @return The TRACE_MODULE instances, owned by the reader.
+     */
+    std::vector<TRACE_MODULE *> find_modules_from_addr(ADDR addr);
     /**
      * Retrieves a TRACE_MODULE given its hash.
      * @param[in] hash Hash of the module to be retrieved.
@@ -176,6 +313,18 @@ class CodeTraceReader
      * @return True if the trace file contains the given context register.
      */
     bool has_reg(REG reg);
+    /**
+     * Retrieves the registers making up the context. Only makes sense for files generated with TRACE_MODE::CTXT.
+     * @return The context registers, in the order of the "regs" of a CODE_HIT_VIEW.
+     */
+    const std::vector<REG> &get_context_regs();
+    /**
+     * Retrieves the position of a context register in the "regs" of a CODE_HIT_VIEW. Only makes sense for files
+     * generated with TRACE_MODE::CTXT.
+     * @param[in] reg The context register.
+     * @return The register position.
+     */
+    size_t get_reg_index(REG reg);
 };
 
 /// This structure holds data relative to a trace hit (e.g : instruction, basic block...).
@@ -212,6 +361,10 @@ struct ARION_EXPORT ANALYSIS_HIT
 
 /// Callback called when a hit is being processed by a CodeTraceAnalyzer instance.
 using ANALYZER_HIT_CALLBACK = std::function<bool(std::unique_ptr<ANALYSIS_HIT> hit)>;
+/// Callback called when a hit view is being processed by a CodeTraceAnalyzer instance. The module and the hit view are
+/// only valid during the call.
+using ANALYZER_HIT_VIEW_CALLBACK =
+    std::function<bool(off_t hit_i, const TRACE_MODULE &mod, const CODE_HIT_VIEW &hit)>;
 
 /// This class is used to analyze data held in a trace file with various methods.
 class ARION_EXPORT CodeTraceAnalyzer
@@ -224,8 +377,9 @@ class ARION_EXPORT CodeTraceAnalyzer
     /**
      * Builder for CodeTraceAnalyzer instances.
      * @param[in] trace_path Path to the trace file.
+     * @param[in] use_index True if searches may use a CodeTraceIndex, stored next to the trace file.
      */
-    ARION_EXPORT CodeTraceAnalyzer(std::string trace_path);
+    ARION_EXPORT CodeTraceAnalyzer(std::string trace_path, bool use_index = true);
     /**
      * Tells the underlying reader to advance until it reaches a given PC address in a hit.
      * @param[in] addr The address to reach.
@@ -245,6 +399,13 @@ class ARION_EXPORT CodeTraceAnalyzer
      * @param[in] reset_cursor Whether the cursor of the underlying reader should be reset to the top of the trace file.
      */
     void ARION_EXPORT loop_on_every_hit(ANALYZER_HIT_CALLBACK callback, bool reset_cursor = true);
+    /**
+     * Calls the given callback on a view over every hit contained in the trace file. Unlike loop_on_every_hit, no
+     * memory is allocated for each hit.
+     * @param[in] callback The callback to be called for each hit view.
+     * @param[in] reset_cursor Whether the cursor of the underlying reader should be reset to the top of the trace file.
+     */
+    void ARION_EXPORT loop_on_every_hit_view(ANALYZER_HIT_VIEW_CALLBACK callback, bool reset_cursor = true);
     /**
      * Calls the given callback on every hit contained in a given module from the trace file.
      * @param[in] callback The callback to be called for each module hit.
@@ -287,6 +448,13 @@ class ARION_EXPORT CodeTraceAnalyzer
      */
     void ARION_EXPORT search_hit_offset_range(ANALYZER_HIT_CALLBACK callback, std::string name, ADDR start_off,
                                               ADDR end_off, bool reset_cursor = true);
+    /**
+     * Retrieves the position of a context register in the "regs" of a CODE_HIT_VIEW. Only makes sense for files
+     * generated with TRACE_MODE::CTXT.
+     * @param[in] reg The context register.
+     * @return The register position.
+     */
+    size_t ARION_EXPORT get_reg_index(REG reg);
 
     /**
      * Calls the callback when a hit contains a given register value. Only makes sense for files generated with
@@ -303,11 +471,12 @@ class ARION_EXPORT CodeTraceAnalyzer
         if (!this->reader.has_reg(reg))
             throw arion_exception::UnknownTraceRegException(reg);
 
+        size_t reg_i = this->reader.get_reg_index(reg);
         this->reader.reset_hit_cursor();
-        std::unique_ptr<CODE_HIT> hit;
-        while ((hit = this->reader.next_hit()))
+        const CODE_HIT_VIEW *hit;
+        while ((hit = this->reader.next_hit_view()))
         {
-            RVAL hit_val = hit->regs->at(reg);
+            const RVAL &hit_val = hit->regs[reg_i];
             bool is_equal = false;
             if constexpr (std::is_same_v<T, RVAL8>)
                 if (hit_val.r8 != val)
@@ -330,8 +499,10 @@ class ARION_EXPORT CodeTraceAnalyzer
             if constexpr (std::is_same_v<T, RVAL512>)
                 if (hit_val.r512 != val)
                     continue;
-            std::unique_ptr<TRACE_MODULE> mod = this->reader.get_module(hit->mod_id);
-            if (!callback(std::make_unique<ANALYSIS_HIT>(mod->name, hit->off, hit->sz, hit->regs.get())))
+            std::unique_ptr<CODE_HIT> code_hit = this->reader.make_hit(hit);
+            if (!callback(std::make_unique<ANALYSIS_HIT>(this->reader.get_hit_index(),
+                                                         this->reader.peek_module(hit->mod_id)->name, hit->off,
+                                                         hit->sz, code_hit->regs.get())))
                 return;
         }
     }
@@ -355,8 +526,9 @@ class ARION_EXPORT CodeTraceComparator
      * Builder instance for CodeTraceComparator instances.
      * @param[in] trace_path1 Path to the first trace file.
      * @param[in] trace_path1 Path to the second trace file.
+     * @param[in] use_index True if searches may use a CodeTraceIndex, stored next to each trace file.
      */
-    ARION_EXPORT CodeTraceComparator(std::string trace_path1, std::string trace_path2);
+    ARION_EXPORT CodeTraceComparator(std::string trace_path1, std::string trace_path2, bool use_index = true);
     /**
      * Tells the underlying readers to advance until they reach a given PC address in a hit.
      * @param[in] addr The address to reach.
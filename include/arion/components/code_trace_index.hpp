@@ -0,0 +1,152 @@
+#ifndef ARION_CODE_TRACE_INDEX_HPP
+#define ARION_CODE_TRACE_INDEX_HPP
+
+#include <arion/common/global_defs.hpp>
+#include <string>
+#include <vector>
+
+/// Number of consecutive hits summarized by a block of a trace index.
+#define ARION_TRACE_INDEX_BLOCK_HITS 0x1000
+/// Number of postings of a trace index key between two of its skip entries.
+#define ARION_TRACE_INDEX_SKIP_POSTINGS 0x40
+
+namespace arion
+{
+
+class CodeTraceReader;
+
+/// Magic string for headers of Arion trace index files.
+const char TRACE_INDEX_FILE_MAGIC[] = "ARIONIDX";
+/// Version number of Arion trace index file format.
+const uint32_t TRACE_INDEX_FILE_VERSION = 2;
+/// Extension appended to the path of a trace file to get the path of its index file.
+const char TRACE_INDEX_FILE_EXT[] = ".idx";
+
+/// Entry of a trace index, listing the hits which start at a given module offset.
+struct TRACE_INDEX_KEY
+{
+    /// Offset in the postings of the hit indices, encoded as variable-length deltas.
+    uint64_t postings_off;
+    /// Index of the first skip entry of this key, followed by one entry every ARION_TRACE_INDEX_SKIP_POSTINGS postings.
+    uint64_t skips_off;
+    /// Number of hits starting at this module offset.
+    uint64_t count;
+    /// Offset of the hits relative to the start address of their module.
+    uint32_t off;
+    /// ID of the hits module.
+    uint16_t mod_id;
+    /// Largest size of the hits starting at this module offset.
+    uint16_t max_sz;
+};
+
+/// Skip entry of a trace index key, allowing to decode its postings from the middle.
+struct TRACE_INDEX_SKIP
+{
+    /// Hit index of the posting preceding the skipped-to posting, which its delta is relative to.
+    uint64_t hit_i;
+    /// Offset in the postings of the skipped-to posting.
+    uint64_t postings_off;
+};
+
+/// Address bounds of a block of ARION_TRACE_INDEX_BLOCK_HITS consecutive hits in a trace index.
+struct TRACE_INDEX_BLOCK
+{
+    /// Lowest start address of a hit in the block.
+    ADDR min_addr;
+    /// Highest end address of a hit in the block.
+    ADDR max_addr;
+};
+
+/// This class indexes the hits of a trace file, so that hits at a given address can be found without scanning the
+/// whole trace. The index is stored in a sidecar file next to the trace file and reused as long as the trace file is
+/// not modified.
+class CodeTraceIndex
+{
+  private:
+    /// Path to the index file.
+    std::string idx_path;
+    /// Size in bytes of the indexed trace file.
+    uint64_t trace_f_sz;
+    /// Amount of hits in the indexed trace file.
+    uint64_t total_hits;
+    /// Address bounds of each block of hits.
+    std::vector<TRACE_INDEX_BLOCK> blocks;
+    /// Keys of the index, sorted by module ID then offset.
+    std::vector<TRACE_INDEX_KEY> keys;
+    /// Hit indices of every key, encoded as variable-length deltas.
+    std::vector<BYTE> postings;
+    /// Skip entries of every key.
+    std::vector<TRACE_INDEX_SKIP> skips;
+    /// Largest size of a hit in the trace file.
+    uint16_t max_sz = 0;
+    /**
+     * Loads the index file, if it exists and matches the trace file.
+     * @param[in] trace_path Path to the trace file.
+     * @return True if the index file was loaded.
+     */
+    bool load(std::string trace_path);
+    /**
+     * Builds the index by reading all hits of the trace file.
+     * @param[in] reader The CodeTraceReader of the trace file. Its cursor is left past the last hit.
+     */
+    void build(CodeTraceReader &reader);
+    /**
+     * Stores the index in the index file. Failing to write it is not an error, the index is then rebuilt the next
+     * time.
+     */
+    void save();
+    /**
+     * Finds where to start decoding the postings of a key to reach a given hit index, skipping the postings before it.
+     * @param[in] key The index key.
+     * @param[in] from_hit_i The hit index to search from.
+     * @param[out] hit_i Hit index the next posting delta is relative to.
+     * @param[out] posting_i Number of skipped postings.
+     * @return The offset in the postings to decode from.
+     */
+    size_t seek_postings(const TRACE_INDEX_KEY *key, off_t from_hit_i, uint64_t &hit_i, uint64_t &posting_i);
+
+  public:
+    /**
+     * Builder for CodeTraceIndex instances. Loads the index file or builds it and stores it when missing or outdated.
+     * @param[in] trace_path Path to the trace file.
+     * @param[in] reader The CodeTraceReader of the trace file, used to build the index. Its cursor may be moved.
+     */
+    CodeTraceIndex(std::string trace_path, CodeTraceReader &reader);
+    /**
+     * Retrieves the key listing the hits which start at a given module offset.
+     * @param[in] mod_id ID of the module.
+     * @param[in] off Offset relative to the start address of the module.
+     * @return The key, or nullptr if no hit starts at this module offset.
+     */
+    const TRACE_INDEX_KEY *find_key(uint16_t mod_id, uint32_t off);
+    /**
+     * Retrieves the keys whose hits may contain a given module offset.
+     * @param[in] mod_id ID of the module.
+     * @param[in] off Offset relative to the start address of the module.
+     * @return The keys, sorted by offset.
+     */
+    std::vector<const TRACE_INDEX_KEY *> find_keys_containing(uint16_t mod_id, uint32_t off);
+    /**
+     * Retrieves the first hit of a key at or after a given hit index.
+     * @param[in] key The index key.
+     * @param[in] from_hit_i The hit index to search from.
+     * @return The hit index, or -1 if there is none.
+     */
+    off_t next_hit(const TRACE_INDEX_KEY *key, off_t from_hit_i);
+    /**
+     * Retrieves all hits of a key at or after a given hit index.
+     * @param[in] key The index key.
+     * @param[in] from_hit_i The hit index to search from.
+     * @return The hit indices, in ascending order.
+     */
+    std::vector<off_t> get_hits(const TRACE_INDEX_KEY *key, off_t from_hit_i);
+    /**
+     * Retrieves the address bounds of each block of ARION_TRACE_INDEX_BLOCK_HITS consecutive hits.
+     * @return The blocks, in the order of the hits.
+     */
+    const std::vector<TRACE_INDEX_BLOCK> &get_blocks();
+};
+
+}; // namespace arion
+
+#endif // ARION_CODE_TRACE_INDEX_HPP
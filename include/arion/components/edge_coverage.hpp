@@ -0,0 +1,122 @@
+#ifndef ARION_EDGE_COVERAGE_HPP
+#define ARION_EDGE_COVERAGE_HPP
+
+#include <arion/arion.hpp>
+#include <arion/common/global_defs.hpp>
+#include <arion/common/hooks_manager.hpp>
+#include <map>
+#include <memory>
+#include <vector>
+
+/// Default size of an edge coverage bitmap, the same as AFL.
+#define ARION_EDGE_MAP_SZ 0x10000
+
+namespace arion
+{
+
+/// This class collects AFL-compatible edge coverage, where the edge between two basic blocks increments the bitmap
+/// entry at index (prev_loc >> 1) ^ cur_loc. Entries are 8-bit counters that never wrap back to zero.
+class ARION_EXPORT EdgeCoverage
+{
+  private:
+    /// The Arion instance whose coverage is being collected.
+    std::weak_ptr<Arion> arion;
+    /// Bitmap owned by this instance, used when no external bitmap is provided.
+    std::vector<uint8_t> own_bitmap;
+    /// The bitmap being filled, which may be an external shared-memory area.
+    uint8_t *bitmap = nullptr;
+    /// Size of the bitmap, a power of two.
+    size_t bitmap_sz = 0;
+    /// Location of the previous basic block, already shifted.
+    uint32_t prev_loc = 0;
+    /// ID of the block hook filling the bitmap.
+    HOOK_ID hook_id = 0;
+    /// Whether coverage is currently being collected.
+    bool started = false;
+    /**
+     * This hook is triggered at every basic block and updates the bitmap entry of the edge reaching it.
+     * @param[in] arion The Arion instance that produced the block hit.
+     * @param[in] addr The address at which the block was hit.
+     * @param[in] sz The size of the block that was hit.
+     * @param[in] user_data The EdgeCoverage instance.
+     */
+    static void block_hook(Arion &arion, ADDR addr, size_t sz, void *user_data);
+
+  public:
+    /**
+     * Builder for EdgeCoverage instances.
+     * @param[in] arion The Arion instance whose coverage is collected.
+     */
+    ARION_EXPORT EdgeCoverage(std::weak_ptr<Arion> arion) : arion(arion) {};
+    /**
+     * Destructor for EdgeCoverage instances, stopping coverage collection.
+     */
+    ARION_EXPORT ~EdgeCoverage();
+    /**
+     * Computes the location of a basic block in a coverage bitmap, the same way as UnicornAFL.
+     * @param[in] addr The basic block address.
+     * @param[in] bitmap_sz Size of the bitmap, a power of two.
+     * @return The basic block location.
+     */
+    static inline uint32_t get_block_loc(ADDR addr, size_t bitmap_sz)
+    {
+        return ((addr >> 4) ^ (addr << 8)) & (bitmap_sz - 1);
+    }
+    /**
+     * Starts collecting edge coverage.
+     * @param[in] bitmap An external bitmap to be filled (e.g : AFL shared memory), or nullptr to use an internal one.
+     * @param[in] bitmap_sz Size of the bitmap, which must be a power of two.
+     * @param[in] start Start of the code range whose blocks are covered.
+     * @param[in] end End of the code range whose blocks are covered.
+     */
+    void ARION_EXPORT start(uint8_t *bitmap = nullptr, size_t bitmap_sz = ARION_EDGE_MAP_SZ, ADDR start = 0,
+                            ADDR end = ARION_MAX_U64);
+    /**
+     * Stops collecting edge coverage. The bitmap content is kept.
+     */
+    void ARION_EXPORT stop();
+    /**
+     * Tells whether edge coverage is currently being collected.
+     * @return True if edge coverage is being collected.
+     */
+    bool ARION_EXPORT is_started();
+    /**
+     * Clears the bitmap and forgets the previous basic block, which is typically done before running a new input.
+     */
+    void ARION_EXPORT reset();
+    /**
+     * Forgets the previous basic block without clearing the bitmap, so that no edge links two separate executions.
+     */
+    void ARION_EXPORT reset_prev_loc();
+    /**
+     * Retrieves the bitmap being filled.
+     * @return The bitmap, nullptr if coverage was never started.
+     */
+    const uint8_t ARION_EXPORT *get_bitmap();
+    /**
+     * Retrieves the size of the bitmap being filled.
+     * @return The bitmap size.
+     */
+    size_t ARION_EXPORT get_bitmap_size();
+    /**
+     * Retrieves the hit count of every edge that was hit.
+     * @return A map identifying the saturated hit count of an edge given its bitmap index.
+     */
+    std::map<uint32_t, uint8_t> ARION_EXPORT get_edge_hits();
+    /**
+     * Retrieves the hit count of the edge between two basic blocks. Collisions in the bitmap are not distinguished.
+     * @param[in] prev_addr Address of the source basic block.
+     * @param[in] cur_addr Address of the destination basic block.
+     * @return The saturated hit count of the edge.
+     */
+    uint8_t ARION_EXPORT get_edge_hits(ADDR prev_addr, ADDR cur_addr);
+    /**
+     * Counts the number of edges that were hit.
+     * @return The number of non-zero bitmap entries.
+     */
+    size_t ARION_EXPORT count_edges();
+};
+
+}; // namespace arion
+
+#endif // ARION_EDGE_COVERAGE_HPP
@@ -94,6 +94,64 @@ std::string inline demangle_cxx_symbol(std::string mangled_name)
     return (!status) ? demangled.get() : mangled_name;
 }
 
+/**
+ * Encodes an unsigned integer as a LEB128 variable-length integer, 7 bits per byte.
+ * @param[in] val The value to encode.
+ * @param[out] out Buffer receiving the encoded value. It must hold at least ARION_MAX_VARINT_SZ bytes.
+ * @return The number of bytes written in the buffer.
+ */
+size_t inline encode_varint(uint64_t val, BYTE *out)
+{
+    size_t sz = 0;
+    while (val >= 0x80)
+    {
+        out[sz++] = (BYTE)(val | 0x80);
+        val >>= 7;
+    }
+    out[sz++] = (BYTE)val;
+    return sz;
+}
+
+/**
+ * Decodes a LEB128 variable-length integer.
+ * @param[in] in Buffer holding the encoded value.
+ * @param[in,out] pos Position of the encoded value in the buffer, advanced past it.
+ * @param[in] sz Size of the buffer. Decoding stops at its end.
+ * @return The decoded value.
+ */
+uint64_t inline decode_varint(const BYTE *in, size_t &pos, size_t sz)
+{
+    uint64_t val = 0;
+    for (uint8_t shift = 0; pos < sz && shift < 64; shift += 7)
+    {
+        BYTE b = in[pos++];
+        val |= (uint64_t)(b & 0x7F) << shift;
+        if (!(b & 0x80))
+            break;
+    }
+    return val;
+}
+
+/**
+ * Maps a signed integer to an unsigned one so that values close to zero have a short variable-length encoding.
+ * @param[in] val The signed value.
+ * @return The ZigZag-encoded value.
+ */
+uint64_t inline encode_zigzag(int64_t val)
+{
+    return ((uint64_t)val << 1) ^ (uint64_t)(val >> 63);
+}
+
+/**
+ * Reverts encode_zigzag.
+ * @param[in] val The ZigZag-encoded value.
+ * @return The signed value.
+ */
+int64_t inline decode_zigzag(uint64_t val)
+{
+    return (int64_t)(val >> 1) ^ -(int64_t)(val & 1);
+}
+
 /**
  * Removes leading and trailing whitespace from a string.
  * @param[in] str The string to strip.
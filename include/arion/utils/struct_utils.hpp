@@ -928,13 +928,13 @@ class AbsArionStructType
      */
     arion::CPU_ARCH arion_curr_arch(std::shared_ptr<arion::Arion> arion);
     /**
-     * Reads a chunk of memory from the emulated system.
+     * Reads a chunk of memory from the emulated system into a caller-provided buffer.
      * @param[in] arion Shared pointer to the Arion instance.
      * @param[in] addr The starting address to read from.
+     * @param[out] buf The buffer receiving the memory data, at least `sz` bytes long.
      * @param[in] sz The number of bytes to read.
-     * @return A vector of bytes containing the read memory data.
      */
-    std::vector<arion::BYTE> arion_read_mem(std::shared_ptr<arion::Arion> arion, arion::ADDR addr, size_t sz);
+    void arion_read_mem(std::shared_ptr<arion::Arion> arion, arion::ADDR addr, arion::BYTE *buf, size_t sz);
 };
 
 /**
@@ -972,8 +972,7 @@ template <typename T> class ArionStructType : public arion_type::KernelType, pub
         arion::CPU_ARCH arch = this->arion_curr_arch(arion);
         size_t struct_sz = this->factory->get_struct_sz(arch);
         arion::BYTE *struct_buf = (arion::BYTE *)malloc(struct_sz);
-        std::vector<arion::BYTE> struct_data = this->arion_read_mem(arion, val, struct_sz);
-        memcpy(struct_buf, struct_data.data(), struct_sz);
+        this->arion_read_mem(arion, val, struct_buf, struct_sz);
         arion_poly_struct::STRUCT_ID struct_id = this->factory->feed(arch, struct_buf);
         std::string struct_str = this->factory->to_string(struct_id, arion, arch);
         free(struct_buf);
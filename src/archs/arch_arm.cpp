@@ -67,7 +67,8 @@ void ArchManagerARM::setup()
     if (!arion)
         throw ExpiredWeakPtrException("Arion");
 
-    arion->hooks->hook_intr(ArchManagerARM::int_hook);
+    HOOK_ID hook_id = arion->hooks->hook_intr(ArchManagerARM::int_hook);
+    arion->hooks->set_hook_label(hook_id, "ArchManagerARM::int_hook");
     this->enable_vfp();
 }
 
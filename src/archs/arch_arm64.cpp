@@ -62,7 +62,8 @@ void ArchManagerARM64::setup()
     if (!arion)
         throw ExpiredWeakPtrException("Arion");
 
-    arion->hooks->hook_intr(ArchManagerARM64::int_hook);
+    HOOK_ID hook_id = arion->hooks->hook_intr(ArchManagerARM64::int_hook);
+    arion->hooks->set_hook_label(hook_id, "ArchManagerARM64::int_hook");
     this->enable_lse();
     this->enable_vfp();
 }
@@ -42,7 +42,8 @@ void ArchManagerX8664::setup()
     if (!arion)
         throw ExpiredWeakPtrException("Arion");
 
-    arion->hooks->hook_insn(ArchManagerX8664::syscall_hook, UC_X86_INS_SYSCALL);
+    HOOK_ID hook_id = arion->hooks->hook_insn(ArchManagerX8664::syscall_hook, UC_X86_INS_SYSCALL);
+    arion->hooks->set_hook_label(hook_id, "ArchManagerX8664::syscall_hook");
 }
 
 ADDR ArchManagerX8664::dump_tls()
@@ -28,7 +28,8 @@ void ArchManagerX86::setup()
     if (!arion)
         throw ExpiredWeakPtrException("Arion");
 
-    arion->hooks->hook_intr(ArchManagerX86::int_hook);
+    HOOK_ID hook_id = arion->hooks->hook_intr(ArchManagerX86::int_hook);
+    arion->hooks->set_hook_label(hook_id, "ArchManagerX86::int_hook");
     // May implement sysenter hook by the future instead of patching vdso.bin to remove that instruction
 }
 
@@ -52,8 +53,7 @@ uint16_t ArchManagerX86::new_tls(ADDR udesc_addr)
         throw ExpiredWeakPtrException("Arion");
 
     struct user_desc *u_desc = (struct user_desc *)malloc(sizeof(struct user_desc));
-    std::vector<BYTE> u_desc_data = arion->mem->read(udesc_addr, sizeof(struct user_desc));
-    memcpy(u_desc, u_desc_data.data(), u_desc_data.size());
+    arion->mem->read_into(udesc_addr, u_desc, sizeof(struct user_desc));
 
     if (u_desc->entry_number == 0xFFFFFFFF)
         u_desc->entry_number = 12;
@@ -419,8 +419,9 @@ bool Arion::run_current()
     }
     this->arch->prerun_hook(pc_addr);
     uc_err uc_run_err = uc_emu_start(this->uc, pc_addr, this->end.value_or(0), 0,
-                                     (multi_process || multi_thread) ? ARION_CYCLES_PER_THREAD : 0);
+                                     (multi_process || multi_thread) ? this->threads->get_quantum() : 0);
     this->running = false;
+    this->hooks->flush_mem_traces();
     pc_addr = this->arch->read_arch_reg(pc);
     if (this->uc_exception)
         std::rethrow_exception(this->uc_exception);
@@ -434,6 +435,7 @@ bool Arion::run_current()
     threads_count = this->threads->get_threads_count();
     if (!threads_count)
         return false;
+    this->threads->end_time_slice(this->sync);
     this->threads->switch_to_next_thread();
     if (this->sync)
     {
@@ -487,7 +489,8 @@ std::shared_ptr<Arion> Arion::copy()
     if (!group)
         throw ExpiredWeakPtrException("ArionGroup");
     group->add_arion_instance(arion_cpy, std::nullopt, this->get_pgid());
-    std::shared_ptr<ARION_CONTEXT> ctx = this->context->save();
+    // Host-backed memory is shared copy-on-write with the copy, so that only pages written by either side get duplicated
+    std::shared_ptr<ARION_CONTEXT> ctx = this->context->save(true);
     arion_cpy->context->restore(ctx);
     return arion_cpy;
 }
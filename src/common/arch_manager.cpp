@@ -12,13 +12,119 @@
 #include <arion/platforms/linux/archs/lnx_arch_x86.hpp>
 #include <arion/unicorn/unicorn.h>
 #include <arion/unicorn/x86.h>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <sys/wait.h>
 
 using namespace arion;
 using namespace arion_exception;
 
+REG_FILE_LAYOUT::REG_FILE_LAYOUT(std::vector<REG> regs, std::vector<uint8_t> regs_sz)
+    : regs(regs), regs_sz(regs_sz)
+{
+    for (size_t reg_i = 0; reg_i < this->regs.size(); reg_i++)
+    {
+        REG reg = this->regs.at(reg_i);
+        this->uc_regs.push_back((int)reg);
+        this->regs_off.push_back(this->data_sz);
+        this->idx_by_reg[reg] = reg_i;
+        // Slots are 8-byte aligned and never smaller than 8 bytes, as Unicorn may write a full word for small registers
+        this->data_sz += (std::max<size_t>(this->regs_sz.at(reg_i), sizeof(uint64_t)) + 7) & ~(size_t)7;
+    }
+}
+
+RegisterFile::RegisterFile(std::shared_ptr<REG_FILE_LAYOUT> layout)
+    : layout(layout), data(layout->data_sz / sizeof(uint64_t), 0)
+{
+    this->bind_vals();
+}
+
+RegisterFile::RegisterFile(const RegisterFile &regs) : layout(regs.layout), data(regs.data)
+{
+    this->bind_vals();
+}
+
+RegisterFile &RegisterFile::operator=(const RegisterFile &regs)
+{
+    if (this == &regs)
+        return *this;
+    bool same_layout = this->layout == regs.layout;
+    this->layout = regs.layout;
+    this->data = regs.data;
+    if (!same_layout)
+        this->bind_vals();
+    return *this;
+}
+
+void RegisterFile::bind_vals()
+{
+    this->vals.clear();
+    BYTE *data = (BYTE *)this->data.data();
+    for (size_t reg_off : this->layout->regs_off)
+        this->vals.push_back(data + reg_off);
+}
+
+std::shared_ptr<REG_FILE_LAYOUT> RegisterFile::get_layout()
+{
+    return this->layout;
+}
+
+size_t RegisterFile::count()
+{
+    return this->layout->regs.size();
+}
+
+REG RegisterFile::get_reg_at(size_t reg_i)
+{
+    return this->layout->regs.at(reg_i);
+}
+
+bool RegisterFile::has_reg(REG reg)
+{
+    return this->layout->idx_by_reg.find(reg) != this->layout->idx_by_reg.end();
+}
+
+RVAL RegisterFile::get_at(size_t reg_i)
+{
+    RVAL val;
+    memset(&val, 0, sizeof(RVAL));
+    memcpy(&val, this->vals.at(reg_i), std::min<size_t>(this->layout->regs_sz.at(reg_i), sizeof(RVAL)));
+    return val;
+}
+
+RVAL RegisterFile::get(REG reg)
+{
+    auto idx_it = this->layout->idx_by_reg.find(reg);
+    if (idx_it == this->layout->idx_by_reg.end())
+        throw NoRegWithValueException(reg);
+    return this->get_at(idx_it->second);
+}
+
+void RegisterFile::set_at(size_t reg_i, RVAL val)
+{
+    memcpy(this->vals.at(reg_i), &val, std::min<size_t>(this->layout->regs_sz.at(reg_i), sizeof(RVAL)));
+}
+
+void RegisterFile::set(REG reg, RVAL val)
+{
+    auto idx_it = this->layout->idx_by_reg.find(reg);
+    if (idx_it == this->layout->idx_by_reg.end())
+        throw NoRegWithValueException(reg);
+    this->set_at(idx_it->second, val);
+}
+
+int *RegisterFile::get_uc_regs()
+{
+    return this->layout->uc_regs.data();
+}
+
+void **RegisterFile::get_uc_vals()
+{
+    return this->vals.data();
+}
+
 std::map<CPU_INTR, int> ArchManager::signo_by_intr = {
     // x86 interrupts
     {CPU_INTR::DIVIDE_ERROR, SIGFPE},
@@ -179,50 +285,54 @@ std::vector<REG> ArchManager::get_context_regs()
     return this->ctxt_regs;
 }
 
-std::unique_ptr<std::map<REG, RVAL>> ArchManager::dump_regs()
+std::shared_ptr<REG_FILE_LAYOUT> ArchManager::make_reg_file_layout(std::vector<REG> regs)
 {
-    std::unique_ptr<std::map<REG, RVAL>> regs = std::make_unique<std::map<REG, RVAL>>();
-    for (REG reg : this->ctxt_regs)
+    std::vector<uint8_t> regs_sz;
+    for (REG reg : regs)
     {
-        uint8_t reg_sz = this->arch_regs_sz.at(reg);
-        if (reg_sz == 1)
-            regs->operator[](reg).r8 = this->read_reg<RVAL8>(reg);
-        else if (reg_sz == 2)
-            regs->operator[](reg).r16 = this->read_reg<RVAL16>(reg);
-        else if (reg_sz <= 4)
-            regs->operator[](reg).r32 = this->read_reg<RVAL32>(reg);
-        else if (reg_sz <= 8)
-            regs->operator[](reg).r64 = this->read_reg<RVAL64>(reg);
-        else if (reg_sz <= 16)
-            regs->operator[](reg).r128 = this->read_reg<RVAL128>(reg);
-        else if (reg_sz <= 32)
-            regs->operator[](reg).r256 = this->read_reg<RVAL256>(reg);
-        else
-            regs->operator[](reg).r512 = this->read_reg<RVAL512>(reg);
+        auto reg_sz_it = this->arch_regs_sz.find(reg);
+        if (reg_sz_it == this->arch_regs_sz.end())
+            throw NoRegWithValueException(reg);
+        regs_sz.push_back(reg_sz_it->second);
     }
-    return std::move(regs);
+    return std::make_shared<REG_FILE_LAYOUT>(regs, regs_sz);
 }
 
-void ArchManager::load_regs(std::unique_ptr<std::map<REG, RVAL>> regs)
+std::unique_ptr<RegisterFile> ArchManager::new_reg_file()
 {
-    for (auto reg_it : *regs)
-    {
-        uint8_t reg_sz = this->arch_regs_sz.at(reg_it.first);
-        if (reg_sz == 1)
-            this->write_reg<RVAL8>(reg_it.first, reg_it.second.r8);
-        else if (reg_sz == 2)
-            this->write_reg<RVAL16>(reg_it.first, reg_it.second.r16);
-        else if (reg_sz <= 4)
-            this->write_reg<RVAL32>(reg_it.first, reg_it.second.r32);
-        else if (reg_sz <= 8)
-            this->write_reg<RVAL64>(reg_it.first, reg_it.second.r64);
-        else if (reg_sz <= 16)
-            this->write_reg<RVAL128>(reg_it.first, reg_it.second.r128);
-        else if (reg_sz <= 32)
-            this->write_reg<RVAL256>(reg_it.first, reg_it.second.r256);
-        else
-            this->write_reg<RVAL512>(reg_it.first, reg_it.second.r512);
-    }
+    return std::make_unique<RegisterFile>(this->ctxt_layout);
+}
+
+std::unique_ptr<RegisterFile> ArchManager::new_reg_file(std::map<REG, RVAL> &regs)
+{
+    std::vector<REG> file_regs;
+    for (auto &reg_it : regs)
+        file_regs.push_back(reg_it.first);
+    std::unique_ptr<RegisterFile> reg_file = std::make_unique<RegisterFile>(this->make_reg_file_layout(file_regs));
+    for (size_t reg_i = 0; reg_i < file_regs.size(); reg_i++)
+        reg_file->set_at(reg_i, regs.at(file_regs.at(reg_i)));
+    return reg_file;
+}
+
+std::unique_ptr<RegisterFile> ArchManager::dump_regs()
+{
+    std::unique_ptr<RegisterFile> regs = this->new_reg_file();
+    this->dump_regs(*regs);
+    return regs;
+}
+
+void ArchManager::dump_regs(RegisterFile &regs)
+{
+    uc_err uc_reg_err = uc_reg_read_batch(this->uc, regs.get_uc_regs(), regs.get_uc_vals(), regs.count());
+    if (uc_reg_err != UC_ERR_OK)
+        throw UnicornRegReadException(uc_reg_err);
+}
+
+void ArchManager::load_regs(RegisterFile &regs)
+{
+    uc_err uc_reg_err = uc_reg_write_batch(this->uc, regs.get_uc_regs(), regs.get_uc_vals(), regs.count());
+    if (uc_reg_err != UC_ERR_OK)
+        throw UnicornRegWriteException(uc_reg_err);
 }
 
 bool ArchManager::has_idt_entry(uint64_t intno)
@@ -238,23 +348,26 @@ CPU_INTR ArchManager::get_idt_entry(uint64_t intno)
     return cpu_idt_it->second;
 }
 
-std::unique_ptr<std::map<REG, RVAL>> ArchManager::init_thread_regs(ADDR pc, ADDR sp)
+std::unique_ptr<RegisterFile> ArchManager::init_thread_regs(ADDR pc, ADDR sp)
 {
-    std::unique_ptr<std::map<REG, RVAL>> regs = this->dump_regs();
+    std::unique_ptr<RegisterFile> regs = this->dump_regs();
+    RVAL pc_val, sp_val;
     switch (this->attrs->arch_sz)
     {
     case 64:
-        regs->operator[](this->attrs->regs.pc).r64 = pc;
-        regs->operator[](this->attrs->regs.sp).r64 = sp;
+        pc_val.r64 = pc;
+        sp_val.r64 = sp;
         break;
     case 32:
-        regs->operator[](this->attrs->regs.pc).r32 = pc;
-        regs->operator[](this->attrs->regs.sp).r32 = sp;
+        pc_val.r32 = pc;
+        sp_val.r32 = sp;
         break;
     default:
         throw UnsupportedCpuArchException();
     }
-    return std::move(regs);
+    regs->set(this->attrs->regs.pc, pc_val);
+    regs->set(this->attrs->regs.sp, sp_val);
+    return regs;
 }
 
 uint64_t ArchManager::read_arch_reg(arion::REG reg)
@@ -4,7 +4,9 @@
 #include <arion/common/global_excepts.hpp>
 #include <arion/utils/convert_utils.hpp>
 #include <arion/utils/fs_utils.hpp>
+#include <algorithm>
 #include <cstdint>
+#include <cstring>
 #include <filesystem>
 #include <ios>
 #include <iosfwd>
@@ -18,14 +20,14 @@ std::unique_ptr<CodeTracer> CodeTracer::initialize(std::weak_ptr<Arion> arion)
     return std::move(std::make_unique<CodeTracer>(arion));
 }
 
-void CodeTracer::instr_hook(std::shared_ptr<Arion> arion, ADDR addr, size_t sz, void *user_data)
+void CodeTracer::instr_hook(Arion &arion, ADDR addr, size_t sz, void *user_data)
 {
-    arion->tracer->process_hit(addr, sz);
+    arion.tracer->process_hit(arion, addr, sz);
 }
 
-void CodeTracer::block_hook(std::shared_ptr<Arion> arion, ADDR addr, size_t sz, void *user_data)
+void CodeTracer::block_hook(Arion &arion, ADDR addr, size_t sz, void *user_data)
 {
-    arion->tracer->process_hit(addr, sz);
+    arion.tracer->process_hit(arion, addr, sz);
 }
 
 void CodeTracer::prepare_file()
@@ -64,17 +66,21 @@ void CodeTracer::prepare_file()
         this->out_f.seekp(sizeof(off_t), std::ios::cur); // Reserved for later replacement of Modules Section
         off_t regs_sec_off = 0;
         if (this->mode == TRACE_MODE::CTXT)
-            regs_sec_off = (off_t)this->out_f.tellp() + sizeof(off_t) * 2;
+            regs_sec_off = (off_t)this->out_f.tellp() + sizeof(off_t) * 3;
         this->out_f.write((char *)&regs_sec_off, sizeof(off_t));
-        std::vector<REG> ctxt_regs = arion->arch->get_context_regs();
-        size_t ctxt_regs_sz = ctxt_regs.size();
-        off_t data_sec_off = (off_t)this->out_f.tellp() + sizeof(off_t) + sizeof(size_t) + ctxt_regs_sz * sizeof(REG);
+        std::shared_ptr<REG_FILE_LAYOUT> ctxt_layout = arion->arch->new_reg_file()->get_layout();
+        size_t ctxt_regs_sz = ctxt_layout->regs.size();
+        off_t data_sec_off = (off_t)this->out_f.tellp() + sizeof(off_t) * 2 + sizeof(size_t) +
+                             ctxt_regs_sz * (sizeof(REG) + sizeof(uint8_t));
         this->out_f.write((char *)&data_sec_off, sizeof(off_t));
+        this->chunks_sec_off = this->out_f.tellp();
+        this->out_f.seekp(sizeof(off_t), std::ios::cur); // Reserved for later replacement of Chunks Section
 
         // Start of Registers Section
         this->out_f.write((char *)&ctxt_regs_sz, sizeof(size_t));
-        for (REG reg : ctxt_regs)
+        for (REG reg : ctxt_layout->regs)
             this->out_f.write((char *)&reg, sizeof(REG));
+        this->out_f.write((char *)ctxt_layout->regs_sz.data(), ctxt_regs_sz * sizeof(uint8_t));
         break;
     }
     case TRACE_MODE::DRCOV:
@@ -114,6 +120,15 @@ void CodeTracer::release_file()
             this->out_f.write((char *)&mod_hash_len, sizeof(uint16_t));
             this->out_f.write(mod_hash.c_str(), mod_hash_len);
         }
+
+        // Start of Chunks Section
+        off_t chunks_pos = this->out_f.tellp();
+        this->out_f.seekp(this->chunks_sec_off);
+        this->out_f.write((char *)&chunks_pos, sizeof(off_t));
+        this->out_f.seekp(chunks_pos);
+        uint64_t chunks_sz = this->chunks.size();
+        this->out_f.write((char *)&chunks_sz, sizeof(uint64_t));
+        this->out_f.write((char *)this->chunks.data(), chunks_sz * sizeof(TRACER_CHUNK));
         break;
     }
     case TRACE_MODE::DRCOV: {
@@ -150,52 +165,185 @@ void CodeTracer::release_file()
         this->out_f.close();
 }
 
-void CodeTracer::process_hit(ADDR addr, size_t sz)
+void CodeTracer::index_mappings()
+{
+    this->ranges.clear();
+    for (size_t mod_id = 0; mod_id < this->mappings.size(); mod_id++)
+    {
+        std::unique_ptr<TRACER_MAPPING> &mapping = this->mappings.at(mod_id);
+        this->ranges.push_back(TRACER_RANGE{mapping->start, mapping->end, (uint16_t)mod_id});
+    }
+    std::sort(this->ranges.begin(), this->ranges.end(),
+              [](const TRACER_RANGE &range1, const TRACER_RANGE &range2) { return range1.start < range2.start; });
+    this->last_range = {0, 0, 0};
+}
+
+void CodeTracer::process_hit(Arion &arion, ADDR addr, size_t sz)
+{
+    if (addr < this->last_range.start || addr >= this->last_range.end)
+    {
+        auto range_it =
+            std::upper_bound(this->ranges.begin(), this->ranges.end(), addr,
+                             [](ADDR addr, const TRACER_RANGE &range) { return addr < range.start; });
+        if (range_it == this->ranges.begin())
+            return;
+        range_it--;
+        if (addr >= range_it->end)
+            return;
+        this->last_range = *range_it;
+    }
+
+    this->total_hits++;
+    TRACER_BUFFER *buf = this->curr_buf;
+    TRACER_HIT &hit = buf->hits[buf->count];
+    hit.off = addr - this->last_range.start;
+    hit.sz = sz;
+    hit.mod_id = this->last_range.mod_id;
+    if (this->mode == TRACE_MODE::CTXT)
+        arion.arch->dump_regs(buf->regs[buf->count]);
+    if (++buf->count >= buf->hits.size())
+        this->flush_hits();
+}
+
+void CodeTracer::flush_hits()
+{
+    std::unique_lock<std::mutex> lock(this->bufs_mutex);
+    this->full_bufs.push_back(this->curr_buf);
+    this->full_cv.notify_one();
+    if (this->free_bufs.empty() && !this->blocking)
+    {
+        this->curr_buf = this->new_buffer();
+        return;
+    }
+    this->free_cv.wait(lock, [this]() { return !this->free_bufs.empty(); });
+    this->curr_buf = this->free_bufs.front();
+    this->free_bufs.pop_front();
+}
+
+TRACER_BUFFER *CodeTracer::new_buffer()
 {
     std::shared_ptr<Arion> arion = this->arion.lock();
     if (!arion)
         throw ExpiredWeakPtrException("Arion");
 
-    off_t mod_id = 0;
-    ADDR mapping_start = 0;
-    bool found_mapping = false;
-    for (std::unique_ptr<TRACER_MAPPING> &mapping : this->mappings)
+    std::unique_ptr<TRACER_BUFFER> buf = std::make_unique<TRACER_BUFFER>();
+    size_t max_hits = this->mode == TRACE_MODE::CTXT ? ARION_MAX_HEAVY_HITS : ARION_MAX_LIGHT_HITS;
+    buf->hits.assign(max_hits, TRACER_HIT{0, 0, 0});
+    if (this->mode == TRACE_MODE::CTXT)
+        buf->regs.assign(max_hits, *arion->arch->new_reg_file());
+    this->buffers.push_back(std::move(buf));
+    return this->buffers.back().get();
+}
+
+void CodeTracer::writer_loop()
+{
+    std::unique_lock<std::mutex> lock(this->bufs_mutex);
+    while (true)
     {
-        if (addr >= mapping->start && addr < mapping->end)
-        {
-            mapping_start = mapping->start;
-            found_mapping = true;
+        this->full_cv.wait(lock, [this]() { return !this->full_bufs.empty() || this->writer_stop; });
+        if (this->full_bufs.empty())
             break;
-        }
-        mod_id++;
+        TRACER_BUFFER *buf = this->full_bufs.front();
+        this->full_bufs.pop_front();
+        lock.unlock();
+        this->write_buffer(buf);
+        buf->count = 0;
+        lock.lock();
+        this->free_bufs.push_back(buf);
+        this->free_cv.notify_one();
     }
-    if (!found_mapping)
+}
+
+void CodeTracer::write_buffer(TRACER_BUFFER *buf)
+{
+    if (this->mode == TRACE_MODE::DRCOV)
+    {
+        this->out_f.write((char *)buf->hits.data(), buf->count * sizeof(TRACER_HIT));
         return;
+    }
+    this->chunks.push_back(TRACER_CHUNK{(off_t)this->out_f.tellp(), this->written_hits});
+    this->encode_chunk(buf);
+    this->out_f.write((char *)this->out_buf.data(), this->out_buf.size());
+    this->written_hits += buf->count;
+}
 
-    this->total_hits++;
-    std::unique_ptr<CODE_HIT> hit = std::make_unique<CODE_HIT>(addr - mapping_start, sz, mod_id);
-    if (this->mode == TRACE_MODE::CTXT)
-        hit->regs = std::move(arion->arch->dump_regs());
-    this->hits.push_back(std::move(hit));
+void CodeTracer::encode_chunk(TRACER_BUFFER *buf)
+{
+    size_t regs_count = 0, max_hit_sz = ARION_MAX_VARINT_SZ * 3;
+    std::shared_ptr<REG_FILE_LAYOUT> layout;
+    if (this->mode == TRACE_MODE::CTXT && buf->count)
+    {
+        layout = buf->regs.at(0).get_layout();
+        regs_count = layout->regs.size();
+        max_hit_sz += (regs_count + 7) / 8 + layout->data_sz;
+        this->prev_regs.assign(layout->data_sz, 0);
+    }
+    this->out_buf.resize(sizeof(TRACER_CHUNK_HEADER) + buf->count * max_hit_sz);
+    BYTE *out_ptr = this->out_buf.data() + sizeof(TRACER_CHUNK_HEADER);
 
-    size_t hits_sz = this->hits.size();
-    size_t max_hits = this->mode == TRACE_MODE::CTXT ? ARION_MAX_HEAVY_HITS : ARION_MAX_LIGHT_HITS;
-    if (hits_sz >= max_hits)
-        this->flush_hits();
+    // Every chunk starts from a zeroed state so that it can be decoded on its own
+    uint32_t prev_off = 0;
+    uint16_t prev_sz = 0, prev_mod_id = 0;
+    for (size_t hit_i = 0; hit_i < buf->count; hit_i++)
+    {
+        TRACER_HIT &hit = buf->hits[hit_i];
+        int64_t off_delta = (int64_t)hit.off - ((int64_t)prev_off + prev_sz);
+        uint64_t head = encode_zigzag(off_delta) << TRACER_HIT_FLAGS_BITS;
+        if (hit.mod_id != prev_mod_id)
+            head |= TRACER_HIT_MOD_FLAG;
+        if (hit.sz != prev_sz)
+            head |= TRACER_HIT_SZ_FLAG;
+        out_ptr += encode_varint(head, out_ptr);
+        if (head & TRACER_HIT_MOD_FLAG)
+            out_ptr += encode_varint(hit.mod_id, out_ptr);
+        if (head & TRACER_HIT_SZ_FLAG)
+            out_ptr += encode_varint(hit.sz, out_ptr);
+        prev_off = hit.off;
+        prev_sz = hit.sz;
+        prev_mod_id = hit.mod_id;
+        if (!regs_count)
+            continue;
+
+        BYTE *changed_regs = out_ptr;
+        memset(changed_regs, 0, (regs_count + 7) / 8);
+        out_ptr += (regs_count + 7) / 8;
+        void **vals = buf->regs[hit_i].get_uc_vals();
+        for (size_t reg_i = 0; reg_i < regs_count; reg_i++)
+        {
+            BYTE *prev_val = this->prev_regs.data() + layout->regs_off[reg_i];
+            uint8_t reg_sz = layout->regs_sz[reg_i];
+            if (!memcmp(vals[reg_i], prev_val, reg_sz))
+                continue;
+            changed_regs[reg_i / 8] |= 1 << (reg_i % 8);
+            memcpy(out_ptr, vals[reg_i], reg_sz);
+            memcpy(prev_val, vals[reg_i], reg_sz);
+            out_ptr += reg_sz;
+        }
+    }
+
+    TRACER_CHUNK_HEADER header = {(uint32_t)buf->count,
+                                  (uint32_t)(out_ptr - this->out_buf.data() - sizeof(TRACER_CHUNK_HEADER))};
+    memcpy(this->out_buf.data(), &header, sizeof(TRACER_CHUNK_HEADER));
+    this->out_buf.resize(out_ptr - this->out_buf.data());
 }
 
-void CodeTracer::flush_hits()
+void CodeTracer::stop_writer()
 {
-    for (std::unique_ptr<CODE_HIT> &hit : this->hits)
     {
-        this->out_f.write((char *)&hit->off, sizeof(uint32_t));
-        this->out_f.write((char *)&hit->sz, sizeof(uint16_t));
-        this->out_f.write((char *)&hit->mod_id, sizeof(uint16_t));
-        if (this->mode == TRACE_MODE::CTXT)
-            for (auto &reg : *hit->regs)
-                this->out_f.write((char *)&reg.second, sizeof(RVAL));
+        std::lock_guard<std::mutex> lock(this->bufs_mutex);
+        if (this->curr_buf->count)
+            this->full_bufs.push_back(this->curr_buf);
+        this->writer_stop = true;
     }
-    this->hits.clear();
+    this->full_cv.notify_one();
+    this->writer.join();
+
+    this->curr_buf = nullptr;
+    this->free_bufs.clear();
+    this->buffers.clear();
+    this->out_buf.clear();
+    this->out_buf.shrink_to_fit();
+    this->prev_regs.clear();
 }
 
 CodeTracer::~CodeTracer()
@@ -218,28 +366,38 @@ void CodeTracer::start(std::string out_f_path, TRACE_MODE mode)
     this->mode = mode;
     this->prepare_file();
     this->total_hits = 0;
-    this->hits.clear();
+    this->blocking = arion->config->get_field<bool>("trace_blocking");
+    size_t buffers_count = std::max<size_t>(arion->config->get_field<size_t>("trace_buffers"), 2);
+    this->curr_buf = this->new_buffer();
+    for (size_t buf_i = 1; buf_i < buffers_count; buf_i++)
+        this->free_bufs.push_back(this->new_buffer());
+    this->writer_stop = false;
+    this->chunks.clear();
+    this->written_hits = 0;
+    this->writer = std::thread(&CodeTracer::writer_loop, this);
+    this->index_mappings();
     switch (mode)
     {
     case TRACE_MODE::INSTR:
     case TRACE_MODE::CTXT:
-        this->curr_hook_id = arion->hooks->hook_code(instr_hook);
+        this->curr_hook_id = arion->hooks->hook_code_fast(instr_hook);
         break;
     case TRACE_MODE::BLOCK:
     case TRACE_MODE::DRCOV:
-        this->curr_hook_id = arion->hooks->hook_block(instr_hook);
+        this->curr_hook_id = arion->hooks->hook_block_fast(block_hook);
         break;
     case TRACE_MODE::UNKNOWN:
     default:
         throw UnknownTraceModeException();
     }
+    arion->hooks->set_hook_label(this->curr_hook_id, "CodeTracer::process_hit");
 }
 
 void CodeTracer::stop()
 {
     if (!this->enabled)
         throw TracerAlreadyDisabledException();
-    this->flush_hits();
+    this->stop_writer();
     this->enabled = false;
 
     this->release_file();
@@ -268,11 +426,13 @@ void CodeTracer::process_new_mapping(std::shared_ptr<ARION_MAPPING> mapping)
                 tr_mapping->start = mapping->start_addr;
             if (mapping->end_addr > tr_mapping->end)
                 tr_mapping->end = mapping->end_addr;
+            this->index_mappings();
             return;
         }
     }
 
     this->mappings.push_back(std::make_unique<TRACER_MAPPING>(mapping->start_addr, mapping->end_addr, mapping->info));
+    this->index_mappings();
 }
 
 bool CodeTracer::is_enabled()
@@ -1,3 +1,4 @@
+#include <algorithm>
 #include <arion/arion.hpp>
 #include <arion/common/context_manager.hpp>
 #include <arion/common/global_excepts.hpp>
@@ -13,7 +14,12 @@ std::unique_ptr<ContextManager> ContextManager::initialize(std::weak_ptr<Arion>
     return std::make_unique<ContextManager>(arion);
 }
 
-std::shared_ptr<ARION_CONTEXT> ContextManager::save()
+std::shared_ptr<ARION_CONTEXT> ContextManager::save(bool share_mem)
+{
+    return this->save_context(share_mem, true);
+}
+
+std::shared_ptr<ARION_CONTEXT> ContextManager::save_context(bool share_mem, bool save_data)
 {
     std::shared_ptr<Arion> arion = this->arion.lock();
     if (!arion)
@@ -40,9 +46,20 @@ std::shared_ptr<ARION_CONTEXT> ContextManager::save()
     {
         std::unique_ptr<ARION_MAPPING> arion_m_cpy = std::make_unique<ARION_MAPPING>(arion_m.get());
         size_t mapping_sz = arion_m_cpy->end_addr - arion_m_cpy->start_addr;
-        arion_m_cpy->saved_data = (BYTE *)malloc(mapping_sz);
-        std::vector<BYTE> mapping_data = arion->mem->read(arion_m_cpy->start_addr, mapping_sz);
-        memcpy(arion_m_cpy->saved_data, mapping_data.data(), mapping_sz);
+        if (!save_data)
+        {
+            mapping_list.push_back(std::move(arion_m_cpy));
+            continue;
+        }
+        if (share_mem && arion_m->host_ptr)
+        {
+            arion_m_cpy->host_file = arion->mem->share_mapping(arion_m);
+            mapping_list.push_back(std::move(arion_m_cpy));
+            continue;
+        }
+        // Zero pages (e.g. untouched parts of the stack, heap or anonymous mappings) are left uncommitted in the copy
+        arion_m_cpy->saved_data = (BYTE *)calloc(1, mapping_sz);
+        arion->mem->read_sparse(arion_m_cpy->start_addr, arion_m_cpy->saved_data, mapping_sz);
         mapping_list.push_back(std::move(arion_m_cpy));
     }
     std::vector<std::unique_ptr<ARION_FILE>> file_list;
@@ -126,12 +143,22 @@ void ContextManager::restore(std::shared_ptr<ARION_CONTEXT> ctx, bool restore_ma
             bool has_mapping = arion->mem->has_mapping(shared_arion_m);
             arion_m = std::make_unique<ARION_MAPPING>(*shared_arion_m);
             shared_arion_m->saved_data = nullptr;
-            if (!has_mapping)
+            if (arion_m->host_file && (restore_data || !has_mapping))
+            {
+                // Shared memory is mapped copy-on-write again rather than written
+                arion->mem->unmap(arion_m->start_addr, arion_m->end_addr);
+                arion->mem->map_file(arion_m->start_addr, mapping_sz, arion_m->perms, arion_m->host_file->fd,
+                                     arion_m->host_off, arion_m->info);
+            }
+            else if (!has_mapping)
             {
                 arion->mem->unmap(arion_m->start_addr, arion_m->end_addr);
                 arion->mem->map(arion_m->start_addr, mapping_sz, arion_m->perms, arion_m->info);
+                // The new mapping is already zeroed, only non-zero pages need to be written
+                if (restore_data && arion_m->saved_data)
+                    arion->mem->write_sparse(arion_m->start_addr, arion_m->saved_data, mapping_sz);
             }
-            if (restore_data && arion_m->saved_data)
+            else if (restore_data && arion_m->saved_data)
                 arion->mem->write(arion_m->start_addr, arion_m->saved_data, mapping_sz);
         }
         for (std::shared_ptr<ARION_MAPPING> arion_m : arion->mem->get_mappings())
@@ -155,7 +182,8 @@ void ContextManager::restore(std::shared_ptr<ARION_CONTEXT> ctx, bool restore_ma
     for (std::unique_ptr<ARION_FUTEX> &arion_f : ctx->futex_list)
         arion->threads->futex_wait(arion_f->tid, arion_f->futex_addr, arion_f->futex_bitmask);
     arion->threads->set_running_tid(ctx->running_tid);
-    arion->arch->load_regs(std::move(arion->threads->threads_map[ctx->running_tid]->regs_state));
+    arion->threads->rebuild_run_queue();
+    arion->arch->load_regs(*arion->threads->threads_map[ctx->running_tid]->regs_state);
     arion->arch->load_tls(std::move(arion->threads->threads_map[ctx->running_tid]->tls_addr));
 }
 
@@ -167,22 +195,88 @@ void ContextManager::restore(std::shared_ptr<ARION_CONTEXT> ctx, std::vector<std
 
     this->restore(ctx, true, false);
 
+    // Saved mappings are sorted by start address, the first one overlapping each edit can be found by binary search
+    auto mapping_end_cmp = [](ADDR addr, const std::unique_ptr<ARION_MAPPING> &mapping) {
+        return addr < mapping->end_addr;
+    };
     for (std::shared_ptr<ARION_MEM_EDIT> edit : edits)
     {
-        for (std::unique_ptr<ARION_MAPPING> &mapping : ctx->mapping_list)
+        ADDR edit_end = edit->addr + edit->sz;
+        auto mapping_it =
+            std::upper_bound(ctx->mapping_list.begin(), ctx->mapping_list.end(), edit->addr, mapping_end_cmp);
+        for (; mapping_it != ctx->mapping_list.end() && (*mapping_it)->start_addr < edit_end; mapping_it++)
         {
-            if ((edit->addr < mapping->end_addr) && (mapping->start_addr < edit->addr + edit->sz))
-            {
-                ADDR start_addr = std::max(edit->addr, mapping->start_addr);
-                ADDR end_addr = std::min(edit->addr + edit->sz, mapping->end_addr);
+            std::unique_ptr<ARION_MAPPING> &mapping = *mapping_it;
+            ADDR start_addr = std::max(edit->addr, mapping->start_addr);
+            ADDR end_addr = std::min(edit_end, mapping->end_addr);
+            if (mapping->saved_data)
                 arion->mem->write(start_addr, mapping->saved_data + start_addr - mapping->start_addr,
                                   end_addr - start_addr);
-                break;
+            else if (mapping->host_file)
+            {
+                std::vector<BYTE> data(end_addr - start_addr);
+                ssize_t read_sz = pread(mapping->host_file->fd, data.data(), data.size(),
+                                        mapping->host_off + start_addr - mapping->start_addr);
+                if (read_sz > 0)
+                    arion->mem->write(start_addr, data.data(), read_sz);
             }
         }
     }
 }
 
+std::shared_ptr<ARION_CONTEXT> ContextManager::save_snapshot()
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    // Unicorn engine would keep referencing host buffers that Arion frees when unmapping
+    for (std::shared_ptr<ARION_MAPPING> &arion_m : arion->mem->get_mappings())
+    {
+        if (arion_m->host_ptr)
+            arion->mem->detach_host_mem(arion_m);
+    }
+    std::shared_ptr<ARION_CONTEXT> ctx = this->save_context(false, false);
+
+    uc_err uc_ctx_err = uc_context_alloc(arion->uc, &ctx->uc_snapshot);
+    if (uc_ctx_err != UC_ERR_OK)
+        throw UnicornContextException(uc_ctx_err);
+    // Registers are saved by Arion, the Unicorn context only holds memory
+    uc_err uc_ctl_err = uc_ctl_context_mode(arion->uc, UC_CTL_CONTEXT_MEMORY);
+    if (uc_ctl_err != UC_ERR_OK)
+        throw UnicornCtlException(uc_ctl_err);
+    uc_ctx_err = uc_context_save(arion->uc, ctx->uc_snapshot);
+    uc_ctl_err = uc_ctl_context_mode(arion->uc, UC_CTL_CONTEXT_CPU);
+    if (uc_ctx_err != UC_ERR_OK)
+        throw UnicornContextException(uc_ctx_err);
+    if (uc_ctl_err != UC_ERR_OK)
+        throw UnicornCtlException(uc_ctl_err);
+    return ctx;
+}
+
+void ContextManager::restore_snapshot(std::shared_ptr<ARION_CONTEXT> ctx)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!ctx->uc_snapshot)
+        throw UnicornContextException(UC_ERR_ARG);
+    uc_err uc_ctl_err = uc_ctl_context_mode(arion->uc, UC_CTL_CONTEXT_MEMORY);
+    if (uc_ctl_err != UC_ERR_OK)
+        throw UnicornCtlException(uc_ctl_err);
+    uc_err uc_ctx_err = uc_context_restore(arion->uc, ctx->uc_snapshot);
+    uc_ctl_err = uc_ctl_context_mode(arion->uc, UC_CTL_CONTEXT_CPU);
+    if (uc_ctx_err != UC_ERR_OK)
+        throw UnicornContextException(uc_ctx_err);
+    if (uc_ctl_err != UC_ERR_OK)
+        throw UnicornCtlException(uc_ctl_err);
+
+    // Unicorn engine already restored the memory layout, Arion only needs to track it again
+    arion->mem->reset_mappings(ctx->mapping_list);
+    this->restore(ctx, false, false);
+}
+
 void ContextManager::save_to_file(std::string file_path)
 {
     std::ofstream out_f(file_path, std::ios::binary);
@@ -3,6 +3,7 @@
 #include <arion/common/global_excepts.hpp>
 #include <arion/common/hooks_manager.hpp>
 #include <arion/unicorn/unicorn.h>
+#include <algorithm>
 #include <exception>
 #include <memory>
 
@@ -49,9 +50,20 @@ std::map<ARION_HOOK_TYPE, void *> arion::ARION_UC_HOOK_FUNCS{
     {ARION_HOOK_TYPE::TCG_OPCODE_HOOK, (void *)arion_tcg_opcode_hook},
     {ARION_HOOK_TYPE::TLB_FILL_HOOK, (void *)arion_tlb_fill_hook}};
 
+std::map<ARION_HOOK_TYPE, void *> arion::ARION_UC_FAST_HOOK_FUNCS{
+    {ARION_HOOK_TYPE::CODE_HOOK, (void *)arion_fast_code_hook},
+    {ARION_HOOK_TYPE::BLOCK_HOOK, (void *)arion_fast_code_hook},
+    {ARION_HOOK_TYPE::MEM_READ_HOOK, (void *)arion_fast_mem_hook},
+    {ARION_HOOK_TYPE::MEM_WRITE_HOOK, (void *)arion_fast_mem_hook},
+    {ARION_HOOK_TYPE::MEM_FETCH_HOOK, (void *)arion_fast_mem_hook},
+    {ARION_HOOK_TYPE::MEM_READ_AFTER_HOOK, (void *)arion_fast_mem_hook},
+    {ARION_HOOK_TYPE::EDGE_GENERATED_HOOK, (void *)arion_fast_edge_generated_hook},
+    {ARION_HOOK_TYPE::TCG_OPCODE_HOOK, (void *)arion_fast_tcg_opcode_hook}};
+
 void arion::arion_intr_hook(uc_engine *uc, uint32_t intno, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     U32_HOOK_CALLBACK arion_callback = std::get<U32_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -70,6 +82,7 @@ void arion::arion_intr_hook(uc_engine *uc, uint32_t intno, void *user_data)
 void arion::arion_insn_hook(uc_engine *uc, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     NO_PARAM_HOOK_CALLBACK arion_callback = std::get<NO_PARAM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -88,6 +101,7 @@ void arion::arion_insn_hook(uc_engine *uc, void *user_data)
 void arion::arion_code_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     ADDR_SZ_HOOK_CALLBACK arion_callback = std::get<ADDR_SZ_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -106,6 +120,7 @@ void arion::arion_code_hook(uc_engine *uc, uint64_t address, uint32_t size, void
 void arion::arion_block_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     ADDR_SZ_HOOK_CALLBACK arion_callback = std::get<ADDR_SZ_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -125,6 +140,7 @@ bool arion::arion_mem_read_unmapped_hook(uc_engine *uc, uc_mem_type access, uint
                                          void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -145,6 +161,7 @@ bool arion::arion_mem_write_unmapped_hook(uc_engine *uc, uc_mem_type access, uin
                                           void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -165,6 +182,7 @@ bool arion::arion_mem_fetch_unmapped_hook(uc_engine *uc, uc_mem_type access, uin
                                           void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -185,6 +203,7 @@ bool arion::arion_mem_read_prot_hook(uc_engine *uc, uc_mem_type access, uint64_t
                                      void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -205,6 +224,7 @@ bool arion::arion_mem_write_prot_hook(uc_engine *uc, uc_mem_type access, uint64_
                                       void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -225,6 +245,7 @@ bool arion::arion_mem_fetch_prot_hook(uc_engine *uc, uc_mem_type access, uint64_
                                       void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -245,6 +266,7 @@ bool arion::arion_mem_read_hook(uc_engine *uc, uc_mem_type access, uint64_t addr
                                 void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -265,6 +287,7 @@ bool arion::arion_mem_write_hook(uc_engine *uc, uc_mem_type access, uint64_t add
                                  void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -285,6 +308,7 @@ bool arion::arion_mem_fetch_hook(uc_engine *uc, uc_mem_type access, uint64_t add
                                  void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -305,6 +329,7 @@ bool arion::arion_mem_read_after_hook(uc_engine *uc, uc_mem_type access, uint64_
                                       void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -324,6 +349,7 @@ bool arion::arion_mem_read_after_hook(uc_engine *uc, uc_mem_type access, uint64_
 bool arion::arion_insn_invalid_hook(uc_engine *uc, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     NO_PARAM_BOOL_HOOK_CALLBACK arion_callback = std::get<NO_PARAM_BOOL_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -343,6 +369,7 @@ bool arion::arion_insn_invalid_hook(uc_engine *uc, void *user_data)
 void arion::arion_edge_generated_hook(uc_engine *uc, uc_tb *cur, uc_tb *prev, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     EDGE_HOOK_CALLBACK arion_callback = std::get<EDGE_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -354,6 +381,7 @@ void arion::arion_edge_generated_hook(uc_engine *uc, uc_tb *cur, uc_tb *prev, vo
 void arion::arion_tcg_opcode_hook(uc_engine *uc, uint64_t addr, uint64_t arg1, uint64_t arg2, int size, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     TCG_HOOK_CALLBACK arion_callback = std::get<TCG_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -372,6 +400,7 @@ void arion::arion_tcg_opcode_hook(uc_engine *uc, uint64_t addr, uint64_t arg1, u
 bool arion::arion_tlb_fill_hook(uc_engine *uc, uint64_t addr, uc_mem_type type, uc_tlb_entry *result, void *user_data)
 {
     ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
     TLB_HOOK_CALLBACK arion_callback = std::get<TLB_HOOK_CALLBACK>(hook_param->callback);
     std::shared_ptr<Arion> arion = hook_param->arion.lock();
     if (!arion)
@@ -388,6 +417,166 @@ bool arion::arion_tlb_fill_hook(uc_engine *uc, uint64_t addr, uc_mem_type type,
     return false;
 }
 
+void arion::arion_addr_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data)
+{
+    HooksManager *hooks = static_cast<HooksManager *>(user_data);
+    hooks->dispatch_addr_hooks(address, size);
+}
+
+bool arion::arion_filtered_mem_hook(uc_engine *uc, uc_mem_type access, uint64_t addr, int size, int64_t val,
+                                    void *user_data)
+{
+    ARION_HOOK_PARAM *hook_param = static_cast<ARION_HOOK_PARAM *>(user_data);
+    ARION_HOOK_FILTER_STATE *filter_state = hook_param->filter_state.get();
+    const ARION_MEM_HOOK_FILTER &filter = filter_state->filter;
+    if (!(size & filter.sizes) || (uint64_t)val < filter.val_min || (uint64_t)val > filter.val_max)
+        return false;
+    if (filter.pc_start || filter.pc_end != ARION_MAX_U64)
+    {
+        uint64_t pc = 0;
+        uc_reg_read(uc, filter_state->pc_reg, &pc);
+        if (pc < filter.pc_start || pc > filter.pc_end)
+            return false;
+    }
+    if (filter.budget && filter_state->hits >= filter.budget)
+        return false;
+    ARION_PROFILE_HOOK(hook_param->counters);
+    bool exhausted = filter.budget && ++filter_state->hits == filter.budget;
+
+    std::shared_ptr<Arion> arion = hook_param->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    try
+    {
+        if (!exhausted)
+            return std::get<MEM_HOOK_CALLBACK>(hook_param->callback)(arion, access, addr, size, val,
+                                                                     hook_param->user_data);
+        // Unhooking deletes the hook parameters, which must be copied first
+        MEM_HOOK_CALLBACK arion_callback = std::get<MEM_HOOK_CALLBACK>(hook_param->callback);
+        void *hook_user_data = hook_param->user_data;
+        filter_state->hooks->retire_hook(filter_state->hook_id);
+        return arion_callback(arion, access, addr, size, val, hook_user_data);
+    }
+    catch (...)
+    {
+        arion->crash(std::current_exception());
+    }
+    return false;
+}
+
+void arion::arion_flush_mem_trace(ARION_MEM_TRACE *mem_trace)
+{
+    if (!mem_trace->count)
+        return;
+    size_t count = mem_trace->count;
+    mem_trace->count = 0;
+    std::shared_ptr<Arion> arion = mem_trace->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    try
+    {
+        mem_trace->callback(arion, mem_trace->accesses.data(), count, mem_trace->user_data);
+    }
+    catch (...)
+    {
+        arion->crash(std::current_exception());
+    }
+}
+
+bool arion::arion_mem_trace_hook(uc_engine *uc, uc_mem_type access, uint64_t addr, int size, int64_t val,
+                                 void *user_data)
+{
+    ARION_MEM_TRACE *mem_trace = static_cast<ARION_MEM_TRACE *>(user_data);
+    ARION_PROFILE_HOOK(mem_trace->counters);
+    ARION_MEM_ACCESS &mem_access = mem_trace->accesses[mem_trace->count];
+    mem_access.pc = 0;
+    uc_reg_read(uc, mem_trace->pc_reg, &mem_access.pc);
+    mem_access.addr = addr;
+    mem_access.val = val;
+    mem_access.size = size;
+    mem_access.type = access;
+    if (++mem_trace->count == mem_trace->accesses.size())
+        arion_flush_mem_trace(mem_trace);
+    return false;
+}
+
+void arion::arion_mem_trace_block_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data)
+{
+    ARION_MEM_TRACE *mem_trace = static_cast<ARION_MEM_TRACE *>(user_data);
+    ARION_PROFILE_HOOK(mem_trace->counters);
+    if (mem_trace->count)
+        arion_flush_mem_trace(mem_trace);
+}
+
+void arion::arion_fast_code_hook(uc_engine *uc, uint64_t address, uint32_t size, void *user_data)
+{
+    ARION_FAST_HOOK_PARAM *hook_param = static_cast<ARION_FAST_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
+    FAST_ADDR_SZ_HOOK_CALLBACK arion_callback = reinterpret_cast<FAST_ADDR_SZ_HOOK_CALLBACK>(hook_param->callback);
+
+    try
+    {
+        arion_callback(hook_param->arion, address, size, hook_param->user_data);
+    }
+    catch (...)
+    {
+        hook_param->arion.crash(std::current_exception());
+    }
+}
+
+bool arion::arion_fast_mem_hook(uc_engine *uc, uc_mem_type access, uint64_t addr, int size, int64_t val,
+                                void *user_data)
+{
+    ARION_FAST_HOOK_PARAM *hook_param = static_cast<ARION_FAST_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
+    FAST_MEM_HOOK_CALLBACK arion_callback = reinterpret_cast<FAST_MEM_HOOK_CALLBACK>(hook_param->callback);
+
+    try
+    {
+        return arion_callback(hook_param->arion, access, addr, size, val, hook_param->user_data);
+    }
+    catch (...)
+    {
+        hook_param->arion.crash(std::current_exception());
+    }
+    return false;
+}
+
+void arion::arion_fast_edge_generated_hook(uc_engine *uc, uc_tb *cur, uc_tb *prev, void *user_data)
+{
+    ARION_FAST_HOOK_PARAM *hook_param = static_cast<ARION_FAST_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
+    FAST_EDGE_HOOK_CALLBACK arion_callback = reinterpret_cast<FAST_EDGE_HOOK_CALLBACK>(hook_param->callback);
+
+    try
+    {
+        arion_callback(hook_param->arion, cur, prev, hook_param->user_data);
+    }
+    catch (...)
+    {
+        hook_param->arion.crash(std::current_exception());
+    }
+}
+
+void arion::arion_fast_tcg_opcode_hook(uc_engine *uc, uint64_t addr, uint64_t arg1, uint64_t arg2, int size,
+                                       void *user_data)
+{
+    ARION_FAST_HOOK_PARAM *hook_param = static_cast<ARION_FAST_HOOK_PARAM *>(user_data);
+    ARION_PROFILE_HOOK(hook_param->counters);
+    FAST_TCG_HOOK_CALLBACK arion_callback = reinterpret_cast<FAST_TCG_HOOK_CALLBACK>(hook_param->callback);
+
+    try
+    {
+        arion_callback(hook_param->arion, addr, arg1, arg2, size, hook_param->user_data);
+    }
+    catch (...)
+    {
+        hook_param->arion.crash(std::current_exception());
+    }
+}
+
 std::unique_ptr<HooksManager> HooksManager::initialize(std::weak_ptr<Arion> arion)
 {
     return std::move(std::make_unique<HooksManager>(arion));
@@ -400,6 +589,7 @@ HooksManager::HooksManager(std::weak_ptr<Arion> arion) : arion(arion)
     if (!arion_)
         throw ExpiredWeakPtrException("Arion");
     this->uc = arion_->uc;
+    this->arion_ref = arion_.get();
 }
 
 HooksManager::~HooksManager()
@@ -444,6 +634,29 @@ HOOK_ID HooksManager::hook_uc(ARION_HOOK_TYPE type, HOOK_CALLBACK callback, void
     return hook_id;
 }
 
+template <typename... UcParams>
+HOOK_ID HooksManager::hook_uc_fast(ARION_HOOK_TYPE type, void *callback, void *user_data, ADDR start, ADDR end,
+                                   UcParams... uc_params)
+{
+    uc_hook_type uc_type = ARION_UC_HOOK_TYPES.at(type);
+    void *arion_hook_func = ARION_UC_FAST_HOOK_FUNCS.at(type);
+    uc_hook uc_id;
+
+    struct ARION_FAST_HOOK_PARAM *param = new ARION_FAST_HOOK_PARAM(*this->arion_ref, callback, user_data);
+
+    uc_err uc_add_err = uc_hook_add(this->uc, &uc_id, uc_type, arion_hook_func, param, start, end, uc_params...);
+    if (uc_add_err != UC_ERR_OK)
+    {
+        delete param;
+        throw UnicornHookAddException(uc_add_err);
+    }
+
+    std::shared_ptr<ARION_HOOK> arion_hook = std::make_shared<ARION_HOOK>(type, uc_id, param);
+    HOOK_ID hook_id = this->gen_next_id();
+    this->hooks[hook_id] = arion_hook;
+    return hook_id;
+}
+
 HOOK_ID HooksManager::hook_intr(U32_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
 {
     return this->hook_uc(ARION_HOOK_TYPE::INTR_HOOK, callback, user_data, start, end);
@@ -459,9 +672,121 @@ HOOK_ID HooksManager::hook_code(ADDR_SZ_HOOK_CALLBACK callback, ADDR start, ADDR
     return this->hook_uc(ARION_HOOK_TYPE::CODE_HOOK, callback, user_data, start, end);
 }
 
+void HooksManager::bind_addr_hook_group(ARION_ADDR_HOOK_GROUP &group, ADDR start, ADDR end)
+{
+    uc_hook uc_id;
+    uc_err uc_add_err = uc_hook_add(this->uc, &uc_id, UC_HOOK_CODE, (void *)arion_addr_hook, this, start, end);
+    if (uc_add_err != UC_ERR_OK)
+        throw UnicornHookAddException(uc_add_err);
+
+    if (group.uc_id)
+    {
+        uc_err uc_del_err = uc_hook_del(this->uc, group.uc_id);
+        if (uc_del_err != UC_ERR_OK)
+        {
+            uc_hook_del(this->uc, uc_id);
+            throw UnicornHookDelException(uc_del_err);
+        }
+    }
+    group.uc_id = uc_id;
+    group.start = start;
+    group.end = end;
+}
+
+void HooksManager::add_addr_hook(ADDR addr, std::shared_ptr<ARION_HOOK> arion_hook)
+{
+    ADDR group_addr = addr & ~((ADDR)ARION_ADDR_HOOK_GROUP_SZ - 1);
+    ARION_ADDR_HOOK_GROUP &group = this->addr_hook_groups[group_addr];
+    if (!group.hooks_count)
+    {
+        try
+        {
+            this->bind_addr_hook_group(group, addr, addr);
+        }
+        catch (...)
+        {
+            this->addr_hook_groups.erase(group_addr);
+            throw;
+        }
+    }
+    else if (addr < group.start || addr > group.end)
+        this->bind_addr_hook_group(group, std::min(group.start, addr), std::max(group.end, addr));
+    group.hooks_count++;
+    this->addr_hooks[addr].push_back(arion_hook);
+}
+
+void HooksManager::remove_addr_hook(ADDR addr, std::shared_ptr<ARION_HOOK> arion_hook)
+{
+    auto addr_it = this->addr_hooks.find(addr);
+    if (addr_it != this->addr_hooks.end())
+    {
+        std::vector<std::shared_ptr<ARION_HOOK>> &hooks_list = addr_it->second;
+        hooks_list.erase(std::remove(hooks_list.begin(), hooks_list.end(), arion_hook), hooks_list.end());
+        if (hooks_list.empty())
+            this->addr_hooks.erase(addr_it);
+    }
+
+    ADDR group_addr = addr & ~((ADDR)ARION_ADDR_HOOK_GROUP_SZ - 1);
+    auto group_it = this->addr_hook_groups.find(group_addr);
+    if (group_it == this->addr_hook_groups.end())
+        return;
+    if (--group_it->second.hooks_count)
+        return; // Group range is kept as is, extra addresses only cost a lookup
+    uc_err uc_del_err = uc_hook_del(this->uc, group_it->second.uc_id);
+    this->addr_hook_groups.erase(group_it);
+    if (uc_del_err != UC_ERR_OK)
+        throw UnicornHookDelException(uc_del_err);
+}
+
+void HooksManager::dispatch_addr_hooks(ADDR addr, size_t sz)
+{
+    auto addr_it = this->addr_hooks.find(addr);
+    if (addr_it == this->addr_hooks.end())
+        return;
+
+    // Hooks removed by the callbacks are only swept once the triggers are done, so the list is iterated in place
+    try
+    {
+        this->trigger_hooks_list(addr_it->second, addr, sz);
+    }
+    catch (...)
+    {
+        std::shared_ptr<Arion> arion = this->arion.lock();
+        if (!arion)
+            throw ExpiredWeakPtrException("Arion");
+        arion->crash(std::current_exception());
+    }
+}
+
 HOOK_ID HooksManager::hook_addr(ADDR_SZ_HOOK_CALLBACK callback, arion::ADDR addr, void *user_data)
 {
-    return this->hook_code(callback, addr, addr, user_data);
+    struct ARION_HOOK_PARAM *param = new ARION_HOOK_PARAM(this->arion, callback, user_data);
+    std::shared_ptr<ARION_HOOK> arion_hook = std::make_shared<ARION_HOOK>(ARION_HOOK_TYPE::ADDR_HOOK, 0, param);
+    arion_hook->addr = addr;
+    try
+    {
+        this->add_addr_hook(addr, arion_hook);
+    }
+    catch (...)
+    {
+        delete param;
+        throw;
+    }
+
+    // The ID is only generated once the hook is registered, so that it can't be lost
+    HOOK_ID hook_id;
+    try
+    {
+        hook_id = this->gen_next_id();
+    }
+    catch (...)
+    {
+        this->remove_addr_hook(addr, arion_hook);
+        delete param;
+        throw;
+    }
+    this->hooks[hook_id] = arion_hook;
+    return hook_id;
 }
 
 HOOK_ID HooksManager::hook_block(ADDR_SZ_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
@@ -540,15 +865,182 @@ HOOK_ID HooksManager::hook_tlb_fill(TLB_HOOK_CALLBACK callback, ADDR start, ADDR
     return this->hook_uc(ARION_HOOK_TYPE::TLB_FILL_HOOK, callback, user_data, start, end);
 }
 
+HOOK_ID HooksManager::hook_uc_filtered(ARION_HOOK_TYPE type, MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter,
+                                       void *user_data, ADDR start, ADDR end)
+{
+    uc_hook_type uc_type = ARION_UC_HOOK_TYPES.at(type);
+    uc_hook uc_id;
+
+    struct ARION_HOOK_PARAM *param = new ARION_HOOK_PARAM(this->arion, callback, user_data);
+    REG pc_reg = this->arion_ref->arch->get_attrs()->regs.pc;
+    param->filter_state = std::make_unique<ARION_HOOK_FILTER_STATE>(filter, pc_reg, this);
+
+    uc_err uc_add_err = uc_hook_add(this->uc, &uc_id, uc_type, (void *)arion_filtered_mem_hook, param, start, end);
+    if (uc_add_err != UC_ERR_OK)
+    {
+        delete param;
+        throw UnicornHookAddException(uc_add_err);
+    }
+
+    std::shared_ptr<ARION_HOOK> arion_hook = std::make_shared<ARION_HOOK>(type, uc_id, param);
+    HOOK_ID hook_id = this->gen_next_id();
+    param->filter_state->hook_id = hook_id;
+    this->hooks[hook_id] = arion_hook;
+    return hook_id;
+}
+
+HOOK_ID HooksManager::hook_mem_read_filtered(MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter, ADDR start,
+                                             ADDR end, void *user_data)
+{
+    // Unicorn passes a null value to read hooks, so a value filter could never be evaluated
+    if (filter.val_min || filter.val_max != ARION_MAX_U64)
+        throw WrongHookParamsException();
+    return this->hook_uc_filtered(ARION_HOOK_TYPE::MEM_READ_HOOK, callback, filter, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_mem_write_filtered(MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter, ADDR start,
+                                              ADDR end, void *user_data)
+{
+    return this->hook_uc_filtered(ARION_HOOK_TYPE::MEM_WRITE_HOOK, callback, filter, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_mem_read_after_filtered(MEM_HOOK_CALLBACK callback, ARION_MEM_HOOK_FILTER filter,
+                                                   ADDR start, ADDR end, void *user_data)
+{
+    return this->hook_uc_filtered(ARION_HOOK_TYPE::MEM_READ_AFTER_HOOK, callback, filter, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_mem_trace(MEM_TRACE_HOOK_CALLBACK callback, int types, size_t capacity, bool flush_on_block,
+                                     ADDR start, ADDR end, void *user_data)
+{
+    if (!capacity || !(types & (UC_HOOK_MEM_READ | UC_HOOK_MEM_WRITE | UC_HOOK_MEM_FETCH | UC_HOOK_MEM_READ_AFTER)))
+        throw WrongHookParamsException();
+
+    REG pc_reg = this->arion_ref->arch->get_attrs()->regs.pc;
+    ARION_MEM_TRACE *mem_trace = new ARION_MEM_TRACE(this->arion, pc_reg, capacity, callback, user_data);
+    uc_hook uc_id;
+    uc_err uc_add_err = uc_hook_add(this->uc, &uc_id, types, (void *)arion_mem_trace_hook, mem_trace, start, end);
+    if (uc_add_err != UC_ERR_OK)
+    {
+        delete mem_trace;
+        throw UnicornHookAddException(uc_add_err);
+    }
+    if (flush_on_block)
+    {
+        uc_add_err = uc_hook_add(this->uc, &mem_trace->block_uc_id, UC_HOOK_BLOCK, (void *)arion_mem_trace_block_hook,
+                                 mem_trace, 1, 0);
+        if (uc_add_err != UC_ERR_OK)
+        {
+            uc_hook_del(this->uc, uc_id);
+            delete mem_trace;
+            throw UnicornHookAddException(uc_add_err);
+        }
+    }
+
+    std::shared_ptr<ARION_HOOK> arion_hook =
+        std::make_shared<ARION_HOOK>(ARION_HOOK_TYPE::MEM_TRACE_HOOK, uc_id, (ARION_HOOK_PARAM *)nullptr);
+    arion_hook->mem_trace = mem_trace;
+    HOOK_ID hook_id = this->gen_next_id();
+    this->hooks[hook_id] = arion_hook;
+    this->mem_trace_hooks.push_back(arion_hook);
+    return hook_id;
+}
+
+void HooksManager::flush_mem_traces()
+{
+    for (std::shared_ptr<ARION_HOOK> &arion_hook : this->mem_trace_hooks)
+    {
+        ARION_PROFILE_HOOK(arion_hook->mem_trace->counters);
+        arion_flush_mem_trace(arion_hook->mem_trace);
+    }
+}
+
+HOOK_ID HooksManager::hook_code_fast(FAST_ADDR_SZ_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::CODE_HOOK, (void *)callback, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_block_fast(FAST_ADDR_SZ_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::BLOCK_HOOK, (void *)callback, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_mem_read_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::MEM_READ_HOOK, (void *)callback, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_mem_write_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::MEM_WRITE_HOOK, (void *)callback, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_mem_fetch_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::MEM_FETCH_HOOK, (void *)callback, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_mem_read_after_fast(FAST_MEM_HOOK_CALLBACK callback, ADDR start, ADDR end, void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::MEM_READ_AFTER_HOOK, (void *)callback, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_edge_generated_fast(FAST_EDGE_HOOK_CALLBACK callback, ADDR start, ADDR end,
+                                               void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::EDGE_GENERATED_HOOK, (void *)callback, user_data, start, end);
+}
+
+HOOK_ID HooksManager::hook_tcg_opcode_fast(FAST_TCG_HOOK_CALLBACK callback, uint64_t aux1, uint64_t aux2, ADDR start,
+                                           ADDR end, void *user_data)
+{
+    return this->hook_uc_fast(ARION_HOOK_TYPE::TCG_OPCODE_HOOK, (void *)callback, user_data, start, end, aux1, aux2);
+}
+
 HOOK_ID HooksManager::hook_arion(ARION_HOOK_TYPE type, HOOK_CALLBACK callback, void *user_data)
 {
     struct ARION_HOOK_PARAM *param = new ARION_HOOK_PARAM(this->arion, callback, user_data);
     std::shared_ptr<ARION_HOOK> arion_hook = std::make_shared<ARION_HOOK>(type, 0, param);
     HOOK_ID hook_id = this->gen_next_id();
     this->hooks[hook_id] = arion_hook;
+    this->arion_hooks[type].push_back(arion_hook);
     return hook_id;
 }
 
+void HooksManager::remove_arion_hook(std::shared_ptr<ARION_HOOK> arion_hook)
+{
+    if (arion_hook->type == ARION_HOOK_TYPE::ADDR_HOOK)
+    {
+        this->remove_addr_hook(arion_hook->addr, arion_hook);
+        return;
+    }
+    std::vector<std::shared_ptr<ARION_HOOK>> *hooks_list;
+    if (arion_hook->type == ARION_HOOK_TYPE::SYSCALL_HOOK && arion_hook->sysno != ARION_MAX_U64)
+        hooks_list = &this->sysno_hooks[arion_hook->sysno];
+    else
+        hooks_list = &this->arion_hooks[arion_hook->type];
+    hooks_list->erase(std::remove(hooks_list->begin(), hooks_list->end(), arion_hook), hooks_list->end());
+    if (!hooks_list->empty())
+        return;
+    if (arion_hook->type == ARION_HOOK_TYPE::SYSCALL_HOOK && arion_hook->sysno != ARION_MAX_U64)
+        this->sysno_hooks.erase(arion_hook->sysno);
+    else
+        this->arion_hooks.erase(arion_hook->type);
+}
+
+void HooksManager::sweep_deleted_hooks()
+{
+    if (this->triggers_depth)
+        return;
+    for (std::shared_ptr<ARION_HOOK> &arion_hook : this->deleted_hooks)
+    {
+        this->remove_arion_hook(arion_hook);
+        delete arion_hook->param;
+        arion_hook->param = nullptr;
+    }
+    this->deleted_hooks.clear();
+}
+
 HOOK_ID HooksManager::hook_fork(PROCESS_HOOK_CALLBACK callback, void *user_data)
 {
     return this->hook_arion(ARION_HOOK_TYPE::FORK_HOOK, callback, user_data);
@@ -564,7 +1056,89 @@ HOOK_ID HooksManager::hook_syscall(SYSCALL_HOOK_CALLBACK callback, void *user_da
     return this->hook_arion(ARION_HOOK_TYPE::SYSCALL_HOOK, callback, user_data);
 }
 
+HOOK_ID HooksManager::hook_sysno(SYSCALL_HOOK_CALLBACK callback, uint64_t sysno, void *user_data)
+{
+    struct ARION_HOOK_PARAM *param = new ARION_HOOK_PARAM(this->arion, callback, user_data);
+    std::shared_ptr<ARION_HOOK> arion_hook = std::make_shared<ARION_HOOK>(ARION_HOOK_TYPE::SYSCALL_HOOK, 0, param);
+    arion_hook->sysno = sysno;
+    HOOK_ID hook_id = this->gen_next_id();
+    this->hooks[hook_id] = arion_hook;
+    this->sysno_hooks[sysno].push_back(arion_hook);
+    return hook_id;
+}
+
+void HooksManager::trigger_syscall_hook(uint64_t sysno, std::vector<SYS_PARAM> &params, bool *handled)
+{
+    this->trigger_arion_hook(ARION_HOOK_TYPE::SYSCALL_HOOK, sysno, params, handled);
+    auto hooks_it = this->sysno_hooks.find(sysno);
+    if (hooks_it != this->sysno_hooks.end())
+        this->trigger_hooks_list(hooks_it->second, sysno, params, handled);
+}
+
+void HooksManager::set_hook_label(HOOK_ID hook_id, std::string label)
+{
+    auto hook_it = this->hooks.find(hook_id);
+    if (hook_it == this->hooks.end())
+        throw WrongHookIdException();
+    hook_it->second->label = label;
+}
+
+bool HooksManager::is_profiling_enabled()
+{
+#ifdef ARION_HOOK_PROFILING
+    return true;
+#else
+    return false;
+#endif
+}
+
+static ARION_HOOK_COUNTERS *get_hook_counters(std::shared_ptr<ARION_HOOK> arion_hook)
+{
+    if (arion_hook->param)
+        return arion_hook->param->counters.get();
+    if (arion_hook->fast_param)
+        return arion_hook->fast_param->counters.get();
+    if (arion_hook->mem_trace)
+        return arion_hook->mem_trace->counters.get();
+    return nullptr;
+}
+
+std::map<HOOK_ID, ARION_HOOK_STATS> HooksManager::get_stats()
+{
+    std::map<HOOK_ID, ARION_HOOK_STATS> stats;
+    for (auto &hook_pair : this->hooks)
+    {
+        ARION_HOOK_STATS &hook_stats = stats[hook_pair.first];
+        hook_stats.type = hook_pair.second->type;
+        hook_stats.label = hook_pair.second->label;
+        ARION_HOOK_COUNTERS *counters = get_hook_counters(hook_pair.second);
+        if (counters)
+            hook_stats.counters = *counters;
+    }
+    return stats;
+}
+
+void HooksManager::reset_stats()
+{
+    for (auto &hook_pair : this->hooks)
+    {
+        ARION_HOOK_COUNTERS *counters = get_hook_counters(hook_pair.second);
+        if (counters)
+            *counters = ARION_HOOK_COUNTERS();
+    }
+}
+
 void HooksManager::unhook(HOOK_ID hook_id)
+{
+    this->remove_hook(hook_id, true);
+}
+
+void HooksManager::retire_hook(HOOK_ID hook_id)
+{
+    this->remove_hook(hook_id, false);
+}
+
+void HooksManager::remove_hook(HOOK_ID hook_id, bool reuse_id)
 {
     if (this->hooks.find(hook_id) == this->hooks.end())
         throw WrongHookIdException();
@@ -576,10 +1150,39 @@ void HooksManager::unhook(HOOK_ID hook_id)
         if (uc_del_err != UC_ERR_OK)
             throw UnicornHookDelException(uc_del_err);
     }
+    else if (this->triggers_depth)
+    {
+        // The hook may be the one being called, so it is only removed once the triggers are done
+        arion_hook->to_delete = true;
+        this->deleted_hooks.push_back(arion_hook);
+    }
+    else
+        this->remove_arion_hook(arion_hook);
+
+    if (arion_hook->mem_trace)
+    {
+        if (arion_hook->mem_trace->block_uc_id)
+            uc_hook_del(this->uc, arion_hook->mem_trace->block_uc_id);
+        if (!this->arion.expired())
+            arion_flush_mem_trace(arion_hook->mem_trace);
+        this->mem_trace_hooks.erase(
+            std::remove(this->mem_trace_hooks.begin(), this->mem_trace_hooks.end(), arion_hook),
+            this->mem_trace_hooks.end());
+        delete arion_hook->mem_trace;
+        arion_hook->mem_trace = nullptr;
+    }
 
-    delete arion_hook->param;
+    if (!arion_hook->to_delete)
+    {
+        delete arion_hook->param;
+        arion_hook->param = nullptr;
+    }
+    delete arion_hook->fast_param;
+    arion_hook->fast_param = nullptr;
     this->hooks.erase(hook_id);
-    if (this->hooks.size())
+    if (!reuse_id)
+        this->retired_hook_ids = true;
+    else if (this->hooks.size() || this->retired_hook_ids)
         this->free_hook_ids.push(hook_id);
     else
     {
@@ -7,10 +7,14 @@
 #include <arion/unicorn/unicorn.h>
 #include <arion/utils/convert_utils.hpp>
 #include <cstdint>
+#include <cstring>
+#include <fcntl.h>
 #include <iomanip>
 #include <iostream>
 #include <iterator>
 #include <memory>
+#include <sys/mman.h>
+#include <sys/stat.h>
 #include <unistd.h>
 
 using namespace arion;
@@ -63,35 +67,13 @@ std::unique_ptr<MemoryRecorder> MemoryRecorder::initialize(std::weak_ptr<Arion>
     return std::move(std::make_unique<MemoryRecorder>(arion));
 }
 
-bool MemoryRecorder::write_mem_hook(std::shared_ptr<Arion> arion, uc_mem_type type, uint64_t addr, int size,
-                                    int64_t val, void *user_data)
-{
-    arion->mem->recorder->add_edit(std::make_shared<ARION_MEM_EDIT>(addr, size));
-    return true;
-}
-
-void MemoryRecorder::add_edit(std::shared_ptr<ARION_MEM_EDIT> edit)
-{
-    if (!this->started)
-        return;
-    for (std::shared_ptr<ARION_MEM_EDIT> edit2 : this->edits)
-    {
-        if ((edit->addr < edit2->addr + edit2->sz) && (edit2->addr < edit->addr + edit->sz))
-        {
-            ADDR start_addr = std::min(edit->addr, edit2->addr);
-            ADDR end_addr = std::max(edit->addr + edit->sz, edit2->addr + edit2->sz);
-            edit2->addr = start_addr;
-            edit2->sz = end_addr - start_addr;
-            return;
-        }
-    }
-    this->edits.insert(this->edits.begin(),
-                       edit); // Next changes have more chances to occur in this region and it will be iterated first
-}
-
 void MemoryRecorder::clear()
 {
-    this->edits.clear();
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    arion->mem->clear_dirty();
 }
 
 void MemoryRecorder::start()
@@ -103,9 +85,8 @@ void MemoryRecorder::start()
     if (this->started)
         throw MemoryRecorderAlreadyStartedException();
     this->started = true;
-    this->clear();
-
-    this->write_mem_hook_id = arion->hooks->hook_mem_write(this->write_mem_hook);
+    arion->mem->clear_dirty();
+    arion->mem->set_dirty_tracking(true);
 }
 
 void MemoryRecorder::stop()
@@ -117,12 +98,21 @@ void MemoryRecorder::stop()
     if (!this->started)
         throw MemoryRecorderAlreadyStoppedException();
     this->started = false;
-    arion->hooks->unhook(this->write_mem_hook_id);
+    arion->mem->set_dirty_tracking(false);
+}
+
+bool MemoryRecorder::is_started()
+{
+    return this->started;
 }
 
 std::vector<std::shared_ptr<ARION_MEM_EDIT>> MemoryRecorder::get_edits()
 {
-    return this->edits;
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    return arion->mem->get_dirty_ranges();
 }
 
 std::unique_ptr<MemoryManager> MemoryManager::initialize(std::weak_ptr<Arion> arion)
@@ -132,14 +122,74 @@ std::unique_ptr<MemoryManager> MemoryManager::initialize(std::weak_ptr<Arion> ar
     return std::move(manager);
 }
 
-bool MemoryManager::is_mapped(ADDR addr)
+MemoryManager::~MemoryManager()
 {
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
+    for (auto &mapping_it : this->mappings)
     {
-        if (addr >= mapping->start_addr && addr < mapping->end_addr)
-            return true;
+        std::shared_ptr<ARION_MAPPING> mapping = mapping_it.second;
+        if (mapping->host_ptr)
+            this->free_host_mem(mapping->host_ptr, mapping->end_addr - mapping->start_addr);
+        mapping->host_ptr = nullptr;
     }
-    return false;
+}
+
+bool MemoryManager::host_mem_compatible()
+{
+    static const long host_page_sz = sysconf(_SC_PAGESIZE);
+    // Mappings are split on page boundaries, which must also be valid host boundaries
+    return host_page_sz > 0 && !(this->page_sz % host_page_sz);
+}
+
+bool MemoryManager::use_host_mem()
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!this->host_mem_compatible())
+        return false;
+    return arion->config->get_field<bool>("host_backed_mem");
+}
+
+BYTE *MemoryManager::alloc_host_mem(size_t sz)
+{
+    void *host_ptr = mmap(nullptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_NORESERVE, -1, 0);
+    if (host_ptr == MAP_FAILED)
+        throw HostMemAllocException(sz);
+    return (BYTE *)host_ptr;
+}
+
+void MemoryManager::free_host_mem(BYTE *host_ptr, size_t sz)
+{
+    if (sz)
+        munmap(host_ptr, sz);
+}
+
+std::map<ADDR, std::shared_ptr<ARION_MAPPING>>::iterator MemoryManager::find_mapping_it(ADDR addr)
+{
+    auto mapping_it = this->mappings.upper_bound(addr);
+    if (mapping_it == this->mappings.begin())
+        return this->mappings.end();
+    mapping_it--;
+    if (addr >= mapping_it->second->end_addr)
+        return this->mappings.end();
+    return mapping_it;
+}
+
+std::vector<std::shared_ptr<ARION_MAPPING>> MemoryManager::get_mappings_in(ADDR start_addr, ADDR end_addr)
+{
+    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_in;
+    auto mapping_it = this->mappings.upper_bound(start_addr);
+    if (mapping_it != this->mappings.begin() && std::prev(mapping_it)->second->end_addr > start_addr)
+        mapping_it--;
+    for (; mapping_it != this->mappings.end() && mapping_it->first < end_addr; mapping_it++)
+        mappings_in.push_back(mapping_it->second);
+    return mappings_in;
+}
+
+bool MemoryManager::is_mapped(ADDR addr)
+{
+    return this->find_mapping_it(addr) != this->mappings.end();
 }
 
 bool MemoryManager::has_mapping(std::shared_ptr<ARION_MAPPING> mapping)
@@ -154,48 +204,124 @@ bool MemoryManager::has_mapping(std::shared_ptr<ARION_MAPPING> mapping)
 bool MemoryManager::can_map(ADDR start_addr, size_t sz)
 {
     ADDR end_addr = start_addr + sz;
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
-    {
-        if ((start_addr >= mapping->start_addr && start_addr < mapping->end_addr) ||
-            (end_addr > mapping->start_addr && end_addr <= mapping->end_addr))
-            return false;
-    }
+    if (end_addr < start_addr)
+        return false;
+    auto mapping_it = this->mappings.upper_bound(start_addr);
+    if (mapping_it != this->mappings.end() && mapping_it->first < end_addr)
+        return false;
+    if (mapping_it != this->mappings.begin() && std::prev(mapping_it)->second->end_addr > start_addr)
+        return false;
     return true;
 }
 
 bool MemoryManager::has_mapping_with_info(std::string info)
 {
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
-    {
-        if (mapping->info == info)
-            return true;
-    }
-    return false;
+    return this->mappings_by_info.find(info) != this->mappings_by_info.end();
 }
 
 std::shared_ptr<ARION_MAPPING> MemoryManager::get_mapping_by_info(std::string info)
 {
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
+    auto info_it = this->mappings_by_info.find(info);
+    if (info_it == this->mappings_by_info.end())
+        throw NoSegmentWithInfoException(info);
+    return this->mappings.at(*info_it->second.begin());
+}
+
+std::shared_ptr<ARION_MAPPING> MemoryManager::get_mapping_at(ADDR addr)
+{
+    auto mapping_it = this->find_mapping_it(addr);
+    if (mapping_it == this->mappings.end())
+        throw NoSegmentAtAddrException(addr);
+    return mapping_it->second;
+}
+
+std::vector<std::shared_ptr<ARION_MAPPING>> MemoryManager::get_mappings()
+{
+    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_vec;
+    mappings_vec.reserve(this->mappings.size());
+    for (auto &mapping_it : this->mappings)
+        mappings_vec.push_back(mapping_it.second);
+    return mappings_vec;
+}
+
+void MemoryManager::reset_mappings(std::vector<std::unique_ptr<ARION_MAPPING>> &mapping_list)
+{
+    // The layout usually did not change, in which case there is nothing to rebuild
+    bool same_layout = mapping_list.size() == this->mappings.size();
+    auto mapping_it = this->mappings.begin();
+    for (size_t mapping_i = 0; same_layout && mapping_i < mapping_list.size(); mapping_i++, mapping_it++)
+    {
+        std::unique_ptr<ARION_MAPPING> &arion_m = mapping_list.at(mapping_i);
+        std::shared_ptr<ARION_MAPPING> curr_m = mapping_it->second;
+        same_layout = arion_m->start_addr == curr_m->start_addr && arion_m->end_addr == curr_m->end_addr &&
+                      arion_m->perms == curr_m->perms && arion_m->info == curr_m->info && !curr_m->host_ptr;
+    }
+    if (same_layout)
+        return;
+
+    for (auto &curr_m : this->mappings)
     {
-        if (mapping->info == info)
-            return mapping;
+        if (curr_m.second->host_ptr)
+            this->free_host_mem(curr_m.second->host_ptr, curr_m.second->end_addr - curr_m.second->start_addr);
+        curr_m.second->host_ptr = nullptr;
     }
-    throw NoSegmentWithInfoException(info);
+    this->mappings.clear();
+    this->mappings_by_info.clear();
+    for (std::unique_ptr<ARION_MAPPING> &arion_m : mapping_list)
+        this->insert_mapping(
+            std::make_shared<ARION_MAPPING>(arion_m->start_addr, arion_m->end_addr, arion_m->perms, arion_m->info));
 }
 
-std::shared_ptr<ARION_MAPPING> MemoryManager::get_mapping_at(ADDR addr)
+void MemoryManager::attach_host_mem(std::shared_ptr<ARION_MAPPING> mapping)
 {
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (mapping->host_ptr || !this->host_mem_compatible())
+        return;
+    size_t mapping_sz = mapping->end_addr - mapping->start_addr;
+    BYTE *host_ptr = this->alloc_host_mem(mapping_sz);
+    // Zero pages are left uncommitted in the host buffer
+    this->read_sparse(mapping->start_addr, host_ptr, mapping_sz);
+    uc_err uc_unmap_err = uc_mem_unmap(arion->uc, mapping->start_addr, mapping_sz);
+    if (uc_unmap_err != UC_ERR_OK)
     {
-        if (addr >= mapping->start_addr && addr < mapping->end_addr)
-            return mapping;
+        this->free_host_mem(host_ptr, mapping_sz);
+        throw UnicornUnmapException(uc_unmap_err);
     }
-    throw NoSegmentAtAddrException(addr);
+    uc_err uc_map_err = uc_mem_map_ptr(arion->uc, mapping->start_addr, mapping_sz,
+                                       this->to_tracked_uc_perms(mapping->perms), host_ptr);
+    if (uc_map_err != UC_ERR_OK)
+    {
+        this->free_host_mem(host_ptr, mapping_sz);
+        throw UnicornMapException(uc_map_err);
+    }
+    mapping->host_ptr = host_ptr;
 }
 
-std::vector<std::shared_ptr<ARION_MAPPING>> MemoryManager::get_mappings()
+void MemoryManager::detach_host_mem(std::shared_ptr<ARION_MAPPING> mapping)
 {
-    return this->mappings;
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!mapping->host_ptr)
+        return;
+    size_t mapping_sz = mapping->end_addr - mapping->start_addr;
+    uc_err uc_unmap_err = uc_mem_unmap(arion->uc, mapping->start_addr, mapping_sz);
+    if (uc_unmap_err != UC_ERR_OK)
+        throw UnicornUnmapException(uc_unmap_err);
+    uc_err uc_map_err =
+        uc_mem_map(arion->uc, mapping->start_addr, mapping_sz, this->to_tracked_uc_perms(mapping->perms));
+    if (uc_map_err != UC_ERR_OK)
+        throw UnicornMapException(uc_map_err);
+    this->write_sparse(mapping->start_addr, mapping->host_ptr, mapping_sz);
+
+    this->free_host_mem(mapping->host_ptr, mapping_sz);
+    mapping->host_ptr = nullptr;
+    mapping->host_file.reset();
+    mapping->host_off = 0;
 }
 
 std::string MemoryManager::mappings_str()
@@ -206,15 +332,14 @@ std::string MemoryManager::mappings_str()
     ss << std::setw(8) << "[FLAGS]";
     ss << "[INFO]" << std::endl;
 
-    size_t mappings_sz = this->mappings.size();
-    for (size_t m_i = 0; m_i < mappings_sz; m_i++)
+    for (auto mapping_it = this->mappings.begin(); mapping_it != this->mappings.end(); mapping_it++)
     {
-        std::shared_ptr<ARION_MAPPING> mapping = this->mappings.at(m_i);
+        std::shared_ptr<ARION_MAPPING> mapping = mapping_it->second;
         ss << std::left << std::setw(19) << int_to_hex(mapping->start_addr, 16);
         ss << std::setw(19) << int_to_hex(mapping->end_addr, 16);
         ss << std::setw(8) << prot_flags_to_str(mapping->perms);
         ss << mapping->info;
-        if (m_i != mappings_sz - 1)
+        if (std::next(mapping_it) != this->mappings.end())
             ss << std::endl;
     }
 
@@ -227,22 +352,34 @@ void MemoryManager::insert_mapping(std::shared_ptr<ARION_MAPPING> mapping)
     if (!arion)
         throw ExpiredWeakPtrException("Arion");
 
-    auto mappings_it =
-        std::lower_bound(this->mappings.begin(), this->mappings.end(), mapping,
-                         [](const std::shared_ptr<ARION_MAPPING> a, const std::shared_ptr<ARION_MAPPING> b) {
-                             return a->start_addr < b->start_addr;
-                         });
-    this->mappings.insert(mappings_it, mapping);
+    this->index_mapping(mapping);
 
     arion->tracer->process_new_mapping(mapping);
 }
 
 void MemoryManager::remove_mapping(std::shared_ptr<ARION_MAPPING> mapping)
 {
-    auto mapping_it = std::find(this->mappings.begin(), this->mappings.end(), mapping);
-    if (mapping_it == this->mappings.end())
+    auto mapping_it = this->mappings.find(mapping->start_addr);
+    if (mapping_it == this->mappings.end() || mapping_it->second != mapping)
         throw SegmentNotMappedException(mapping->start_addr, mapping->end_addr);
-    this->mappings.erase(mapping_it);
+    this->unindex_mapping(mapping);
+}
+
+void MemoryManager::index_mapping(std::shared_ptr<ARION_MAPPING> mapping)
+{
+    this->mappings[mapping->start_addr] = mapping;
+    this->mappings_by_info[mapping->info].insert(mapping->start_addr);
+}
+
+void MemoryManager::unindex_mapping(std::shared_ptr<ARION_MAPPING> mapping)
+{
+    this->mappings.erase(mapping->start_addr);
+    auto info_it = this->mappings_by_info.find(mapping->info);
+    if (info_it == this->mappings_by_info.end())
+        return;
+    info_it->second.erase(mapping->start_addr);
+    if (info_it->second.empty())
+        this->mappings_by_info.erase(info_it);
 }
 
 void MemoryManager::merge_uc_mappings(ADDR start, ADDR end)
@@ -252,20 +389,35 @@ void MemoryManager::merge_uc_mappings(ADDR start, ADDR end)
         throw ExpiredWeakPtrException("Arion");
 
     std::shared_ptr<ARION_MAPPING> mapping = this->get_mapping_at(start);
-    uint32_t uc_perms = to_uc_perms(mapping->perms);
+    uint32_t uc_perms = this->to_tracked_uc_perms(mapping->perms);
 
     size_t mapping_sz = end - start;
-    std::vector<BYTE> data = this->read(start, mapping_sz);
+    // Regions backed by a contiguous host buffer are merged by mapping the buffer again, without copying it
+    BYTE *host_ptr = this->view(start, mapping_sz);
+    std::vector<BYTE> data;
+    if (!host_ptr)
+    {
+        data.resize(mapping_sz);
+        uc_err uc_read_err = uc_mem_read(arion->uc, start, data.data(), mapping_sz);
+        if (uc_read_err != UC_ERR_OK)
+            throw UnicornMemReadException(uc_read_err);
+    }
 
     uc_err uc_unmap_err = uc_mem_unmap(arion->uc, start, mapping_sz);
     if (uc_unmap_err != UC_ERR_OK)
         throw UnicornUnmapException(uc_unmap_err);
 
-    uc_err uc_map_err = uc_mem_map(arion->uc, start, mapping_sz, uc_perms);
+    uc_err uc_map_err = host_ptr ? uc_mem_map_ptr(arion->uc, start, mapping_sz, uc_perms, host_ptr)
+                                 : uc_mem_map(arion->uc, start, mapping_sz, uc_perms);
     if (uc_map_err != UC_ERR_OK)
         throw UnicornMapException(uc_map_err);
 
-    this->write(start, data.data(), mapping_sz);
+    if (!host_ptr)
+    {
+        uc_err uc_write_err = uc_mem_write(arion->uc, start, data.data(), mapping_sz);
+        if (uc_write_err != UC_ERR_OK)
+            throw UnicornMemWriteException(uc_write_err);
+    }
 }
 
 void MemoryManager::merge_contiguous_uc_mappings()
@@ -321,58 +473,238 @@ ADDR MemoryManager::map(ADDR start_addr, size_t sz, PROT_FLAGS perms, std::strin
     if (!this->can_map(start_addr, sz))
         throw MemAlreadyMappedException(start_addr, sz);
 
-    uint32_t uc_perms = this->to_uc_perms(perms);
-    uc_err uc_map_err = uc_mem_map(arion->uc, start_addr, sz, uc_perms);
+    uint32_t uc_perms = this->to_tracked_uc_perms(perms);
+    BYTE *host_ptr = nullptr;
+    uc_err uc_map_err;
+    if (this->use_host_mem())
+    {
+        host_ptr = this->alloc_host_mem(sz);
+        uc_map_err = uc_mem_map_ptr(arion->uc, start_addr, sz, uc_perms, host_ptr);
+    }
+    else
+        uc_map_err = uc_mem_map(arion->uc, start_addr, sz, uc_perms);
     if (uc_map_err != UC_ERR_OK)
+    {
+        if (host_ptr)
+            this->free_host_mem(host_ptr, sz);
         throw UnicornMapException(uc_map_err);
+    }
     std::shared_ptr<ARION_MAPPING> mapping = std::make_unique<ARION_MAPPING>(start_addr, start_addr + sz, perms, info);
+    mapping->host_ptr = host_ptr;
 
     this->insert_mapping(mapping);
     return start_addr;
 }
 
-ADDR MemoryManager::map_anywhere(ADDR addr, size_t sz, PROT_FLAGS perms, bool asc, std::string info)
+ADDR MemoryManager::map_file(ADDR start_addr, size_t sz, PROT_FLAGS perms, int fd, off_t off, std::string info)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    start_addr = align_up(start_addr);
+    sz = align_up(sz);
+    if (!this->can_map(start_addr, sz))
+        throw MemAlreadyMappedException(start_addr, sz);
+
+    struct stat file_stat;
+    if (this->host_mem_compatible() && !(off % this->page_sz) && !fstat(fd, &file_stat))
+    {
+        // Pages located after the end of the file must not be backed by it, accessing them would raise SIGBUS
+        size_t file_map_sz = 0;
+        if (file_stat.st_size > off)
+            file_map_sz = std::min(sz, (size_t)align_up(file_stat.st_size - off));
+        BYTE *host_ptr = this->alloc_host_mem(sz);
+        // The file must stay open for the mapping to be shared or saved with its content
+        int host_fd = file_map_sz ? dup(fd) : -1;
+        // A private mapping keeps file pages shared in the host page cache until they are written (copy-on-write)
+        if (!file_map_sz ||
+            (host_fd >= 0 &&
+             mmap(host_ptr, file_map_sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED, fd, off) != MAP_FAILED))
+        {
+            uc_err uc_map_err =
+                uc_mem_map_ptr(arion->uc, start_addr, sz, this->to_tracked_uc_perms(perms), host_ptr);
+            if (uc_map_err != UC_ERR_OK)
+            {
+                if (host_fd >= 0)
+                    close(host_fd);
+                this->free_host_mem(host_ptr, sz);
+                throw UnicornMapException(uc_map_err);
+            }
+            std::shared_ptr<ARION_MAPPING> mapping =
+                std::make_unique<ARION_MAPPING>(start_addr, start_addr + sz, perms, info);
+            mapping->host_ptr = host_ptr;
+            if (host_fd >= 0)
+            {
+                mapping->host_file = std::make_shared<ARION_HOST_FILE>(host_fd);
+                mapping->host_off = off;
+            }
+
+            this->insert_mapping(mapping);
+            return start_addr;
+        }
+        if (host_fd >= 0)
+            close(host_fd);
+        this->free_host_mem(host_ptr, sz);
+    }
+
+    // Fallback on a copy of the file content (e.g. unaligned offset or file that cannot be mapped or duplicated)
+    this->map(start_addr, sz, perms, info);
+    std::vector<BYTE> data(sz);
+    ssize_t read_sz = pread(fd, data.data(), sz, off);
+    if (read_sz > 0)
+        this->write(start_addr, data.data(), read_sz);
+    return start_addr;
+}
+
+void MemoryManager::copy_host_file(int src_fd, off_t src_off, int dst_fd, size_t sz)
+{
+    struct stat file_stat;
+    if (fstat(src_fd, &file_stat) || file_stat.st_size <= src_off)
+        return;
+    off_t src_end = std::min((off_t)(src_off + sz), file_stat.st_size);
+    std::vector<BYTE> buf;
+    off_t data_off = src_off;
+    while (data_off < src_end)
+    {
+        off_t hole_off = src_end;
+        off_t seek_off = lseek(src_fd, data_off, SEEK_DATA);
+        if (seek_off < 0 && errno == ENXIO)
+            break;
+        if (seek_off >= 0)
+        {
+            data_off = seek_off;
+            hole_off = std::min(lseek(src_fd, data_off, SEEK_HOLE), src_end);
+        }
+        // Otherwise, holes can't be found on this file system and the whole range is copied
+        while (data_off < hole_off)
+        {
+            loff_t in_off = data_off;
+            loff_t out_off = data_off - src_off;
+            ssize_t copy_sz = copy_file_range(src_fd, &in_off, dst_fd, &out_off, hole_off - data_off, 0);
+            if (copy_sz <= 0)
+            {
+                buf.resize(this->page_sz);
+                copy_sz = pread(src_fd, buf.data(), std::min((off_t)buf.size(), hole_off - data_off), data_off);
+                if (copy_sz <= 0 || pwrite(dst_fd, buf.data(), copy_sz, data_off - src_off) != copy_sz)
+                    throw HostMemAllocException(sz);
+            }
+            data_off += copy_sz;
+        }
+    }
+}
+
+std::shared_ptr<ARION_HOST_FILE> MemoryManager::share_mapping(std::shared_ptr<ARION_MAPPING> mapping)
+{
+    size_t sz = mapping->end_addr - mapping->start_addr;
+    if (!mapping->host_ptr)
+        throw SegmentNotMappedException(mapping->start_addr, mapping->end_addr);
+
+    int fd = memfd_create("arion_cow", MFD_CLOEXEC);
+    if (fd < 0)
+        throw HostMemAllocException(sz);
+    std::shared_ptr<ARION_HOST_FILE> host_file = std::make_shared<ARION_HOST_FILE>(fd);
+    if (ftruncate(fd, sz))
+        throw HostMemAllocException(sz);
+
+    // Pages that were never written still hold the content of the previous host file
+    if (mapping->host_file)
+        this->copy_host_file(mapping->host_file->fd, mapping->host_off, fd, sz);
+
+    // Pages written since then are private anonymous pages, found in the page map of the host process
+    static const long host_page_sz = sysconf(_SC_PAGESIZE);
+    size_t host_pages = sz / host_page_sz;
+    std::vector<uint64_t> page_entries(std::min(host_pages, (size_t)ARION_PAGEMAP_BATCH_SZ));
+    int pagemap_fd = open("/proc/self/pagemap", O_RDONLY | O_CLOEXEC);
+    for (size_t page_i = 0; page_i < host_pages; page_i += page_entries.size())
+    {
+        size_t batch_sz = std::min(page_entries.size(), host_pages - page_i);
+        off_t pagemap_off = ((uintptr_t)mapping->host_ptr / host_page_sz + page_i) * sizeof(uint64_t);
+        size_t entries_sz = batch_sz * sizeof(uint64_t);
+        if (pagemap_fd < 0 || pread(pagemap_fd, page_entries.data(), entries_sz, pagemap_off) != (ssize_t)entries_sz)
+            // Without page map, all pages are considered written
+            std::fill(page_entries.begin(), page_entries.end(), ARION_PAGEMAP_PRESENT);
+        for (size_t batch_i = 0; batch_i < batch_sz; batch_i++)
+        {
+            uint64_t entry = page_entries[batch_i];
+            if (!(entry & (ARION_PAGEMAP_PRESENT | ARION_PAGEMAP_SWAPPED)) || (entry & ARION_PAGEMAP_FILE))
+                continue;
+            off_t page_off = (page_i + batch_i) * host_page_sz;
+            BYTE *page = mapping->host_ptr + page_off;
+            if (this->is_zero_chunk(page, host_page_sz) && !mapping->host_file)
+                continue;
+            if (pwrite(fd, page, host_page_sz, page_off) != host_page_sz)
+            {
+                if (pagemap_fd >= 0)
+                    close(pagemap_fd);
+                throw HostMemAllocException(sz);
+            }
+        }
+    }
+    if (pagemap_fd >= 0)
+        close(pagemap_fd);
+
+    // Replaces the host buffer in place, so that Unicorn keeps using the same host pointer
+    if (mmap(mapping->host_ptr, sz, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_FIXED | MAP_NORESERVE, fd, 0) ==
+        MAP_FAILED)
+        throw HostMemAllocException(sz);
+    mapping->host_file = host_file;
+    mapping->host_off = 0;
+    return host_file;
+}
+
+ADDR MemoryManager::find_free_addr(ADDR addr, size_t sz, bool asc)
 {
     addr = this->align_up(addr);
     sz = this->align_up(sz);
     if (asc)
     {
         ADDR start_addr = addr;
-        for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
+        // Only mappings ending after the requested address are relevant
+        auto mapping_it = this->mappings.upper_bound(addr);
+        if (mapping_it != this->mappings.begin() && std::prev(mapping_it)->second->end_addr > addr)
+            mapping_it--;
+        for (; mapping_it != this->mappings.end(); mapping_it++)
         {
+            std::shared_ptr<ARION_MAPPING> mapping = mapping_it->second;
             ADDR end_addr = mapping->start_addr;
-            if (end_addr < start_addr)
-                continue;
-            size_t available_space = end_addr - start_addr;
-            if (sz <= available_space)
+            if (end_addr >= start_addr)
             {
-                this->map(start_addr, sz, perms, info);
-                return start_addr;
+                size_t available_space = end_addr - start_addr;
+                if (sz <= available_space)
+                    return start_addr;
             }
-            start_addr = mapping->end_addr;
+            start_addr = std::max(start_addr, mapping->end_addr);
         }
-        return this->map(start_addr, sz, perms, info);
+        return start_addr;
     }
     else
     {
         ADDR end_addr = addr;
-        for (auto mapping_it = this->mappings.rbegin(); mapping_it != this->mappings.rend(); mapping_it++)
+        // Only mappings starting before the requested address are relevant
+        auto mapping_it = std::make_reverse_iterator(this->mappings.lower_bound(addr));
+        for (; mapping_it != this->mappings.rend(); mapping_it++)
         {
-            std::shared_ptr<ARION_MAPPING> mapping = *mapping_it;
+            std::shared_ptr<ARION_MAPPING> mapping = mapping_it->second;
             ADDR start_addr = mapping->end_addr;
-            if (end_addr < start_addr)
-                continue;
-            size_t available_space = end_addr - start_addr;
-            if (sz <= available_space)
+            if (end_addr >= start_addr)
             {
-                return this->map(end_addr - sz, sz, perms, info);
+                size_t available_space = end_addr - start_addr;
+                if (sz <= available_space)
+                    return end_addr - sz;
             }
-            end_addr = mapping->start_addr;
+            end_addr = std::min(end_addr, mapping->start_addr);
         }
-        return this->map(end_addr - sz, sz, perms, info);
+        return end_addr - sz;
     }
 }
 
+ADDR MemoryManager::map_anywhere(ADDR addr, size_t sz, PROT_FLAGS perms, bool asc, std::string info)
+{
+    sz = this->align_up(sz);
+    return this->map(this->find_free_addr(addr, sz, asc), sz, perms, info);
+}
+
 ADDR MemoryManager::map_anywhere(size_t sz, PROT_FLAGS perms, bool asc, std::string info)
 {
     return this->map_anywhere(0, sz, perms, asc, info);
@@ -389,29 +721,45 @@ void MemoryManager::unmap(std::shared_ptr<ARION_MAPPING> mapping, ADDR start_add
     start_addr = std::max(start_addr, mapping->start_addr);
     end_addr = std::min(end_addr, mapping->end_addr);
 
-    auto mapping_it = std::find(this->mappings.begin(), this->mappings.end(), mapping);
-    if (mapping_it == this->mappings.end())
+    auto mapping_it = this->mappings.find(mapping->start_addr);
+    if (mapping_it == this->mappings.end() || mapping_it->second != mapping)
         throw SegmentNotMappedException(mapping->start_addr, mapping->end_addr);
 
+    // Unicorn engine copies the whole region when splitting memory it owns, but not host memory
+    if (start_addr != mapping->start_addr || end_addr != mapping->end_addr)
+        this->attach_host_mem(mapping);
     size_t mapping_del_sz = end_addr - start_addr;
     uc_err uc_unmap_err = uc_mem_unmap(arion->uc, start_addr, mapping_del_sz);
     if (uc_unmap_err != UC_ERR_OK)
         throw UnicornUnmapException(uc_unmap_err);
-    this->mappings.erase(mapping_it);
+    this->unindex_mapping(mapping);
+    if (mapping->host_ptr)
+        this->free_host_mem(mapping->host_ptr + (start_addr - mapping->start_addr), mapping_del_sz);
 
     if (mapping->start_addr != start_addr)
     {
         std::shared_ptr<ARION_MAPPING> map_before =
             std::make_shared<ARION_MAPPING>(mapping->start_addr, start_addr, mapping->perms, mapping->info);
+        map_before->host_ptr = mapping->host_ptr;
+        map_before->host_file = mapping->host_file;
+        map_before->host_off = mapping->host_off;
+        map_before->dirty_pages = this->slice_dirty_pages(mapping, mapping->start_addr, start_addr);
         this->insert_mapping(map_before);
     }
     if (mapping->end_addr != end_addr)
     {
         std::shared_ptr<ARION_MAPPING> map_after =
             std::make_shared<ARION_MAPPING>(end_addr, mapping->end_addr, mapping->perms, mapping->info);
+        if (mapping->host_ptr)
+            map_after->host_ptr = mapping->host_ptr + (end_addr - mapping->start_addr);
+        map_after->host_file = mapping->host_file;
+        map_after->host_off = mapping->host_off + (end_addr - mapping->start_addr);
+        map_after->dirty_pages = this->slice_dirty_pages(mapping, end_addr, mapping->end_addr);
         this->insert_mapping(map_after);
     }
 
+    mapping->host_ptr = nullptr;
+    mapping->host_file.reset();
     mapping.reset();
 }
 
@@ -425,17 +773,13 @@ void MemoryManager::unmap(ADDR start_addr, ADDR end_addr)
     start_addr = align_up(start_addr);
     end_addr = align_up(end_addr);
 
-    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_cpy; // Need to clone to prevent concurrency
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
-        mappings_cpy.push_back(mapping);
+    // Need to clone to prevent concurrency
+    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_cpy = this->get_mappings_in(start_addr, end_addr);
     for (std::shared_ptr<ARION_MAPPING> &mapping : mappings_cpy)
     {
-        if (start_addr <= mapping->end_addr && end_addr > mapping->start_addr)
-        {
-            ADDR start_unmap = std::max(mapping->start_addr, start_addr);
-            ADDR end_unmap = std::min(mapping->end_addr, end_addr);
-            this->unmap(mapping, start_unmap, end_unmap);
-        }
+        ADDR start_unmap = std::max(mapping->start_addr, start_addr);
+        ADDR end_unmap = std::min(mapping->end_addr, end_addr);
+        this->unmap(mapping, start_unmap, end_unmap);
     }
 }
 
@@ -449,9 +793,8 @@ void MemoryManager::unmap(ADDR seg_addr)
 
 void MemoryManager::unmap_all()
 {
-    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_cpy; // Need to clone to prevent concurrency
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
-        mappings_cpy.push_back(mapping);
+    // Need to clone to prevent concurrency
+    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_cpy = this->get_mappings();
 
     for (std::shared_ptr<ARION_MAPPING> &mapping : mappings_cpy)
         this->unmap(mapping);
@@ -468,16 +811,28 @@ void MemoryManager::protect(std::shared_ptr<ARION_MAPPING> mapping, ADDR start_a
 
     start_addr = std::max(start_addr, mapping->start_addr);
     end_addr = std::min(end_addr, mapping->end_addr);
+    // Unicorn engine copies the whole region when splitting memory it owns, but not host memory
+    if (start_addr != mapping->start_addr || end_addr != mapping->end_addr)
+        this->attach_host_mem(mapping);
 
     ADDR old_start_addr = mapping->start_addr;
     ADDR old_end_addr = mapping->end_addr;
     PROT_FLAGS old_perms = mapping->perms;
     std::string old_info = mapping->info;
-    uint32_t uc_perms = this->to_uc_perms(perms);
+    BYTE *old_host_ptr = mapping->host_ptr;
+    off_t old_host_off = mapping->host_off;
+    std::vector<uint64_t> dirty_before = this->slice_dirty_pages(mapping, old_start_addr, start_addr);
+    std::vector<uint64_t> dirty_after = this->slice_dirty_pages(mapping, end_addr, old_end_addr);
+    mapping->dirty_pages = this->slice_dirty_pages(mapping, start_addr, end_addr);
+    uint32_t uc_perms = this->to_tracked_uc_perms(perms);
+    this->remove_mapping(mapping);
     mapping->start_addr = start_addr;
     mapping->end_addr = end_addr;
-    if (start_addr == end_addr)
-        this->remove_mapping(mapping);
+    if (old_host_ptr)
+        mapping->host_ptr = old_host_ptr + (start_addr - old_start_addr);
+    mapping->host_off = old_host_off + (start_addr - old_start_addr);
+    if (start_addr != end_addr)
+        this->index_mapping(mapping);
     mapping->perms = perms;
     uc_err uc_protect_err = uc_mem_protect(arion->uc, start_addr, end_addr - start_addr, uc_perms);
     if (uc_protect_err != UC_ERR_OK)
@@ -487,12 +842,21 @@ void MemoryManager::protect(std::shared_ptr<ARION_MAPPING> mapping, ADDR start_a
     {
         std::shared_ptr<ARION_MAPPING> map_before =
             std::make_shared<ARION_MAPPING>(old_start_addr, start_addr, old_perms, old_info);
+        map_before->host_ptr = old_host_ptr;
+        map_before->host_file = mapping->host_file;
+        map_before->host_off = old_host_off;
+        map_before->dirty_pages = dirty_before;
         this->insert_mapping(map_before);
     }
     if (old_end_addr != end_addr)
     {
         std::shared_ptr<ARION_MAPPING> map_after =
             std::make_shared<ARION_MAPPING>(end_addr, old_end_addr, old_perms, old_info);
+        if (old_host_ptr)
+            map_after->host_ptr = old_host_ptr + (end_addr - old_start_addr);
+        map_after->host_file = mapping->host_file;
+        map_after->host_off = old_host_off + (end_addr - old_start_addr);
+        map_after->dirty_pages = dirty_after;
         this->insert_mapping(map_after);
     }
 }
@@ -507,14 +871,10 @@ void MemoryManager::protect(ADDR start_addr, ADDR end_addr, PROT_FLAGS perms)
     start_addr = align_up(start_addr);
     end_addr = align_up(end_addr);
 
-    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_cpy; // Need to clone to prevent concurrency
-    for (std::shared_ptr<ARION_MAPPING> &mapping : this->mappings)
-        mappings_cpy.push_back(mapping);
+    // Need to clone to prevent concurrency
+    std::vector<std::shared_ptr<ARION_MAPPING>> mappings_cpy = this->get_mappings_in(start_addr, end_addr);
     for (std::shared_ptr<ARION_MAPPING> &mapping : mappings_cpy)
-    {
-        if (start_addr <= mapping->end_addr && end_addr > mapping->start_addr)
-            this->protect(mapping, start_addr, end_addr, perms);
-    }
+        this->protect(mapping, start_addr, end_addr, perms);
 }
 
 void MemoryManager::protect(ADDR seg_addr, PROT_FLAGS perms)
@@ -532,8 +892,8 @@ void MemoryManager::resize_mapping(std::shared_ptr<ARION_MAPPING> mapping, ADDR
     start_addr = align_up(start_addr);
     end_addr = align_up(end_addr);
 
-    auto mapping_it = std::find(this->mappings.begin(), this->mappings.end(), mapping);
-    if (mapping_it == this->mappings.end())
+    auto mapping_it = this->mappings.find(mapping->start_addr);
+    if (mapping_it == this->mappings.end() || mapping_it->second != mapping)
         throw SegmentNotMappedException(mapping->start_addr, mapping->end_addr);
 
     if (start_addr >= end_addr)
@@ -542,15 +902,26 @@ void MemoryManager::resize_mapping(std::shared_ptr<ARION_MAPPING> mapping, ADDR
         uc_err uc_unmap_err = uc_mem_unmap(arion->uc, mapping->start_addr, mapping_del_sz);
         if (uc_unmap_err != UC_ERR_OK)
             throw UnicornUnmapException(uc_unmap_err);
-        this->mappings.erase(mapping_it);
+        this->unindex_mapping(mapping);
+        if (mapping->host_ptr)
+            this->free_host_mem(mapping->host_ptr, mapping_del_sz);
+        mapping->host_ptr = nullptr;
+        mapping->host_file.reset();
         mapping.reset();
         return;
     }
 
+    if (mapping->host_ptr)
+    {
+        this->resize_host_mapping(mapping, start_addr, end_addr);
+        return;
+    }
+
     if (start_addr < mapping->start_addr)
     {
         size_t mapping_sz = mapping->start_addr - start_addr;
-        uc_err uc_map_err = uc_mem_map(arion->uc, start_addr, mapping_sz, to_uc_perms(mapping->perms));
+        uc_err uc_map_err =
+            uc_mem_map(arion->uc, start_addr, mapping_sz, this->to_tracked_uc_perms(mapping->perms));
         if (uc_map_err != UC_ERR_OK)
             throw UnicornMapException(uc_map_err);
     }
@@ -565,7 +936,8 @@ void MemoryManager::resize_mapping(std::shared_ptr<ARION_MAPPING> mapping, ADDR
     if (end_addr > mapping->end_addr)
     {
         size_t mapping_sz = end_addr - mapping->end_addr;
-        uc_err uc_map_err = uc_mem_map(arion->uc, mapping->end_addr, mapping_sz, to_uc_perms(mapping->perms));
+        uc_err uc_map_err =
+            uc_mem_map(arion->uc, mapping->end_addr, mapping_sz, this->to_tracked_uc_perms(mapping->perms));
         if (uc_map_err != UC_ERR_OK)
             throw UnicornMapException(uc_map_err);
     }
@@ -577,8 +949,54 @@ void MemoryManager::resize_mapping(std::shared_ptr<ARION_MAPPING> mapping, ADDR
             throw UnicornUnmapException(uc_unmap_err);
     }
 
+    this->unindex_mapping(mapping);
+    mapping->dirty_pages = this->slice_dirty_pages(mapping, start_addr, end_addr);
+    mapping->start_addr = start_addr;
+    mapping->end_addr = end_addr;
+    this->index_mapping(mapping);
+}
+
+void MemoryManager::resize_host_mapping(std::shared_ptr<ARION_MAPPING> mapping, ADDR start_addr, ADDR end_addr)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    size_t old_sz = mapping->end_addr - mapping->start_addr;
+    size_t new_sz = end_addr - start_addr;
+    uc_err uc_unmap_err = uc_mem_unmap(arion->uc, mapping->start_addr, old_sz);
+    if (uc_unmap_err != UC_ERR_OK)
+        throw UnicornUnmapException(uc_unmap_err);
+
+    BYTE *host_ptr = (BYTE *)MAP_FAILED;
+    // Common case (brk), the buffer can be resized without copying its content. Buffers backed by a host file are
+    // copied instead, as growing their file mapping would expose pages past the end of the file.
+    if (start_addr == mapping->start_addr && !mapping->host_file)
+        host_ptr = (BYTE *)mremap(mapping->host_ptr, old_sz, new_sz, MREMAP_MAYMOVE);
+    if (host_ptr == MAP_FAILED)
+    {
+        host_ptr = this->alloc_host_mem(new_sz);
+        ADDR keep_start = std::max(start_addr, mapping->start_addr);
+        ADDR keep_end = std::min(end_addr, mapping->end_addr);
+        if (keep_start < keep_end)
+            memcpy(host_ptr + (keep_start - start_addr), mapping->host_ptr + (keep_start - mapping->start_addr),
+                   keep_end - keep_start);
+        this->free_host_mem(mapping->host_ptr, old_sz);
+        mapping->host_file.reset();
+        mapping->host_off = 0;
+    }
+
+    uc_err uc_map_err =
+        uc_mem_map_ptr(arion->uc, start_addr, new_sz, this->to_tracked_uc_perms(mapping->perms), host_ptr);
+    if (uc_map_err != UC_ERR_OK)
+        throw UnicornMapException(uc_map_err);
+
+    this->unindex_mapping(mapping);
+    mapping->dirty_pages = this->slice_dirty_pages(mapping, start_addr, end_addr);
     mapping->start_addr = start_addr;
     mapping->end_addr = end_addr;
+    mapping->host_ptr = host_ptr;
+    this->index_mapping(mapping);
 }
 
 void MemoryManager::resize_mapping(ADDR seg_addr, ADDR start_addr, ADDR end_addr)
@@ -604,16 +1022,72 @@ std::vector<BYTE> MemoryManager::read(ADDR addr, size_t data_sz)
     return std::move(read_data);
 }
 
-uint64_t MemoryManager::read_val(ADDR addr, uint8_t n)
+void MemoryManager::read_into(ADDR addr, void *buf, size_t data_sz)
 {
-    std::vector<BYTE> read_data = this->read(addr, n);
-    std::reverse(read_data.begin(), read_data.end());
-    uint64_t res = 0;
-    for (BYTE b : read_data)
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    uc_err uc_read_err = uc_mem_read(arion->uc, addr, buf, data_sz);
+    if (uc_read_err != UC_ERR_OK)
+        throw UnicornMemReadException(uc_read_err);
+}
+
+bool MemoryManager::is_zero_chunk(const BYTE *data, size_t data_sz)
+{
+    // A chunk is only made of zeros if its first byte is zero and equal to each next one
+    return !data_sz || (!data[0] && !memcmp(data, data + 1, data_sz - 1));
+}
+
+void MemoryManager::read_sparse(ADDR addr, BYTE *buf, size_t data_sz)
+{
+    std::vector<BYTE> page_buf;
+    ADDR end_addr = addr + data_sz;
+    while (addr < end_addr)
+    {
+        size_t chunk_sz = std::min((ADDR)(this->align_up(addr + 1) - addr), end_addr - addr);
+        BYTE *chunk = this->view(addr, chunk_sz);
+        if (!chunk)
+        {
+            page_buf.resize(this->page_sz);
+            this->read_into(addr, page_buf.data(), chunk_sz);
+            chunk = page_buf.data();
+        }
+        if (!this->is_zero_chunk(chunk, chunk_sz))
+            memcpy(buf, chunk, chunk_sz);
+        addr += chunk_sz;
+        buf += chunk_sz;
+    }
+}
+
+BYTE *MemoryManager::view(ADDR addr, size_t data_sz)
+{
+    auto mapping_it = this->find_mapping_it(addr);
+    if (mapping_it == this->mappings.end())
+        return nullptr;
+    std::shared_ptr<ARION_MAPPING> mapping = mapping_it->second;
+    if (!mapping->host_ptr)
+        return nullptr;
+
+    // Mappings split by protect or unmap keep sharing a contiguous host buffer
+    ADDR end_addr = addr + data_sz;
+    ADDR curr_end = mapping->end_addr;
+    BYTE *curr_host_end = mapping->host_ptr + (mapping->end_addr - mapping->start_addr);
+    for (auto next_it = std::next(mapping_it); curr_end < end_addr; next_it++)
     {
-        res <<= 8;
-        res |= b;
+        if (next_it == this->mappings.end() || next_it->first != curr_end || next_it->second->host_ptr != curr_host_end)
+            return nullptr;
+        curr_end = next_it->second->end_addr;
+        curr_host_end = next_it->second->host_ptr + (next_it->second->end_addr - next_it->second->start_addr);
     }
+    return mapping->host_ptr + (addr - mapping->start_addr);
+}
+
+uint64_t MemoryManager::read_val(ADDR addr, uint8_t n)
+{
+    // Emulated memory and host are both little-endian, the value can be read in place
+    uint64_t res = 0;
+    this->read_into(addr, &res, std::min<size_t>(n, sizeof(uint64_t)));
     return res;
 }
 
@@ -655,8 +1129,8 @@ std::string MemoryManager::read_hex(ADDR addr, size_t data_sz, char sep)
 
 std::string MemoryManager::read_ascii(ADDR addr, size_t data_sz)
 {
-    std::vector<BYTE> read_data = this->read(addr, data_sz);
-    std::string ascii_str(read_data.begin(), read_data.end());
+    std::string ascii_str(data_sz, '\0');
+    this->read_into(addr, ascii_str.data(), data_sz);
     return ascii_str;
 }
 
@@ -668,20 +1142,16 @@ std::string MemoryManager::read_c_string(ADDR addr)
     ADDR curr_addr = addr;
     ADDR end_addr = mapping->end_addr;
     size_t buf_sz = ARION_BUF_SZ;
+    char buf[ARION_BUF_SZ];
     while (curr_addr < end_addr)
     {
         if (end_addr - curr_addr < buf_sz)
             buf_sz = end_addr - curr_addr;
-        std::vector<BYTE> read_data = this->read(curr_addr, buf_sz);
-        for (BYTE b : read_data)
-        {
-            if (b)
-            {
-                c_str += (char)b;
-            }
-            else
-                return c_str;
-        }
+        this->read_into(curr_addr, buf, buf_sz);
+        char *null_b = (char *)memchr(buf, 0, buf_sz);
+        if (null_b)
+            return c_str.append(buf, null_b - buf);
+        c_str.append(buf, buf_sz);
         curr_addr += buf_sz;
     }
     return c_str;
@@ -689,15 +1159,20 @@ std::string MemoryManager::read_c_string(ADDR addr)
 
 std::vector<ADDR> MemoryManager::read_ptr_arr(ADDR addr)
 {
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    size_t ptr_sz = arion->arch->get_attrs()->ptr_sz;
     std::vector<ADDR> arr;
     ADDR curr_val = ARION_MAX_U64;
     off_t off = 0;
     while (curr_val)
     {
-        curr_val = this->read_ptr(addr + off);
+        curr_val = this->read_val(addr + off, ptr_sz);
         if (curr_val)
             arr.push_back(curr_val);
-        off += sizeof(ADDR);
+        off += ptr_sz;
     }
     return arr;
 }
@@ -710,15 +1185,14 @@ std::vector<cs_insn> MemoryManager::read_instrs(ADDR addr, size_t count)
 
     std::vector<cs_insn> instrs;
     off_t off = 0;
-    BYTE *buf = (BYTE *)malloc(ARION_BUF_SZ);
+    BYTE buf[ARION_BUF_SZ];
     size_t buf_sz = ARION_BUF_SZ;
     while (instrs.size() < count)
     {
         std::shared_ptr<ARION_MAPPING> mapping = this->get_mapping_at(addr + off);
         if (mapping->end_addr < addr + off + ARION_BUF_SZ)
             buf_sz = mapping->end_addr - (addr + off);
-        std::vector<BYTE> buf_vec = this->read(addr + off, buf_sz);
-        memcpy(buf, buf_vec.data(), buf_vec.size());
+        this->read_into(addr + off, buf, buf_sz);
         cs_insn *insn;
         size_t dis_count = cs_disasm(*arion->arch->curr_cs(), buf, buf_sz, addr + off, count - instrs.size(), &insn);
         for (uint64_t instr_i = 0; instr_i < dis_count && instr_i < count; instr_i++)
@@ -726,7 +1200,6 @@ std::vector<cs_insn> MemoryManager::read_instrs(ADDR addr, size_t count)
         cs_free(insn, dis_count);
         off += ARION_BUF_SZ;
     }
-    free(buf);
     return instrs;
 }
 
@@ -739,6 +1212,194 @@ void MemoryManager::write(ADDR addr, BYTE *data, size_t data_sz)
     uc_err uc_write_err = uc_mem_write(arion->uc, addr, data, data_sz);
     if (uc_write_err != UC_ERR_OK)
         throw UnicornMemWriteException(uc_write_err);
+    this->mark_dirty(addr, data_sz);
+}
+
+void MemoryManager::write_sparse(ADDR addr, BYTE *data, size_t data_sz)
+{
+    ADDR end_addr = addr + data_sz;
+    while (addr < end_addr)
+    {
+        size_t chunk_sz = std::min((ADDR)(this->align_up(addr + 1) - addr), end_addr - addr);
+        if (!this->is_zero_chunk(data, chunk_sz))
+            this->write(addr, data, chunk_sz);
+        addr += chunk_sz;
+        data += chunk_sz;
+    }
+}
+
+void MemoryManager::set_dirty_tracking(bool enabled)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (this->dirty_tracking == enabled)
+        return;
+    this->dirty_tracking = enabled;
+    for (auto &mapping_it : this->mappings)
+    {
+        std::shared_ptr<ARION_MAPPING> mapping = mapping_it.second;
+        if (!(mapping->perms & 2))
+            continue;
+        uc_err uc_protect_err = uc_mem_protect(arion->uc, mapping->start_addr, mapping->end_addr - mapping->start_addr,
+                                               this->to_tracked_uc_perms(mapping->perms));
+        if (uc_protect_err != UC_ERR_OK)
+            throw UnicornMemProtectException(uc_protect_err);
+    }
+}
+
+bool MemoryManager::is_dirty_tracking()
+{
+    return this->dirty_tracking;
+}
+
+void MemoryManager::mark_dirty(ADDR addr, size_t data_sz)
+{
+    if (!this->dirty_tracking || !data_sz)
+        return;
+
+    ADDR end_addr = addr + data_sz;
+    auto mapping_it = this->mappings.upper_bound(addr);
+    if (mapping_it != this->mappings.begin() && std::prev(mapping_it)->second->end_addr > addr)
+        mapping_it--;
+    for (; mapping_it != this->mappings.end() && mapping_it->first < end_addr; mapping_it++)
+    {
+        std::shared_ptr<ARION_MAPPING> mapping = mapping_it->second;
+        if (mapping->dirty_pages.empty())
+            mapping->dirty_pages.resize(((mapping->end_addr - mapping->start_addr) / this->page_sz + 63) / 64);
+        size_t first_page = (std::max(addr, mapping->start_addr) - mapping->start_addr) / this->page_sz;
+        size_t last_page = (std::min(end_addr, mapping->end_addr) - 1 - mapping->start_addr) / this->page_sz;
+        for (size_t page_i = first_page; page_i <= last_page; page_i++)
+            mapping->dirty_pages[page_i / 64] |= 1ULL << (page_i % 64);
+    }
+}
+
+void MemoryManager::mark_written(ADDR addr, size_t data_sz)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!data_sz)
+        return;
+    this->mark_dirty(addr, data_sz);
+    ADDR end_addr = addr + data_sz;
+    auto mapping_it = this->mappings.upper_bound(addr);
+    if (mapping_it != this->mappings.begin() && std::prev(mapping_it)->second->end_addr > addr)
+        mapping_it--;
+    for (; mapping_it != this->mappings.end() && mapping_it->first < end_addr; mapping_it++)
+    {
+        std::shared_ptr<ARION_MAPPING> mapping = mapping_it->second;
+        if (!(mapping->perms & 1))
+            continue;
+        // Code written without uc_mem_write may already be translated
+        uc_err uc_rm_cache_err = uc_ctl_remove_cache(arion->uc, std::max(addr, mapping->start_addr),
+                                                     std::min(end_addr, mapping->end_addr));
+        if (uc_rm_cache_err != UC_ERR_OK)
+            throw UnicornCtlException(uc_rm_cache_err);
+    }
+}
+
+bool MemoryManager::handle_dirty_fault(ADDR addr, size_t data_sz)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!this->dirty_tracking || !data_sz)
+        return false;
+
+    ADDR start_addr = addr - addr % this->page_sz;
+    ADDR end_addr = this->align_up(addr + data_sz);
+    std::vector<std::shared_ptr<ARION_MAPPING>> fault_mappings = this->get_mappings_in(start_addr, end_addr);
+    if (fault_mappings.empty())
+        return false;
+    for (std::shared_ptr<ARION_MAPPING> &mapping : fault_mappings)
+    {
+        if (!(mapping->perms & 2))
+            return false;
+    }
+
+    this->mark_dirty(addr, data_sz);
+    // Next writes to these pages no longer need to be caught
+    for (std::shared_ptr<ARION_MAPPING> &mapping : fault_mappings)
+    {
+        ADDR protect_start = std::max(start_addr, mapping->start_addr);
+        ADDR protect_end = std::min(end_addr, mapping->end_addr);
+        uc_err uc_protect_err =
+            uc_mem_protect(arion->uc, protect_start, protect_end - protect_start, this->to_uc_perms(mapping->perms));
+        if (uc_protect_err != UC_ERR_OK)
+            throw UnicornMemProtectException(uc_protect_err);
+    }
+    return true;
+}
+
+void MemoryManager::clear_dirty()
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    for (auto &mapping_it : this->mappings)
+    {
+        std::shared_ptr<ARION_MAPPING> mapping = mapping_it.second;
+        if (mapping->dirty_pages.empty())
+            continue;
+        if (this->dirty_tracking && (mapping->perms & 2))
+        {
+            // Only pages which were written need to be write-protected again
+            size_t pages_count = (mapping->end_addr - mapping->start_addr) / this->page_sz;
+            for (size_t page_i = 0; page_i < pages_count;)
+            {
+                if (!(mapping->dirty_pages[page_i / 64] & (1ULL << (page_i % 64))))
+                {
+                    page_i++;
+                    continue;
+                }
+                size_t run_start = page_i;
+                while (page_i < pages_count && (mapping->dirty_pages[page_i / 64] & (1ULL << (page_i % 64))))
+                    page_i++;
+                uc_err uc_protect_err = uc_mem_protect(arion->uc, mapping->start_addr + run_start * this->page_sz,
+                                                       (page_i - run_start) * this->page_sz,
+                                                       this->to_tracked_uc_perms(mapping->perms));
+                if (uc_protect_err != UC_ERR_OK)
+                    throw UnicornMemProtectException(uc_protect_err);
+            }
+        }
+        mapping->dirty_pages.clear();
+    }
+}
+
+std::vector<std::shared_ptr<ARION_MEM_EDIT>> MemoryManager::get_dirty_ranges()
+{
+    std::vector<std::shared_ptr<ARION_MEM_EDIT>> dirty_ranges;
+    for (auto &mapping_it : this->mappings)
+    {
+        std::shared_ptr<ARION_MAPPING> mapping = mapping_it.second;
+        if (mapping->dirty_pages.empty())
+            continue;
+        size_t pages_count = (mapping->end_addr - mapping->start_addr) / this->page_sz;
+        for (size_t page_i = 0; page_i < pages_count;)
+        {
+            if (!(mapping->dirty_pages[page_i / 64] & (1ULL << (page_i % 64))))
+            {
+                page_i++;
+                continue;
+            }
+            size_t run_start = page_i;
+            while (page_i < pages_count && (mapping->dirty_pages[page_i / 64] & (1ULL << (page_i % 64))))
+                page_i++;
+            ADDR run_addr = mapping->start_addr + run_start * this->page_sz;
+            size_t run_sz = (page_i - run_start) * this->page_sz;
+            // Runs spanning contiguous mappings are merged
+            if (!dirty_ranges.empty() && dirty_ranges.back()->addr + dirty_ranges.back()->sz == run_addr)
+                dirty_ranges.back()->sz += run_sz;
+            else
+                dirty_ranges.push_back(std::make_shared<ARION_MEM_EDIT>(run_addr, run_sz));
+        }
+    }
+    return dirty_ranges;
 }
 
 void MemoryManager::write_string(ADDR addr, std::string data)
@@ -849,6 +1510,35 @@ ADDR MemoryManager::align_up(ADDR addr)
     return addr + this->page_sz - delta;
 }
 
+uint32_t MemoryManager::to_tracked_uc_perms(PROT_FLAGS perms)
+{
+    uint32_t uc_perms = this->to_uc_perms(perms);
+    if (this->dirty_tracking)
+        uc_perms &= ~UC_PROT_WRITE;
+    return uc_perms;
+}
+
+std::vector<uint64_t> MemoryManager::slice_dirty_pages(std::shared_ptr<ARION_MAPPING> mapping, ADDR start_addr,
+                                                       ADDR end_addr)
+{
+    std::vector<uint64_t> dirty_pages;
+    if (mapping->dirty_pages.empty())
+        return dirty_pages;
+
+    dirty_pages.resize(((end_addr - start_addr) / this->page_sz + 63) / 64);
+    ADDR overlap_start = std::max(start_addr, mapping->start_addr);
+    ADDR overlap_end = std::min(end_addr, mapping->end_addr);
+    for (ADDR page_addr = overlap_start; page_addr < overlap_end; page_addr += this->page_sz)
+    {
+        size_t src_i = (page_addr - mapping->start_addr) / this->page_sz;
+        if (!(mapping->dirty_pages[src_i / 64] & (1ULL << (src_i % 64))))
+            continue;
+        size_t dst_i = (page_addr - start_addr) / this->page_sz;
+        dirty_pages[dst_i / 64] |= 1ULL << (dst_i % 64);
+    }
+    return dirty_pages;
+}
+
 uint32_t MemoryManager::to_uc_perms(PROT_FLAGS flags)
 {
     uint32_t perms = 0;
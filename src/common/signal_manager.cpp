@@ -62,6 +62,9 @@ void SignalManager::intr_hook(std::shared_ptr<Arion> arion, uint32_t intno, void
 bool SignalManager::invalid_memory_hook(std::shared_ptr<Arion> arion, uc_mem_type access, uint64_t addr, int size,
                                         int64_t val, void *user_data)
 {
+    // First write to a page since dirty pages tracking started, the write can proceed
+    if (access == UC_MEM_WRITE_PROT && arion->mem->handle_dirty_fault(addr, size))
+        return true;
     arion->send_signal(arion->get_pid(), SIGSEGV);
     arion->sync_threads(); // Since Unicorn 2, returning true is not enough to gracefully recover from memory access
                            // error
@@ -82,14 +85,19 @@ SignalManager::SignalManager(std::weak_ptr<Arion> arion) : arion(arion)
     if (!arion_)
         throw ExpiredWeakPtrException("Arion");
 
-    arion_->hooks->hook_intr(SignalManager::intr_hook);
-    arion_->hooks->hook_mem_read_unmapped(SignalManager::invalid_memory_hook);
-    arion_->hooks->hook_mem_write_unmapped(SignalManager::invalid_memory_hook);
-    arion_->hooks->hook_mem_fetch_unmapped(SignalManager::invalid_memory_hook);
-    arion_->hooks->hook_mem_read_prot(SignalManager::invalid_memory_hook);
-    arion_->hooks->hook_mem_write_prot(SignalManager::invalid_memory_hook);
-    arion_->hooks->hook_mem_fetch_prot(SignalManager::invalid_memory_hook);
-    arion_->hooks->hook_insn_invalid(SignalManager::invalid_insn_hook);
+    std::unique_ptr<HooksManager> &hooks = arion_->hooks;
+    hooks->set_hook_label(hooks->hook_intr(SignalManager::intr_hook), "SignalManager::intr_hook");
+    std::vector<HOOK_ID> invalid_memory_hook_ids = {
+        hooks->hook_mem_read_unmapped(SignalManager::invalid_memory_hook),
+        hooks->hook_mem_write_unmapped(SignalManager::invalid_memory_hook),
+        hooks->hook_mem_fetch_unmapped(SignalManager::invalid_memory_hook),
+        hooks->hook_mem_read_prot(SignalManager::invalid_memory_hook),
+        hooks->hook_mem_write_prot(SignalManager::invalid_memory_hook),
+        hooks->hook_mem_fetch_prot(SignalManager::invalid_memory_hook)};
+    for (HOOK_ID hook_id : invalid_memory_hook_ids)
+        hooks->set_hook_label(hook_id, "SignalManager::invalid_memory_hook");
+    hooks->set_hook_label(hooks->hook_insn_invalid(SignalManager::invalid_insn_hook),
+                          "SignalManager::invalid_insn_hook");
 }
 
 void SignalManager::handle_sigchld(pid_t source_pid)
@@ -113,8 +121,8 @@ void SignalManager::handle_sigchld(pid_t source_pid)
         (target_pid == -1 && arion->has_child(source_pid)) ||
         (target_pid < -1 && arion->has_child(source_pid) && source_instance->get_pgid() == -target_pid))
     {
+        arion->threads->unpark_thread(running_tid);
         std::unique_ptr<ARION_THREAD> arion_t = std::move(arion->threads->threads_map.at(running_tid));
-        arion_t->stopped = false;
         if (arion_t->wait_status_addr)
         {
             arion->mem->write_val(arion_t->wait_status_addr, 0, sizeof(int));
@@ -147,17 +155,18 @@ bool SignalManager::handle_sighandler(pid_t source_pid, int signo)
     arion->arch->write_arch_reg(param_regs.at(0), (uint64_t)signo);
     if (handler->flags & SA_SIGINFO)
     {
-        this->ucontext_regs = std::move(
-            arion->arch->dump_regs()); // For now, clone context registers instead of using ucontext from siginfo_t
-        std::unique_ptr<siginfo_t> info = std::make_unique<siginfo_t>();
-        memset(info.get(), 0, sizeof(siginfo_t));
+        this->ucontext_regs =
+            arion->arch->dump_regs(); // For now, clone context registers instead of using ucontext from siginfo_t
+        this->ucontext_tls = arion->arch->dump_tls();
+        siginfo_t info;
+        memset(&info, 0, sizeof(siginfo_t));
         // TODO : Fill siginfo_t struct with missing fields
-        info->si_signo = signo;
-        info->si_pid = source_pid;
+        info.si_signo = signo;
+        info.si_pid = source_pid;
         uint64_t sp = arion->arch->read_arch_reg(sp_reg);
         sp -= sizeof(siginfo_t);
         arion->arch->write_arch_reg(sp_reg, sp);
-        arion->mem->write(sp, (BYTE *)info.get(), sizeof(siginfo_t));
+        arion->mem->write<siginfo_t>(sp, info);
         arion->arch->write_arch_reg(param_regs.at(1), sp);
         arion->arch->write_arch_reg(param_regs.at(2), 0); // TODO : Provide ucontext here
     }
@@ -175,6 +184,7 @@ bool SignalManager::handle_sighandler(pid_t source_pid, int signo)
             arion->hooks->unhook(*hook_id);
         },
         curr_pc, curr_pc);
+    arion->hooks->set_hook_label(*hook_id, "SignalManager::sighandler_return_hook");
     return true;
 }
 
@@ -298,8 +308,8 @@ void SignalManager::wait_for_sig(pid_t target_tid, pid_t source_pid, ADDR wait_s
 
     if (this->sigwait_list.find(target_tid) != this->sigwait_list.end())
         throw ThreadAlreadySigWaitingException(arion->get_pid(), target_tid);
+    arion->threads->park_thread(target_tid);
     std::unique_ptr<ARION_THREAD> arion_t = std::move(arion->threads->threads_map.at(target_tid));
-    arion_t->stopped = true;
     this->sigwait_list[target_tid] = source_pid;
     arion_t->wait_status_addr = wait_status_addr;
     arion->threads->threads_map[target_tid] = std::move(arion_t);
@@ -335,6 +345,8 @@ bool SignalManager::sigreturn()
 
     if (!this->ucontext_regs)
         return false;
-    arion->arch->load_regs(std::move(this->ucontext_regs));
+    arion->arch->load_regs(*this->ucontext_regs);
+    arion->arch->load_tls(this->ucontext_tls);
+    this->ucontext_regs.reset();
     return true;
 }
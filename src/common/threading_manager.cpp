@@ -3,6 +3,7 @@
 #include <arion/common/global_excepts.hpp>
 #include <arion/common/threading_manager.hpp>
 #include <arion/unicorn/unicorn.h>
+#include <algorithm>
 #include <linux/sched.h>
 #include <memory>
 
@@ -35,6 +36,28 @@ ARION_FUTEX *arion::deserialize_arion_futex(std::vector<BYTE> srz_futex)
     return arion_f;
 }
 
+ARION_THREAD::~ARION_THREAD()
+{
+    if (this->uc_ctxt)
+        uc_context_free(this->uc_ctxt);
+}
+
+void ARION_THREAD::read_uc_ctxt(RegisterFile &regs) const
+{
+    if (!this->uc_ctxt_saved)
+        return;
+    uc_err uc_reg_err = uc_context_reg_read_batch(this->uc_ctxt, regs.get_uc_regs(), regs.get_uc_vals(), regs.count());
+    if (uc_reg_err != UC_ERR_OK)
+        throw UnicornRegReadException(uc_reg_err);
+}
+
+void ARION_THREAD::sync_regs_state()
+{
+    if (!this->regs_state)
+        return;
+    this->read_uc_ctxt(*this->regs_state);
+}
+
 std::vector<BYTE> arion::serialize_arion_thread(ARION_THREAD *arion_t)
 {
     std::vector<BYTE> srz_thread;
@@ -48,14 +71,17 @@ std::vector<BYTE> arion::serialize_arion_thread(ARION_THREAD *arion_t)
                       (BYTE *)&arion_t->child_settid_addr + sizeof(ADDR));
     srz_thread.insert(srz_thread.end(), (BYTE *)&arion_t->parent_tid_addr,
                       (BYTE *)&arion_t->parent_tid_addr + sizeof(ADDR));
+    arion_t->sync_regs_state();
     if (arion_t->regs_state)
     {
-        size_t regs_sz = arion_t->regs_state->size();
+        size_t regs_sz = arion_t->regs_state->count();
         srz_thread.insert(srz_thread.end(), (BYTE *)&regs_sz, (BYTE *)&regs_sz + sizeof(size_t));
-        for (auto &reg : *arion_t->regs_state)
+        for (size_t reg_i = 0; reg_i < regs_sz; reg_i++)
         {
-            srz_thread.insert(srz_thread.end(), (BYTE *)&reg.first, (BYTE *)&reg.first + sizeof(REG));
-            srz_thread.insert(srz_thread.end(), (BYTE *)&reg.second, (BYTE *)&reg.second + sizeof(RVAL));
+            REG reg = arion_t->regs_state->get_reg_at(reg_i);
+            RVAL val = arion_t->regs_state->get_at(reg_i);
+            srz_thread.insert(srz_thread.end(), (BYTE *)&reg, (BYTE *)&reg + sizeof(REG));
+            srz_thread.insert(srz_thread.end(), (BYTE *)&val, (BYTE *)&val + sizeof(RVAL));
         }
     }
     else
@@ -87,7 +113,8 @@ ARION_THREAD *arion::deserialize_arion_thread(std::vector<BYTE> srz_thread)
     off += sizeof(ADDR);
     if (regs_sz)
     {
-        std::unique_ptr<std::map<REG, RVAL>> regs_state = std::make_unique<std::map<REG, RVAL>>();
+        std::vector<REG> regs;
+        std::vector<RVAL> vals;
         off_t regs_end = off + regs_sz * (sizeof(REG) + sizeof(RVAL));
         while (off < regs_end)
         {
@@ -97,9 +124,15 @@ ARION_THREAD *arion::deserialize_arion_thread(std::vector<BYTE> srz_thread)
             RVAL val;
             memcpy(&val, srz_thread.data() + off, sizeof(RVAL));
             off += sizeof(RVAL);
-            regs_state->operator[](reg) = val;
+            regs.push_back(reg);
+            vals.push_back(val);
         }
-        arion_t->regs_state = std::move(regs_state);
+        // Natural register sizes are unknown without an ArchManager, so full-width values are kept
+        std::shared_ptr<REG_FILE_LAYOUT> layout =
+            std::make_shared<REG_FILE_LAYOUT>(regs, std::vector<uint8_t>(regs.size(), sizeof(RVAL)));
+        arion_t->regs_state = std::make_unique<RegisterFile>(layout);
+        for (size_t reg_i = 0; reg_i < vals.size(); reg_i++)
+            arion_t->regs_state->set_at(reg_i, vals.at(reg_i));
     }
     memcpy(&arion_t->tls_addr, srz_thread.data() + off, sizeof(ADDR));
     off += sizeof(ADDR);
@@ -153,6 +186,8 @@ pid_t ThreadingManager::add_thread_entry(std::unique_ptr<ARION_THREAD> thread)
     thread->tid = tid;
     if (!this->threads_map.size())
         this->running_tid = tid;
+    else
+        this->enqueue_thread(thread.get());
     this->threads_map[tid] = std::move(thread);
     return tid;
 }
@@ -163,8 +198,20 @@ void ThreadingManager::remove_thread_entry_internal(pid_t tid, bool clearing)
         throw WrongThreadIdException();
 
     if (tid == this->running_tid && this->threads_map.size() > 1 && !clearing)
+    {
         this->switch_to_next_thread();
+        if (this->running_tid == tid) // Every other thread is stopped, one of them still has to become the running one
+        {
+            auto next_thread_it = this->threads_map.upper_bound(tid);
+            if (next_thread_it == this->threads_map.end())
+                next_thread_it = this->threads_map.begin();
+            this->switch_to_thread(next_thread_it->first);
+        }
+    }
     this->threads_map.erase(tid);
+    auto queued_it = std::find(this->run_queue.begin(), this->run_queue.end(), tid);
+    if (queued_it != this->run_queue.end()) // The ID may be reused by a new thread
+        this->run_queue.erase(queued_it);
     if (this->threads_map.size())
         this->free_thread_ids.push(tid);
     else
@@ -187,6 +234,7 @@ void ThreadingManager::clear_threads()
     for (HOOK_ID hook_id : thread_ids)
         this->remove_thread_entry_internal(hook_id, true);
     this->futex_list.clear();
+    this->run_queue.clear();
 }
 
 pid_t ThreadingManager::clone_thread(uint64_t flags, ADDR new_sp, ADDR new_tls, ADDR child_tid_addr,
@@ -223,8 +271,10 @@ pid_t ThreadingManager::clone_thread(uint64_t flags, ADDR new_sp, ADDR new_tls,
         new_tls = arion->arch->dump_tls();
     else if (arion->arch->get_attrs()->arch == CPU_ARCH::X86_ARCH)
         new_tls = static_cast<arion_x86::ArchManagerX86 *>(arion->arch.get())->new_tls(new_tls);
-    std::unique_ptr<std::map<REG, RVAL>> regs = arion->arch->init_thread_regs(next_pc, new_sp);
-    regs->operator[](ret_reg).r64 = 0;
+    std::unique_ptr<RegisterFile> regs = arion->arch->init_thread_regs(next_pc, new_sp);
+    RVAL ret_val;
+    ret_val.r64 = 0;
+    regs->set(ret_reg, ret_val);
     std::unique_ptr<ARION_THREAD> arion_t = std::make_unique<ARION_THREAD>(
         exit_signal, flags, child_cleartid_addr, child_settid_addr, parent_tid_addr, std::move(regs), new_tls);
 
@@ -306,42 +356,153 @@ void ThreadingManager::switch_to_thread(pid_t tid)
     auto next_thread_it = this->threads_map.find(tid);
     if (next_thread_it == this->threads_map.end())
         throw WrongThreadIdException();
-    std::unique_ptr<ARION_THREAD> curr_thread = std::move(curr_thread_it->second);
-    std::unique_ptr<ARION_THREAD> next_thread = std::move(next_thread_it->second);
+    ARION_THREAD *curr_thread = curr_thread_it->second.get();
+    ARION_THREAD *next_thread = next_thread_it->second.get();
 
-    curr_thread->regs_state = arion->arch->dump_regs();
+    if (!curr_thread->regs_state) // Layout used to extract registers from uc_ctxt when serializing the thread
+        curr_thread->regs_state = arion->arch->new_reg_file();
+    if (!curr_thread->uc_ctxt)
+    {
+        uc_err uc_ctx_err = uc_context_alloc(arion->uc, &curr_thread->uc_ctxt);
+        if (uc_ctx_err != UC_ERR_OK)
+            throw UnicornContextException(uc_ctx_err);
+    }
+    uc_err uc_ctx_err = uc_context_save(arion->uc, curr_thread->uc_ctxt);
+    if (uc_ctx_err != UC_ERR_OK)
+        throw UnicornContextException(uc_ctx_err);
+    curr_thread->uc_ctxt_saved = true;
     curr_thread->tls_addr = arion->arch->dump_tls();
-    arion->arch->load_regs(std::move(next_thread->regs_state));
+    if (next_thread->uc_ctxt_saved)
+    {
+        uc_ctx_err = uc_context_restore(arion->uc, next_thread->uc_ctxt);
+        if (uc_ctx_err != UC_ERR_OK)
+            throw UnicornContextException(uc_ctx_err);
+        next_thread->uc_ctxt_saved = false; // Its latest state is now held by Unicorn itself
+    }
+    else
+        arion->arch->load_regs(*next_thread->regs_state);
     arion->arch->load_tls(next_thread->tls_addr);
 
-    this->threads_map[this->running_tid] = std::move(curr_thread);
-    this->threads_map[tid] = std::move(next_thread);
     this->running_tid = tid;
 }
 
 void ThreadingManager::switch_to_next_thread()
 {
-    auto curr_thread_it = this->threads_map.find(this->running_tid);
-    if (curr_thread_it == this->threads_map.end())
+    while (!this->run_queue.empty())
+    {
+        pid_t tid = this->run_queue.front();
+        this->run_queue.pop_front();
+        auto next_thread_it = this->threads_map.find(tid);
+        if (next_thread_it == this->threads_map.end())
+            continue;
+        ARION_THREAD *next_thread = next_thread_it->second.get();
+        next_thread->queued = false;
+        if (next_thread->stopped || tid == this->running_tid)
+            continue;
+        auto curr_thread_it = this->threads_map.find(this->running_tid);
+        if (curr_thread_it == this->threads_map.end())
+            throw WrongThreadIdException();
+        this->switch_to_thread(tid);
+        this->enqueue_thread(curr_thread_it->second.get());
+        return;
+    }
+}
+
+void ThreadingManager::enqueue_thread(ARION_THREAD *arion_t)
+{
+    if (arion_t->stopped || arion_t->queued || arion_t->tid == this->running_tid)
+        return;
+    arion_t->queued = true;
+    this->run_queue.push_back(arion_t->tid);
+}
+
+void ThreadingManager::rebuild_run_queue()
+{
+    this->run_queue.clear();
+    for (auto &thread_it : this->threads_map)
+        thread_it.second->queued = false;
+    // Threads following the running one are scheduled first, as with a round-robin over threads_map
+    auto running_it = this->threads_map.upper_bound(this->running_tid);
+    for (auto thread_it = running_it; thread_it != this->threads_map.end(); thread_it++)
+        this->enqueue_thread(thread_it->second.get());
+    for (auto thread_it = this->threads_map.begin(); thread_it != running_it; thread_it++)
+        this->enqueue_thread(thread_it->second.get());
+}
+
+void ThreadingManager::park_thread(pid_t tid)
+{
+    auto thread_it = this->threads_map.find(tid);
+    if (thread_it == this->threads_map.end())
         throw WrongThreadIdException();
-    auto next_thread_it = curr_thread_it;
-    next_thread_it++;
-    if (next_thread_it == this->threads_map.end())
-        next_thread_it = this->threads_map.begin();
-    if (next_thread_it == curr_thread_it)
+    thread_it->second->stopped = true; // Its run queue entry, if any, is skipped when dequeued
+}
+
+void ThreadingManager::unpark_thread(pid_t tid)
+{
+    auto thread_it = this->threads_map.find(tid);
+    if (thread_it == this->threads_map.end())
+        throw WrongThreadIdException();
+    thread_it->second->stopped = false;
+    this->enqueue_thread(thread_it->second.get());
+}
+
+static void read_quantum_bounds(std::shared_ptr<Arion> arion, size_t &min_quantum, size_t &max_quantum)
+{
+    min_quantum = arion->config->get_field<size_t>("min_quantum");
+    max_quantum = arion->config->get_field<size_t>("max_quantum");
+    if (!min_quantum || min_quantum > max_quantum)
+        throw InvalidArgumentException("min_quantum");
+}
+
+size_t ThreadingManager::get_quantum()
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!arion->config->get_field<bool>("adaptive_quantum"))
+        return ARION_CYCLES_PER_THREAD;
+    ARION_THREAD *arion_t = this->threads_map.at(this->running_tid).get();
+    if (!arion_t->quantum)
+    {
+        size_t min_quantum, max_quantum;
+        read_quantum_bounds(arion, min_quantum, max_quantum);
+        arion_t->quantum = std::clamp<size_t>(ARION_CYCLES_PER_THREAD, min_quantum, max_quantum);
+    }
+    return arion_t->quantum;
+}
+
+void ThreadingManager::end_time_slice(bool slice_cut)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    bool handoff = this->slice_handoff;
+    this->slice_handoff = false;
+    if (!arion->config->get_field<bool>("adaptive_quantum"))
+        return;
+    auto thread_it = this->threads_map.find(this->running_tid);
+    if (thread_it == this->threads_map.end() || !thread_it->second->quantum)
         return;
-    this->switch_to_thread(next_thread_it->first);
+    ARION_THREAD *arion_t = thread_it->second.get();
+    size_t min_quantum, max_quantum;
+    read_quantum_bounds(arion, min_quantum, max_quantum);
+    if (handoff)
+        arion_t->quantum = std::max<size_t>(arion_t->quantum / 2, min_quantum);
+    else if (!slice_cut && !arion_t->stopped)
+        arion_t->quantum = std::min<size_t>(arion_t->quantum * 2, max_quantum);
 }
 
 void ThreadingManager::futex_wait(pid_t tid, ADDR futex_addr, uint32_t futex_bitmask)
 {
-    std::unique_ptr<ARION_THREAD> arion_t = std::move(this->threads_map.at(tid));
     std::unique_ptr<ARION_FUTEX> futex = std::make_unique<ARION_FUTEX>(futex_addr, futex_bitmask, tid);
     if (this->futex_list.find(futex_addr) == this->futex_list.end())
         this->futex_list[futex_addr] = new std::vector<std::unique_ptr<ARION_FUTEX>>();
     this->futex_list[futex_addr]->push_back(std::move(futex));
-    arion_t->stopped = true;
-    this->threads_map[tid] = std::move(arion_t);
+    this->park_thread(tid);
+    if (tid == this->running_tid)
+        this->slice_handoff = true;
 }
 
 void ThreadingManager::futex_wait_curr(ADDR futex_addr, uint32_t futex_bitmask)
@@ -386,9 +547,7 @@ size_t ThreadingManager::futex_wake(ADDR futex_addr, uint32_t futex_bitmask)
     {
         if (futex->futex_bitmask & futex_bitmask)
         {
-            std::unique_ptr<ARION_THREAD> arion_t = std::move(this->threads_map.at(futex->tid));
-            arion_t->stopped = false;
-            this->threads_map[futex->tid] = std::move(arion_t);
+            this->unpark_thread(futex->tid);
             awaken_count++;
         }
         else
@@ -398,6 +557,8 @@ size_t ThreadingManager::futex_wake(ADDR futex_addr, uint32_t futex_bitmask)
         this->futex_list[futex_addr] = addr_futex;
     else
         this->futex_list.erase(futex_addr);
+    if (awaken_count)
+        this->slice_handoff = true;
     return awaken_count;
 }
 
@@ -409,10 +570,7 @@ bool ThreadingManager::is_curr_locked()
 
     if (arion->is_stopped() || arion->is_zombie())
         return true;
-    std::unique_ptr<ARION_THREAD> arion_t = std::move(this->threads_map.at(running_tid));
-    bool curr_locked = arion_t->stopped;
-    this->threads_map[running_tid] = std::move(arion_t);
-    return curr_locked;
+    return this->threads_map.at(this->running_tid)->stopped;
 }
 
 size_t ThreadingManager::get_threads_count()
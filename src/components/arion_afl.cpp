@@ -16,10 +16,9 @@ bool ArionAfl::uc_input_callback(uc_engine *uc, char *input, size_t input_sz, ui
         switch (hook_param->mem_strategy)
         {
         case ARION_MEM_STRATEGY::RECORD_EDITS:
-            arion->mem->recorder->stop();
+            // Recording keeps going, restored pages are write-protected again when clearing the recorder
             arion->context->restore(hook_param->ctxt, arion->mem->recorder->get_edits());
             arion->mem->recorder->clear();
-            arion->mem->recorder->start();
             break;
         case ARION_MEM_STRATEGY::RESTORE_MAPPINGS:
             arion->context->restore(hook_param->ctxt, true, false);
@@ -27,6 +26,9 @@ bool ArionAfl::uc_input_callback(uc_engine *uc, char *input, size_t input_sz, ui
         case ARION_MEM_STRATEGY::RAW_RESTORE:
             arion->context->restore(hook_param->ctxt, true, true);
             break;
+        case ARION_MEM_STRATEGY::UC_SNAPSHOT:
+            arion->context->restore_snapshot(hook_param->ctxt);
+            break;
         case ARION_MEM_STRATEGY::MANUAL_MANAGEMENT:
         default:
             break;
@@ -73,7 +75,9 @@ void ArionAfl::fuzz(ARION_AFL_INPUT_CALLBACK input_callback, ARION_AFL_CRASH_CAL
     if (!exits.size())
         throw UnicornAflNoExitsException();
     arion->init_afl_mode(signals);
-    std::shared_ptr<ARION_CONTEXT> ctxt = arion->context->save();
+    std::shared_ptr<ARION_CONTEXT> ctxt = mem_strategy == ARION_MEM_STRATEGY::UC_SNAPSHOT
+                                              ? arion->context->save_snapshot()
+                                              : arion->context->save();
     if (mem_strategy == ARION_MEM_STRATEGY::RECORD_EDITS)
         arion->mem->recorder->start();
     struct ARION_AFL_PARAM *param =
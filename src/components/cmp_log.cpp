@@ -0,0 +1,114 @@
+#include <arion/common/global_excepts.hpp>
+#include <arion/components/cmp_log.hpp>
+#include <algorithm>
+#include <cstring>
+
+using namespace arion;
+using namespace arion_exception;
+
+CmpLog::~CmpLog()
+{
+    if (this->started && !this->arion.expired()) // Otherwise all hooks are cleared anyway
+        this->stop();
+}
+
+void CmpLog::cmp_hook(Arion &arion, uint64_t addr, uint64_t arg1, uint64_t arg2, int size, void *user_data)
+{
+    CmpLog *cmp_log = static_cast<CmpLog *>(user_data);
+    uint32_t site_i = get_site_index(addr);
+    ARION_CMP_HEADER &header = cmp_log->map->headers[site_i];
+    uint32_t hits = header.hits;
+    header.hits = hits + 1;
+    header.shape = (size / 8) - 1;
+    cmp_log->sites_pc[site_i] = addr;
+    ARION_CMP_OPERANDS &operands = cmp_log->map->log[site_i][hits & (ARION_CMP_MAP_H - 1)];
+    operands.v0 = arg1;
+    operands.v1 = arg2;
+}
+
+void CmpLog::start(ARION_CMP_MAP *map, ADDR start, ADDR end)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (this->started)
+        throw CmpLogAlreadyStartedException();
+    if (!map)
+    {
+        if (!this->own_map)
+            this->own_map = std::make_unique<ARION_CMP_MAP>();
+        map = this->own_map.get();
+    }
+    this->map = map;
+    this->sites_pc.assign(ARION_CMP_MAP_W, 0);
+    this->hook_id = arion->hooks->hook_tcg_opcode_fast(CmpLog::cmp_hook, UC_TCG_OP_SUB, UC_TCG_OP_FLAG_CMP, start, end,
+                                                       this);
+    arion->hooks->set_hook_label(this->hook_id, "CmpLog::cmp_hook");
+    this->started = true;
+}
+
+void CmpLog::stop()
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!this->started)
+        throw CmpLogAlreadyStoppedException();
+    arion->hooks->unhook(this->hook_id);
+    this->started = false;
+}
+
+bool CmpLog::is_started()
+{
+    return this->started;
+}
+
+void CmpLog::reset()
+{
+    if (this->map)
+        memset(this->map->headers, 0, sizeof(this->map->headers));
+}
+
+const ARION_CMP_MAP *CmpLog::get_map()
+{
+    return this->map;
+}
+
+std::vector<ARION_CMP_ENTRY> CmpLog::get_cmps()
+{
+    std::vector<ARION_CMP_ENTRY> cmps;
+    if (!this->map)
+        return cmps;
+    for (uint32_t site_i = 0; site_i < ARION_CMP_MAP_W; site_i++)
+    {
+        ARION_CMP_HEADER &header = this->map->headers[site_i];
+        if (!header.hits)
+            continue;
+        uint32_t logged = std::min<uint32_t>(header.hits, ARION_CMP_MAP_H);
+        for (uint32_t log_i = 0; log_i < logged; log_i++)
+        {
+            ARION_CMP_OPERANDS &operands = this->map->log[site_i][log_i];
+            cmps.push_back(ARION_CMP_ENTRY{this->sites_pc[site_i], operands.v0, operands.v1,
+                                           (uint8_t)(header.shape + 1)});
+        }
+    }
+    return cmps;
+}
+
+std::vector<ARION_CMP_ENTRY> CmpLog::get_cmps(ADDR pc)
+{
+    std::vector<ARION_CMP_ENTRY> cmps;
+    if (!this->map)
+        return cmps;
+    uint32_t site_i = get_site_index(pc);
+    ARION_CMP_HEADER &header = this->map->headers[site_i];
+    uint32_t logged = std::min<uint32_t>(header.hits, ARION_CMP_MAP_H);
+    for (uint32_t log_i = 0; log_i < logged; log_i++)
+    {
+        ARION_CMP_OPERANDS &operands = this->map->log[site_i][log_i];
+        cmps.push_back(ARION_CMP_ENTRY{pc, operands.v0, operands.v1, (uint8_t)(header.shape + 1)});
+    }
+    return cmps;
+}
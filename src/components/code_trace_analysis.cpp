@@ -1,63 +1,86 @@
+#include <algorithm>
 #include <arion/common/code_tracer.hpp>
 #include <arion/common/global_excepts.hpp>
 #include <arion/components/code_trace_analysis.hpp>
+#include <arion/utils/convert_utils.hpp>
 #include <cstdint>
+#include <cstring>
+#include <fcntl.h>
 #include <filesystem>
 #include <iostream>
 #include <memory>
+#include <sys/mman.h>
+#include <unistd.h>
 
 using namespace arion;
 using namespace arion_exception;
 
+void CodeTraceReader::read_data(off_t off, void *out, size_t sz)
+{
+    if (off < 0 || off + sz > this->trace_f_sz)
+        throw FileTooSmallException(this->trace_path, this->trace_f_sz, off + sz);
+    memcpy(out, this->trace_data + off, sz);
+}
+
 void CodeTraceReader::read_header()
 {
+    off_t off = 0;
     char magic[sizeof(TRACER_FILE_MAGIC)];
-    this->trace_f.read(magic, sizeof(TRACER_FILE_MAGIC) - 1);
+    this->read_data(off, magic, sizeof(TRACER_FILE_MAGIC) - 1);
+    off += sizeof(TRACER_FILE_MAGIC) - 1;
     if (strncmp(magic, TRACER_FILE_MAGIC, sizeof(TRACER_FILE_MAGIC) - 1))
         throw WrongTraceFileMagicException(this->trace_path);
-    this->trace_f.read((char *)&this->version, sizeof(float));
+    this->read_data(off, &this->version, sizeof(float));
+    off += sizeof(float);
     if (this->version > TRACER_FILE_VERSION)
         throw NewerTraceFileVersionException(this->trace_path);
-    this->trace_f.read((char *)&this->mode, sizeof(TRACE_MODE));
+    this->read_data(off, &this->mode, sizeof(TRACE_MODE));
+    off += sizeof(TRACE_MODE);
     if (this->mode >= TRACE_MODE::UNKNOWN)
         throw UnknownTraceModeException();
-    this->trace_f.read((char *)&this->total_hits, sizeof(size_t));
-    this->trace_f.read((char *)&this->secs_table_off, sizeof(off_t));
+    this->read_data(off, &this->total_hits, sizeof(size_t));
+    off += sizeof(size_t);
+    this->read_data(off, &this->secs_table_off, sizeof(off_t));
 }
 
 void CodeTraceReader::read_sections_table()
 {
-    this->trace_f.seekg(this->secs_table_off);
-    this->trace_f.read((char *)&this->mod_sec_off, sizeof(off_t));
-    this->trace_f.read((char *)&this->regs_sec_off, sizeof(off_t));
-    this->trace_f.read((char *)&this->data_sec_off, sizeof(off_t));
+    off_t off = this->secs_table_off;
+    this->read_data(off, &this->mod_sec_off, sizeof(off_t));
+    this->read_data(off + sizeof(off_t), &this->regs_sec_off, sizeof(off_t));
+    this->read_data(off + sizeof(off_t) * 2, &this->data_sec_off, sizeof(off_t));
+    if (this->version >= 2)
+        this->read_data(off + sizeof(off_t) * 3, &this->chunks_sec_off, sizeof(off_t));
 }
 
 void CodeTraceReader::read_modules_section()
 {
-    this->trace_f.seekg(this->mod_sec_off);
+    off_t off = this->mod_sec_off;
     uint16_t mappings_sz;
-    this->trace_f.read((char *)&mappings_sz, sizeof(uint16_t));
+    this->read_data(off, &mappings_sz, sizeof(uint16_t));
+    off += sizeof(uint16_t);
     for (uint16_t mod_id = 0; mod_id < mappings_sz; mod_id++)
     {
         std::unique_ptr<TRACE_MODULE> module = std::make_unique<TRACE_MODULE>();
         module->mod_id = mod_id;
         uint16_t mapping_name_len;
-        this->trace_f.read((char *)&mapping_name_len, sizeof(uint16_t));
-        char *mapping_name = (char *)malloc(mapping_name_len);
-        this->trace_f.read(mapping_name, mapping_name_len);
-        module->name = std::string(mapping_name, mapping_name_len);
-        free(mapping_name);
-        this->trace_f.read((char *)&module->start, sizeof(ADDR));
+        this->read_data(off, &mapping_name_len, sizeof(uint16_t));
+        off += sizeof(uint16_t);
+        module->name.resize(mapping_name_len);
+        this->read_data(off, module->name.data(), mapping_name_len);
+        off += mapping_name_len;
+        this->read_data(off, &module->start, sizeof(ADDR));
+        off += sizeof(ADDR);
         uint32_t mapping_len;
-        this->trace_f.read((char *)&mapping_len, sizeof(mapping_len));
+        this->read_data(off, &mapping_len, sizeof(mapping_len));
+        off += sizeof(mapping_len);
         module->end = module->start + mapping_len;
         uint16_t mod_hash_len;
-        this->trace_f.read((char *)&mod_hash_len, sizeof(uint16_t));
-        char *mod_hash = (char *)malloc(mod_hash_len);
-        this->trace_f.read(mod_hash, mod_hash_len);
-        module->hash = std::string(mod_hash, mod_hash_len);
-        free(mod_hash);
+        this->read_data(off, &mod_hash_len, sizeof(uint16_t));
+        off += sizeof(uint16_t);
+        module->hash.resize(mod_hash_len);
+        this->read_data(off, module->hash.data(), mod_hash_len);
+        off += mod_hash_len;
         this->modules[mod_id] = std::move(module);
     }
 }
@@ -67,112 +90,311 @@ void CodeTraceReader::read_regs_section()
     if (!this->regs_sec_off)
         return;
 
-    this->trace_f.seekg(this->regs_sec_off);
+    off_t off = this->regs_sec_off;
     size_t ctxt_regs_sz;
-    this->trace_f.read((char *)&ctxt_regs_sz, sizeof(size_t));
-    REG reg;
-    for (size_t reg_i = 0; reg_i < ctxt_regs_sz; reg_i++)
+    this->read_data(off, &ctxt_regs_sz, sizeof(size_t));
+    off += sizeof(size_t);
+    this->ctxt_regs.resize(ctxt_regs_sz);
+    this->read_data(off, this->ctxt_regs.data(), ctxt_regs_sz * sizeof(REG));
+    off += ctxt_regs_sz * sizeof(REG);
+    if (this->version >= 2)
     {
-        this->trace_f.read((char *)&reg, sizeof(REG));
-        this->ctxt_regs.push_back(reg);
+        this->ctxt_regs_sz.resize(ctxt_regs_sz);
+        this->read_data(off, this->ctxt_regs_sz.data(), ctxt_regs_sz * sizeof(uint8_t));
     }
 }
 
+void CodeTraceReader::read_chunks_section()
+{
+    if (this->version < 2)
+        return;
+
+    off_t off = this->chunks_sec_off;
+    uint64_t chunks_sz;
+    this->read_data(off, &chunks_sz, sizeof(uint64_t));
+    off += sizeof(uint64_t);
+    this->chunks.resize(chunks_sz);
+    this->read_data(off, this->chunks.data(), chunks_sz * sizeof(TRACER_CHUNK));
+}
+
 void CodeTraceReader::prepare_file()
 {
     this->read_header();
     this->read_sections_table();
     this->read_modules_section();
     this->read_regs_section();
-    this->trace_f.seekg(this->data_sec_off);
+    this->read_chunks_section();
+    this->last_regs.assign(this->ctxt_regs.size(), RVAL{});
+    this->last_hit = {0, 0, 0, this->ctxt_regs.size() ? this->last_regs.data() : nullptr};
+    if (this->version < 2)
+    {
+        this->hit_sz = sizeof(TRACER_HIT) + sizeof(RVAL) * this->ctxt_regs.size();
+        this->fixed_regs_order.resize(this->ctxt_regs.size());
+        for (size_t reg_i = 0; reg_i < this->fixed_regs_order.size(); reg_i++)
+            this->fixed_regs_order[reg_i] = reg_i;
+        std::sort(this->fixed_regs_order.begin(), this->fixed_regs_order.end(),
+                  [this](size_t reg_i1, size_t reg_i2) { return this->ctxt_regs[reg_i1] < this->ctxt_regs[reg_i2]; });
+        if (this->data_sec_off + this->total_hits * this->hit_sz > this->trace_f_sz)
+            throw FileTooSmallException(this->trace_path, this->trace_f_sz,
+                                        this->data_sec_off + this->total_hits * this->hit_sz);
+    }
+    this->reset_hit_cursor();
+}
+
+void CodeTraceReader::load_chunk(size_t chunk_i)
+{
+    this->chunk_i = chunk_i;
+    off_t off = this->chunks.at(chunk_i).off;
+    TRACER_CHUNK_HEADER header;
+    this->read_data(off, &header, sizeof(TRACER_CHUNK_HEADER));
+    off += sizeof(TRACER_CHUNK_HEADER);
+    if ((size_t)off + header.data_sz > this->trace_f_sz)
+        throw FileTooSmallException(this->trace_path, this->trace_f_sz, off + header.data_sz);
+    this->chunk_hits = header.hits;
+    this->chunk_data = this->trace_data + off;
+    this->chunk_data_sz = header.data_sz;
+    this->chunk_pos = 0;
+    this->last_hit.off = 0;
+    this->last_hit.sz = 0;
+    this->last_hit.mod_id = 0;
+    std::fill(this->last_regs.begin(), this->last_regs.end(), RVAL{});
+}
+
+void CodeTraceReader::check_chunk_data(size_t sz)
+{
+    if (this->chunk_pos + sz <= this->chunk_data_sz)
+        return;
+    off_t data_off = this->chunk_data - this->trace_data;
+    throw FileTooSmallException(this->trace_path, data_off + this->chunk_data_sz, data_off + this->chunk_pos + sz);
+}
+
+uint64_t CodeTraceReader::read_chunk_varint()
+{
+    size_t start_pos = this->chunk_pos;
+    uint64_t val = decode_varint(this->chunk_data, this->chunk_pos, this->chunk_data_sz);
+    // Decoding stops at the end of the chunk, possibly before the last byte of the value
+    if (this->chunk_pos == start_pos || this->chunk_data[this->chunk_pos - 1] & 0x80)
+        this->check_chunk_data(1);
+    return val;
+}
+
+void CodeTraceReader::decode_hit()
+{
+    uint64_t head = this->read_chunk_varint();
+    int64_t off_delta = decode_zigzag(head >> TRACER_HIT_FLAGS_BITS);
+    this->last_hit.off = (int64_t)this->last_hit.off + this->last_hit.sz + off_delta;
+    if (head & TRACER_HIT_MOD_FLAG)
+        this->last_hit.mod_id = this->read_chunk_varint();
+    if (head & TRACER_HIT_SZ_FLAG)
+        this->last_hit.sz = this->read_chunk_varint();
+    if (this->ctxt_regs.empty())
+        return;
+
+    size_t changed_regs_sz = (this->ctxt_regs.size() + 7) / 8;
+    this->check_chunk_data(changed_regs_sz);
+    const BYTE *changed_regs = this->chunk_data + this->chunk_pos;
+    this->chunk_pos += changed_regs_sz;
+    for (size_t reg_i = 0; reg_i < this->ctxt_regs.size(); reg_i++)
+    {
+        if (!(changed_regs[reg_i / 8] & (1 << (reg_i % 8))))
+            continue;
+        uint8_t reg_sz = this->ctxt_regs_sz.at(reg_i);
+        this->check_chunk_data(reg_sz);
+        memcpy(&this->last_regs[reg_i], this->chunk_data + this->chunk_pos, reg_sz);
+        this->chunk_pos += reg_sz;
+    }
 }
 
-CodeTraceReader::CodeTraceReader(std::string trace_path) : trace_path(trace_path)
+void CodeTraceReader::read_fixed_hit(off_t hit_i)
+{
+    const BYTE *hit_data = this->trace_data + this->data_sec_off + hit_i * this->hit_sz;
+    TRACER_HIT hit;
+    memcpy(&hit, hit_data, sizeof(TRACER_HIT));
+    this->last_hit.off = hit.off;
+    this->last_hit.sz = hit.sz;
+    this->last_hit.mod_id = hit.mod_id;
+    // Registers are copied as their alignment in the mapping is not guaranteed
+    const BYTE *regs_data = hit_data + sizeof(TRACER_HIT);
+    for (size_t val_i = 0; val_i < this->fixed_regs_order.size(); val_i++)
+        memcpy(&this->last_regs[this->fixed_regs_order[val_i]], regs_data + val_i * sizeof(RVAL), sizeof(RVAL));
+}
+
+std::unique_ptr<CODE_HIT> CodeTraceReader::make_hit(const CODE_HIT_VIEW *view)
+{
+    if (!view)
+        return nullptr;
+    std::unique_ptr<CODE_HIT> hit = std::make_unique<CODE_HIT>(view->off, view->sz, view->mod_id);
+    hit->regs = std::make_unique<std::map<REG, RVAL>>();
+    for (size_t reg_i = 0; reg_i < this->ctxt_regs.size(); reg_i++)
+        hit->regs->operator[](this->ctxt_regs[reg_i]) = view->regs[reg_i];
+    return hit;
+}
+
+CodeTraceReader::CodeTraceReader(std::string trace_path, bool use_index) : trace_path(trace_path), use_index(use_index)
 {
     if (!std::filesystem::exists(trace_path))
         throw FileNotFoundException(trace_path);
-    this->trace_f.open(trace_path, std::ios::binary | std::ios::in);
-    if (!this->trace_f.is_open())
-        throw FileOpenException(trace_path);
     this->trace_f_sz = std::filesystem::file_size(trace_path);
     if (this->trace_f_sz < TRACER_FILE_HEADER_SIZE)
         throw FileTooSmallException(this->trace_path, this->trace_f_sz, TRACER_FILE_HEADER_SIZE);
+    int fd = open(trace_path.c_str(), O_RDONLY);
+    if (fd < 0)
+        throw FileOpenException(trace_path);
+    void *trace_data = mmap(nullptr, this->trace_f_sz, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (trace_data == MAP_FAILED)
+        throw FileOpenException(trace_path);
+    // Hits are mostly parsed in order, let the kernel read ahead
+    madvise(trace_data, this->trace_f_sz, MADV_SEQUENTIAL);
+    this->trace_data = (const BYTE *)trace_data;
     this->prepare_file();
-    this->hit_i = 0;
 }
 
-std::unique_ptr<CODE_HIT> CodeTraceReader::curr_hit()
+CodeTraceReader::~CodeTraceReader()
+{
+    if (this->trace_data)
+        munmap((void *)this->trace_data, this->trace_f_sz);
+}
+
+const CODE_HIT_VIEW *CodeTraceReader::curr_hit_view()
 {
-    if (this->hit_i >= this->total_hits)
+    if ((size_t)this->hit_i >= this->total_hits)
         return nullptr;
 
     if (this->hit_i >= 1)
-    {
-        this->trace_f.seekg((off_t)this->trace_f.tellg() -
-                            (sizeof(uint32_t) + sizeof(uint16_t) * 2 + sizeof(RVAL) * this->ctxt_regs.size()));
-        this->hit_i--;
-    }
-    return std::move(this->next_hit());
+        return &this->last_hit;
+    return this->next_hit_view();
 }
 
-std::unique_ptr<CODE_HIT> CodeTraceReader::next_hit()
+const CODE_HIT_VIEW *CodeTraceReader::next_hit_view()
 {
-    if (this->hit_i >= this->total_hits)
+    if ((size_t)this->hit_i >= this->total_hits)
         return nullptr;
-    std::unique_ptr<CODE_HIT> hit = std::make_unique<CODE_HIT>();
-    this->trace_f.read((char *)&hit->off, sizeof(uint32_t));
-    this->trace_f.read((char *)&hit->sz, sizeof(uint16_t));
-    this->trace_f.read((char *)&hit->mod_id, sizeof(uint16_t));
-    hit->regs = std::make_unique<std::map<REG, RVAL>>();
-    for (REG reg : this->ctxt_regs)
+
+    if (this->version >= 2)
     {
-        RVAL rval;
-        this->trace_f.read((char *)&rval, sizeof(RVAL));
-        hit->regs->operator[](reg) = rval;
+        if ((uint64_t)this->hit_i >= this->chunks.at(this->chunk_i).first_hit + this->chunk_hits)
+            this->load_chunk(this->chunk_i + 1);
+        this->decode_hit();
     }
+    else
+        this->read_fixed_hit(this->hit_i);
     this->hit_i++;
-    return hit;
+    return &this->last_hit;
 }
 
-std::unique_ptr<CODE_HIT> CodeTraceReader::next_mod_hit(uint16_t mod_id)
+const CODE_HIT_VIEW *CodeTraceReader::next_mod_hit_view(uint16_t mod_id)
 {
-    if (this->hit_i >= this->total_hits)
-        return nullptr;
-
-    std::unique_ptr<CODE_HIT> hit;
-    while ((hit = this->next_hit()))
+    const CODE_HIT_VIEW *hit;
+    while ((hit = this->next_hit_view()))
         if (hit->mod_id == mod_id)
             return hit;
 
     return nullptr;
 }
 
+const CODE_HIT_VIEW *CodeTraceReader::seek_hit_view(off_t hit_i)
+{
+    if (hit_i < 0 || (size_t)hit_i >= this->total_hits)
+    {
+        this->hit_i = hit_i;
+        return nullptr;
+    }
+
+    if (this->version >= 2)
+    {
+        auto chunk_it =
+            std::upper_bound(this->chunks.begin(), this->chunks.end(), (uint64_t)hit_i,
+                             [](uint64_t hit_i, const TRACER_CHUNK &chunk) { return hit_i < chunk.first_hit; });
+        size_t chunk_i = chunk_it - this->chunks.begin() - 1;
+        uint64_t first_hit = this->chunks.at(chunk_i).first_hit;
+        // Decoding can resume from the current hit if it is in the same chunk and not after the requested one
+        if (chunk_i != this->chunk_i || !this->hit_i || this->hit_i - 1 > hit_i)
+            this->load_chunk(chunk_i);
+        else
+            first_hit = this->hit_i;
+        for (uint64_t chunk_hit_i = first_hit; chunk_hit_i <= (uint64_t)hit_i; chunk_hit_i++)
+            this->decode_hit();
+    }
+    else
+        this->read_fixed_hit(hit_i);
+    this->hit_i = hit_i + 1;
+    return &this->last_hit;
+}
+
+std::unique_ptr<CODE_HIT> CodeTraceReader::curr_hit()
+{
+    return this->make_hit(this->curr_hit_view());
+}
+
+std::unique_ptr<CODE_HIT> CodeTraceReader::next_hit()
+{
+    return this->make_hit(this->next_hit_view());
+}
+
+std::unique_ptr<CODE_HIT> CodeTraceReader::next_mod_hit(uint16_t mod_id)
+{
+    return this->make_hit(this->next_mod_hit_view(mod_id));
+}
+
 std::unique_ptr<CODE_HIT> CodeTraceReader::reach_addr(arion::ADDR addr)
 {
-    std::unique_ptr<CODE_HIT> hit = this->curr_hit();
+    const CODE_HIT_VIEW *hit = this->curr_hit_view();
     if (!hit)
         return nullptr;
 
+    CodeTraceIndex *index = this->get_index();
+    if (index)
+    {
+        off_t from_hit_i = this->hit_i - 1, found_hit_i = -1;
+        for (TRACE_MODULE *mod : this->find_modules_from_addr(addr))
+        {
+            const TRACE_INDEX_KEY *key = index->find_key(mod->mod_id, addr - mod->start);
+            off_t key_hit_i = key ? index->next_hit(key, from_hit_i) : -1;
+            if (key_hit_i >= 0 && (found_hit_i < 0 || key_hit_i < found_hit_i))
+                found_hit_i = key_hit_i;
+        }
+        if (found_hit_i < 0)
+        {
+            this->seek_hit_view(this->total_hits);
+            return nullptr;
+        }
+        return this->make_hit(this->seek_hit_view(found_hit_i));
+    }
+
     do
     {
-        std::unique_ptr<TRACE_MODULE> mod = this->get_module(hit->mod_id);
+        TRACE_MODULE *mod = this->peek_module(hit->mod_id);
         if (mod->start + hit->off == addr)
-            return std::move(hit);
-    } while ((hit = this->next_hit()));
+            return this->make_hit(hit);
+    } while ((hit = this->next_hit_view()));
     return nullptr;
 }
 
 std::unique_ptr<CODE_HIT> CodeTraceReader::reach_off(uint16_t mod_id, uint32_t off)
 {
-    std::unique_ptr<CODE_HIT> hit = this->curr_hit();
+    const CODE_HIT_VIEW *hit = this->curr_hit_view();
     if (!hit)
         return nullptr;
 
+    CodeTraceIndex *index = this->get_index();
+    if (index)
+    {
+        const TRACE_INDEX_KEY *key = index->find_key(mod_id, off);
+        off_t found_hit_i = key ? index->next_hit(key, this->hit_i - 1) : -1;
+        if (found_hit_i < 0)
+        {
+            this->seek_hit_view(this->total_hits);
+            return nullptr;
+        }
+        return this->make_hit(this->seek_hit_view(found_hit_i));
+    }
+
     do
     {
         if (hit->off == off)
-            return std::move(hit);
-    } while ((hit = this->next_mod_hit(mod_id)));
+            return this->make_hit(hit);
+    } while ((hit = this->next_mod_hit_view(mod_id)));
     return nullptr;
 }
 
@@ -183,16 +405,35 @@ off_t CodeTraceReader::get_hit_index()
 
 void CodeTraceReader::set_hit_index(off_t hit_i)
 {
-    this->hit_i = hit_i;
-    this->trace_f.seekg(this->data_sec_off +
-                        (sizeof(uint32_t) + sizeof(uint16_t) * 2 + sizeof(RVAL) * this->ctxt_regs.size()) * hit_i);
-    this->next_hit();
+    this->seek_hit_view(hit_i);
 }
 
 void CodeTraceReader::reset_hit_cursor()
 {
     this->hit_i = 0;
-    this->trace_f.seekg(this->data_sec_off);
+    if (this->version >= 2 && this->chunks.size())
+        this->load_chunk(0);
+}
+
+size_t CodeTraceReader::get_total_hits()
+{
+    return this->total_hits;
+}
+
+CodeTraceIndex *CodeTraceReader::get_index()
+{
+    if (!this->use_index)
+        return nullptr;
+    if (!this->index)
+    {
+        off_t hit_i = this->hit_i;
+        this->index = std::make_unique<CodeTraceIndex>(this->trace_path, *this);
+        if (hit_i > 0)
+            this->seek_hit_view(hit_i - 1);
+        else
+            this->reset_hit_cursor();
+    }
+    return this->index.get();
 }
 
 TRACE_MODE CodeTraceReader::get_mode()
@@ -201,13 +442,17 @@ TRACE_MODE CodeTraceReader::get_mode()
 }
 
 std::unique_ptr<TRACE_MODULE> CodeTraceReader::get_module(uint16_t mod_id)
+{
+    return std::make_unique<TRACE_MODULE>(this->peek_module(mod_id));
+}
+
+TRACE_MODULE *CodeTraceReader::peek_module(uint16_t mod_id)
 {
     auto mod_it = this->modules.find(mod_id);
     if (mod_it == this->modules.end())
         throw UnknownTraceModuleIdException(this->trace_path, mod_id);
 
-    std::unique_ptr<TRACE_MODULE> mod = std::make_unique<TRACE_MODULE>(mod_it->second.get());
-    return std::move(mod);
+    return mod_it->second.get();
 }
 
 std::unique_ptr<TRACE_MODULE> CodeTraceReader::find_module_from_name(std::string name)
@@ -223,6 +468,15 @@ std::unique_ptr<TRACE_MODULE> CodeTraceReader::find_module_from_name(std::string
     throw UnknownTraceModuleNameException(this->trace_path, name);
 }
 
+std::vector<TRACE_MODULE *> CodeTraceReader::find_modules_from_addr(ADDR addr)
+{
+    std::vector<TRACE_MODULE *> mods;
+    for (auto &mod_it : this->modules)
+        if (addr >= mod_it.second->start && addr < mod_it.second->end)
+            mods.push_back(mod_it.second.get());
+    return mods;
+}
+
 std::unique_ptr<TRACE_MODULE> CodeTraceReader::find_module_from_hash(std::string hash)
 {
     for (auto &mod_it : this->modules)
@@ -237,7 +491,33 @@ bool CodeTraceReader::has_reg(REG reg)
     return std::find(this->ctxt_regs.begin(), this->ctxt_regs.end(), reg) != this->ctxt_regs.end();
 }
 
-CodeTraceAnalyzer::CodeTraceAnalyzer(std::string trace_path) : reader(trace_path)
+const std::vector<REG> &CodeTraceReader::get_context_regs()
+{
+    return this->ctxt_regs;
+}
+
+size_t CodeTraceReader::get_reg_index(REG reg)
+{
+    auto reg_it = std::find(this->ctxt_regs.begin(), this->ctxt_regs.end(), reg);
+    if (reg_it == this->ctxt_regs.end())
+        throw UnknownTraceRegException(reg);
+    return reg_it - this->ctxt_regs.begin();
+}
+
+/**
+ * Builds a new ANALYSIS_HIT from the view over the current hit of a reader.
+ * @param[in] reader The CodeTraceReader which read the hit.
+ * @param[in] hit The hit view.
+ * @return The new ANALYSIS_HIT instance.
+ */
+static std::unique_ptr<ANALYSIS_HIT> make_analysis_hit(CodeTraceReader &reader, const CODE_HIT_VIEW *hit)
+{
+    std::unique_ptr<CODE_HIT> code_hit = reader.make_hit(hit);
+    return std::make_unique<ANALYSIS_HIT>(reader.get_hit_index(), reader.peek_module(hit->mod_id)->name, hit->off,
+                                          hit->sz, code_hit->regs.get());
+}
+
+CodeTraceAnalyzer::CodeTraceAnalyzer(std::string trace_path, bool use_index) : reader(trace_path, use_index)
 {
 }
 
@@ -259,12 +539,22 @@ void CodeTraceAnalyzer::loop_on_every_hit(ANALYZER_HIT_CALLBACK callback, bool r
 {
     if (reset_cursor)
         this->reader.reset_hit_cursor();
-    std::unique_ptr<CODE_HIT> hit;
-    while ((hit = this->reader.next_hit()))
+    const CODE_HIT_VIEW *hit;
+    while ((hit = this->reader.next_hit_view()))
+    {
+        if (!callback(make_analysis_hit(this->reader, hit)))
+            return;
+    }
+}
+
+void CodeTraceAnalyzer::loop_on_every_hit_view(ANALYZER_HIT_VIEW_CALLBACK callback, bool reset_cursor)
+{
+    if (reset_cursor)
+        this->reader.reset_hit_cursor();
+    const CODE_HIT_VIEW *hit;
+    while ((hit = this->reader.next_hit_view()))
     {
-        std::unique_ptr<TRACE_MODULE> mod = this->reader.get_module(hit->mod_id);
-        if (!callback(std::make_unique<ANALYSIS_HIT>(this->reader.get_hit_index(), mod->name, hit->off, hit->sz,
-                                                     hit->regs.get())))
+        if (!callback(this->reader.get_hit_index(), *this->reader.peek_module(hit->mod_id), *hit))
             return;
     }
 }
@@ -274,11 +564,10 @@ void CodeTraceAnalyzer::loop_on_every_mod_hit(ANALYZER_HIT_CALLBACK callback, st
     if (reset_cursor)
         this->reader.reset_hit_cursor();
     std::unique_ptr<TRACE_MODULE> mod = this->reader.find_module_from_name(name);
-    std::unique_ptr<CODE_HIT> hit;
-    while ((hit = this->reader.next_mod_hit(mod->mod_id)))
+    const CODE_HIT_VIEW *hit;
+    while ((hit = this->reader.next_mod_hit_view(mod->mod_id)))
     {
-        if (!callback(std::make_unique<ANALYSIS_HIT>(this->reader.get_hit_index(), mod->name, hit->off, hit->sz,
-                                                     hit->regs.get())))
+        if (!callback(make_analysis_hit(this->reader, hit)))
             return;
     }
 }
@@ -287,16 +576,42 @@ void CodeTraceAnalyzer::search_hit_address(ANALYZER_HIT_CALLBACK callback, ADDR
 {
     if (reset_cursor)
         this->reader.reset_hit_cursor();
-    std::unique_ptr<CODE_HIT> hit;
-    while ((hit = this->reader.next_hit()))
+    CodeTraceIndex *index = this->reader.get_index();
+    if (index)
     {
-        std::unique_ptr<TRACE_MODULE> mod = this->reader.get_module(hit->mod_id);
+        // Hits are only read at the indices where one of the candidate keys was hit
+        off_t from_hit_i = this->reader.get_hit_index() + 1;
+        std::vector<off_t> hits_i;
+        for (TRACE_MODULE *mod : this->reader.find_modules_from_addr(addr))
+        {
+            for (const TRACE_INDEX_KEY *key : index->find_keys_containing(mod->mod_id, addr - mod->start))
+            {
+                std::vector<off_t> key_hits_i = index->get_hits(key, from_hit_i);
+                hits_i.insert(hits_i.end(), key_hits_i.begin(), key_hits_i.end());
+            }
+        }
+        std::sort(hits_i.begin(), hits_i.end());
+        for (off_t hit_i : hits_i)
+        {
+            const CODE_HIT_VIEW *hit = this->reader.seek_hit_view(hit_i);
+            ADDR hit_addr_start = this->reader.peek_module(hit->mod_id)->start + hit->off;
+            if (addr < hit_addr_start || addr >= hit_addr_start + hit->sz)
+                continue;
+            if (!callback(make_analysis_hit(this->reader, hit)))
+                return;
+        }
+        this->reader.set_hit_index(this->reader.get_total_hits());
+        return;
+    }
+    const CODE_HIT_VIEW *hit;
+    while ((hit = this->reader.next_hit_view()))
+    {
+        TRACE_MODULE *mod = this->reader.peek_module(hit->mod_id);
         ADDR hit_addr_start = mod->start + hit->off;
         ADDR hit_addr_end = hit_addr_start + hit->sz;
         if (addr >= hit_addr_start && addr < hit_addr_end)
         {
-            if (!callback(std::make_unique<ANALYSIS_HIT>(this->reader.get_hit_index(), mod->name, hit->off, hit->sz,
-                                                         hit->regs.get())))
+            if (!callback(make_analysis_hit(this->reader, hit)))
                 return;
         }
     }
@@ -307,18 +622,46 @@ void CodeTraceAnalyzer::search_hit_address_range(ANALYZER_HIT_CALLBACK callback,
 {
     if (reset_cursor)
         this->reader.reset_hit_cursor();
-    std::unique_ptr<CODE_HIT> hit;
-    while ((hit = this->reader.next_hit()))
+    auto is_in_range = [start_addr, end_addr](ADDR hit_addr_start, ADDR hit_addr_end) {
+        return (hit_addr_start >= start_addr && hit_addr_start < end_addr) ||
+               (hit_addr_end > start_addr && hit_addr_end <= end_addr) ||
+               (start_addr >= hit_addr_start && start_addr < hit_addr_end);
+    };
+    CodeTraceIndex *index = this->reader.get_index();
+    if (index)
     {
-        std::unique_ptr<TRACE_MODULE> mod = this->reader.get_module(hit->mod_id);
-        ADDR hit_addr_start = mod->start + hit->off;
-        ADDR hit_addr_end = hit_addr_start + hit->sz;
-        if ((hit_addr_start >= start_addr && hit_addr_start < end_addr) ||
-            (hit_addr_end > start_addr && hit_addr_end <= end_addr) ||
-            (start_addr >= hit_addr_start && start_addr < hit_addr_end))
+        // Blocks of hits whose address bounds do not intersect the range are skipped without being read
+        off_t from_hit_i = this->reader.get_hit_index() + 1;
+        const std::vector<TRACE_INDEX_BLOCK> &blocks = index->get_blocks();
+        for (size_t block_i = from_hit_i / ARION_TRACE_INDEX_BLOCK_HITS; block_i < blocks.size(); block_i++)
+        {
+            const TRACE_INDEX_BLOCK &block = blocks[block_i];
+            if (block.min_addr >= end_addr || block.max_addr < start_addr)
+                continue;
+            off_t first_hit_i = std::max<off_t>(from_hit_i, block_i * ARION_TRACE_INDEX_BLOCK_HITS);
+            off_t last_hit_i =
+                std::min<off_t>(this->reader.get_total_hits(), (block_i + 1) * ARION_TRACE_INDEX_BLOCK_HITS);
+            for (off_t hit_i = first_hit_i; hit_i < last_hit_i; hit_i++)
+            {
+                const CODE_HIT_VIEW *hit =
+                    hit_i == first_hit_i ? this->reader.seek_hit_view(hit_i) : this->reader.next_hit_view();
+                ADDR hit_addr_start = this->reader.peek_module(hit->mod_id)->start + hit->off;
+                if (!is_in_range(hit_addr_start, hit_addr_start + hit->sz))
+                    continue;
+                if (!callback(make_analysis_hit(this->reader, hit)))
+                    return;
+            }
+        }
+        this->reader.set_hit_index(this->reader.get_total_hits());
+        return;
+    }
+    const CODE_HIT_VIEW *hit;
+    while ((hit = this->reader.next_hit_view()))
+    {
+        ADDR hit_addr_start = this->reader.peek_module(hit->mod_id)->start + hit->off;
+        if (is_in_range(hit_addr_start, hit_addr_start + hit->sz))
         {
-            if (!callback(std::make_unique<ANALYSIS_HIT>(this->reader.get_hit_index(), mod->name, hit->off, hit->sz,
-                                                         hit->regs.get())))
+            if (!callback(make_analysis_hit(this->reader, hit)))
                 return;
         }
     }
@@ -341,8 +684,13 @@ void CodeTraceAnalyzer::search_hit_offset_range(ANALYZER_HIT_CALLBACK callback,
     this->search_hit_address_range(callback, start_addr, end_addr, reset_cursor);
 }
 
-CodeTraceComparator::CodeTraceComparator(std::string trace_path1, std::string trace_path2)
-    : reader1(trace_path1), reader2(trace_path2)
+size_t CodeTraceAnalyzer::get_reg_index(REG reg)
+{
+    return this->reader.get_reg_index(reg);
+}
+
+CodeTraceComparator::CodeTraceComparator(std::string trace_path1, std::string trace_path2, bool use_index)
+    : reader1(trace_path1, use_index), reader2(trace_path2, use_index)
 {
     if (reader1.get_mode() != reader2.get_mode())
         throw DifferentTraceModesException();
@@ -371,28 +719,28 @@ void CodeTraceComparator::search_uneq_hit_offset(COMPARATOR_HIT_CALLBACK callbac
         this->reader2.reset_hit_cursor();
     }
 
-    std::unique_ptr<CODE_HIT> hit1;
-    std::unique_ptr<CODE_HIT> hit2;
+    const CODE_HIT_VIEW *hit1_view;
+    const CODE_HIT_VIEW *hit2_view;
     bool out_of_sync = false;
-    while ((hit1 = this->reader1.next_hit()) && (hit2 = this->reader2.next_hit()))
+    while ((hit1_view = this->reader1.next_hit_view()) && (hit2_view = this->reader2.next_hit_view()))
     {
-        std::unique_ptr<TRACE_MODULE> mod1 = this->reader1.get_module(hit1->mod_id);
-        std::unique_ptr<TRACE_MODULE> mod2 = this->reader2.get_module(hit2->mod_id);
-        if (hit1->off != hit2->off || mod1->hash != mod2->hash)
+        TRACE_MODULE *mod1 = this->reader1.peek_module(hit1_view->mod_id);
+        TRACE_MODULE *mod2 = this->reader2.peek_module(hit2_view->mod_id);
+        if (hit1_view->off != hit2_view->off || mod1->hash != mod2->hash)
         {
-            if (!out_of_sync && !callback(std::make_unique<ANALYSIS_HIT>(this->reader1.get_hit_index(), mod1->name,
-                                                                         hit1->off, hit1->sz, hit1->regs.get()),
-                                          std::make_unique<ANALYSIS_HIT>(this->reader2.get_hit_index(), mod2->name,
-                                                                         hit2->off, hit2->sz, hit2->regs.get())))
+            if (!out_of_sync && !callback(make_analysis_hit(this->reader1, hit1_view),
+                                          make_analysis_hit(this->reader2, hit2_view)))
                 return;
+            // Views are invalidated when the readers move
+            CODE_HIT_VIEW hit1 = *hit1_view, hit2 = *hit2_view;
             out_of_sync = false;
             off_t reader1_saved_i = this->reader1.get_hit_index();
             uint16_t mod1_search_id = this->reader1.find_module_from_hash(mod2->hash)->mod_id;
-            std::unique_ptr<CODE_HIT> _hit1 = this->reader1.reach_off(mod1_search_id, hit2->off);
+            std::unique_ptr<CODE_HIT> _hit1 = this->reader1.reach_off(mod1_search_id, hit2.off);
             off_t reader1_new_i = this->reader1.get_hit_index();
             off_t reader2_saved_i = this->reader2.get_hit_index();
             uint16_t mod2_search_id = this->reader1.find_module_from_hash(mod1->hash)->mod_id;
-            std::unique_ptr<CODE_HIT> _hit2 = this->reader2.reach_off(mod2_search_id, hit1->off);
+            std::unique_ptr<CODE_HIT> _hit2 = this->reader2.reach_off(mod2_search_id, hit1.off);
             off_t reader2_new_i = this->reader2.get_hit_index();
             if (_hit1)
             {
@@ -439,24 +787,25 @@ void CodeTraceComparator::search_uneq_hit_offset_mod(COMPARATOR_HIT_CALLBACK cal
     std::unique_ptr<TRACE_MODULE> mod1 = this->reader1.find_module_from_name(name);
     std::unique_ptr<TRACE_MODULE> mod2 = this->reader2.find_module_from_hash(mod1->hash);
 
-    std::unique_ptr<CODE_HIT> hit1;
-    std::unique_ptr<CODE_HIT> hit2;
+    const CODE_HIT_VIEW *hit1_view;
+    const CODE_HIT_VIEW *hit2_view;
     bool out_of_sync = false;
-    while ((hit1 = this->reader1.next_mod_hit(mod1->mod_id)) && (hit2 = this->reader2.next_mod_hit(mod2->mod_id)))
+    while ((hit1_view = this->reader1.next_mod_hit_view(mod1->mod_id)) &&
+           (hit2_view = this->reader2.next_mod_hit_view(mod2->mod_id)))
     {
-        if (hit1->off != hit2->off)
+        if (hit1_view->off != hit2_view->off)
         {
-            if (!out_of_sync && !callback(std::make_unique<ANALYSIS_HIT>(this->reader1.get_hit_index(), mod1->name,
-                                                                         hit1->off, hit1->sz, hit1->regs.get()),
-                                          std::make_unique<ANALYSIS_HIT>(this->reader2.get_hit_index(), mod2->name,
-                                                                         hit2->off, hit2->sz, hit2->regs.get())))
+            if (!out_of_sync && !callback(make_analysis_hit(this->reader1, hit1_view),
+                                          make_analysis_hit(this->reader2, hit2_view)))
                 return;
+            // Views are invalidated when the readers move
+            CODE_HIT_VIEW hit1 = *hit1_view, hit2 = *hit2_view;
             out_of_sync = false;
             off_t reader1_saved_i = this->reader1.get_hit_index();
-            std::unique_ptr<CODE_HIT> _hit1 = this->reader1.reach_off(mod1->mod_id, hit2->off);
+            std::unique_ptr<CODE_HIT> _hit1 = this->reader1.reach_off(mod1->mod_id, hit2.off);
             off_t reader1_new_i = this->reader1.get_hit_index();
             off_t reader2_saved_i = this->reader2.get_hit_index();
-            std::unique_ptr<CODE_HIT> _hit2 = this->reader2.reach_off(mod2->mod_id, hit1->off);
+            std::unique_ptr<CODE_HIT> _hit2 = this->reader2.reach_off(mod2->mod_id, hit1.off);
             off_t reader2_new_i = this->reader2.get_hit_index();
             if (_hit1)
             {
@@ -499,25 +848,20 @@ void ARION_EXPORT CodeTraceComparator::search_uneq_reg(COMPARATOR_HIT_CALLBACK c
         this->reader2.reset_hit_cursor();
     }
 
-    std::unique_ptr<CODE_HIT> hit1;
-    std::unique_ptr<CODE_HIT> hit2;
-    while ((hit1 = this->reader1.next_hit()) && (hit2 = this->reader2.next_hit()))
-    {
-        std::unique_ptr<TRACE_MODULE> mod1 = this->reader1.get_module(hit1->mod_id);
-        std::unique_ptr<TRACE_MODULE> mod2 = this->reader2.get_module(hit2->mod_id);
+    const std::vector<REG> &ctxt_regs = this->reader1.get_context_regs();
+    std::vector<size_t> regs2_idx;
+    for (REG reg : ctxt_regs)
+        regs2_idx.push_back(this->reader2.get_reg_index(reg));
 
-        for (const auto &[reg, rval1] : *hit1->regs)
+    const CODE_HIT_VIEW *hit1;
+    const CODE_HIT_VIEW *hit2;
+    while ((hit1 = this->reader1.next_hit_view()) && (hit2 = this->reader2.next_hit_view()))
+    {
+        for (size_t reg_i = 0; reg_i < ctxt_regs.size(); reg_i++)
         {
-            auto it = hit2->regs->find(reg);
-            if (it == hit2->regs->end())
-                throw UnknownTraceRegException(reg);
-            const auto &rval2 = it->second;
-            if (memcmp(&rval1.r512, &rval2.r512, sizeof(RVAL512)))
+            if (memcmp(&hit1->regs[reg_i].r512, &hit2->regs[regs2_idx[reg_i]].r512, sizeof(RVAL512)))
             {
-                if (!callback(std::make_unique<ANALYSIS_HIT>(this->reader1.get_hit_index(), mod1->name, hit1->off,
-                                                             hit1->sz, hit1->regs.get()),
-                              std::make_unique<ANALYSIS_HIT>(this->reader2.get_hit_index(), mod2->name, hit2->off,
-                                                             hit2->sz, hit2->regs.get())))
+                if (!callback(make_analysis_hit(this->reader1, hit1), make_analysis_hit(this->reader2, hit2)))
                     return;
                 break;
             }
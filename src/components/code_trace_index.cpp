@@ -0,0 +1,249 @@
+#include <algorithm>
+#include <arion/components/code_trace_analysis.hpp>
+#include <arion/components/code_trace_index.hpp>
+#include <arion/utils/convert_utils.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <unordered_map>
+
+using namespace arion;
+
+/// Entry of a trace index while it is being built.
+struct TRACE_INDEX_BUILD_KEY
+{
+    /// Hit indices, encoded as variable-length deltas.
+    std::vector<BYTE> postings;
+    /// Skip entries, with offsets relative to the start of the postings.
+    std::vector<TRACE_INDEX_SKIP> skips;
+    /// Last hit index added to the postings.
+    uint64_t last_hit_i = 0;
+    /// Number of hits added to the postings.
+    uint64_t count = 0;
+    /// Largest size of the hits.
+    uint16_t max_sz = 0;
+};
+
+CodeTraceIndex::CodeTraceIndex(std::string trace_path, CodeTraceReader &reader)
+    : idx_path(trace_path + TRACE_INDEX_FILE_EXT)
+{
+    this->trace_f_sz = std::filesystem::file_size(trace_path);
+    this->total_hits = reader.get_total_hits();
+    if (this->load(trace_path))
+        return;
+    this->build(reader);
+    this->save();
+}
+
+bool CodeTraceIndex::load(std::string trace_path)
+{
+    std::error_code err;
+    if (!std::filesystem::exists(this->idx_path, err) || err)
+        return false;
+    std::filesystem::file_time_type idx_time = std::filesystem::last_write_time(this->idx_path, err);
+    if (err)
+        return false;
+    std::filesystem::file_time_type trace_time = std::filesystem::last_write_time(trace_path, err);
+    if (err || idx_time < trace_time)
+        return false;
+
+    std::ifstream idx_f(this->idx_path, std::ios::binary | std::ios::in);
+    if (!idx_f.is_open())
+        return false;
+    char magic[sizeof(TRACE_INDEX_FILE_MAGIC)];
+    uint32_t version;
+    uint64_t trace_f_sz, total_hits;
+    idx_f.read(magic, sizeof(TRACE_INDEX_FILE_MAGIC) - 1);
+    idx_f.read((char *)&version, sizeof(uint32_t));
+    idx_f.read((char *)&trace_f_sz, sizeof(uint64_t));
+    idx_f.read((char *)&total_hits, sizeof(uint64_t));
+    if (!idx_f || strncmp(magic, TRACE_INDEX_FILE_MAGIC, sizeof(TRACE_INDEX_FILE_MAGIC) - 1) ||
+        version != TRACE_INDEX_FILE_VERSION || trace_f_sz != this->trace_f_sz || total_hits != this->total_hits)
+        return false;
+
+    uint64_t blocks_sz, keys_sz, postings_sz, skips_sz;
+    idx_f.read((char *)&this->max_sz, sizeof(uint16_t));
+    idx_f.read((char *)&blocks_sz, sizeof(uint64_t));
+    if (!idx_f || blocks_sz != (this->total_hits + ARION_TRACE_INDEX_BLOCK_HITS - 1) / ARION_TRACE_INDEX_BLOCK_HITS)
+        return false;
+    this->blocks.resize(blocks_sz);
+    idx_f.read((char *)this->blocks.data(), blocks_sz * sizeof(TRACE_INDEX_BLOCK));
+    idx_f.read((char *)&keys_sz, sizeof(uint64_t));
+    if (!idx_f || keys_sz > this->total_hits)
+        return false;
+    this->keys.resize(keys_sz);
+    idx_f.read((char *)this->keys.data(), keys_sz * sizeof(TRACE_INDEX_KEY));
+    idx_f.read((char *)&postings_sz, sizeof(uint64_t));
+    if (!idx_f || postings_sz > this->total_hits * ARION_MAX_VARINT_SZ)
+        return false;
+    this->postings.resize(postings_sz);
+    idx_f.read((char *)this->postings.data(), postings_sz);
+    idx_f.read((char *)&skips_sz, sizeof(uint64_t));
+    if (!idx_f || skips_sz > this->total_hits / ARION_TRACE_INDEX_SKIP_POSTINGS)
+        return false;
+    this->skips.resize(skips_sz);
+    idx_f.read((char *)this->skips.data(), skips_sz * sizeof(TRACE_INDEX_SKIP));
+    if (!idx_f)
+        return false;
+    for (TRACE_INDEX_KEY &key : this->keys)
+    {
+        uint64_t key_skips_sz = key.count ? (key.count - 1) / ARION_TRACE_INDEX_SKIP_POSTINGS : 0;
+        if (key.postings_off > postings_sz || key.skips_off > skips_sz || key_skips_sz > skips_sz - key.skips_off)
+            return false;
+    }
+    return true;
+}
+
+void CodeTraceIndex::build(CodeTraceReader &reader)
+{
+    std::unordered_map<uint64_t, TRACE_INDEX_BUILD_KEY> build_keys;
+    this->blocks.assign((this->total_hits + ARION_TRACE_INDEX_BLOCK_HITS - 1) / ARION_TRACE_INDEX_BLOCK_HITS,
+                        TRACE_INDEX_BLOCK{ARION_MAX_U64, 0});
+    this->max_sz = 0;
+
+    reader.reset_hit_cursor();
+    const CODE_HIT_VIEW *hit;
+    uint64_t hit_i = 0;
+    BYTE delta[ARION_MAX_VARINT_SZ];
+    while ((hit = reader.next_hit_view()))
+    {
+        TRACE_INDEX_BUILD_KEY &build_key = build_keys[((uint64_t)hit->mod_id << 32) | hit->off];
+        if (build_key.count && !(build_key.count % ARION_TRACE_INDEX_SKIP_POSTINGS))
+            build_key.skips.push_back(TRACE_INDEX_SKIP{build_key.last_hit_i, build_key.postings.size()});
+        size_t delta_sz = encode_varint(hit_i - build_key.last_hit_i, delta);
+        build_key.postings.insert(build_key.postings.end(), delta, delta + delta_sz);
+        build_key.last_hit_i = hit_i;
+        build_key.count++;
+        build_key.max_sz = std::max(build_key.max_sz, hit->sz);
+        this->max_sz = std::max(this->max_sz, hit->sz);
+
+        ADDR hit_addr = reader.peek_module(hit->mod_id)->start + hit->off;
+        TRACE_INDEX_BLOCK &block = this->blocks[hit_i / ARION_TRACE_INDEX_BLOCK_HITS];
+        block.min_addr = std::min(block.min_addr, hit_addr);
+        block.max_addr = std::max(block.max_addr, hit_addr + hit->sz);
+        hit_i++;
+    }
+
+    this->keys.clear();
+    for (auto &build_key_it : build_keys)
+        this->keys.push_back(TRACE_INDEX_KEY{0, 0, build_key_it.second.count, (uint32_t)build_key_it.first,
+                                             (uint16_t)(build_key_it.first >> 32), build_key_it.second.max_sz});
+    std::sort(this->keys.begin(), this->keys.end(), [](const TRACE_INDEX_KEY &key1, const TRACE_INDEX_KEY &key2) {
+        return key1.mod_id < key2.mod_id || (key1.mod_id == key2.mod_id && key1.off < key2.off);
+    });
+    this->postings.clear();
+    this->skips.clear();
+    for (TRACE_INDEX_KEY &key : this->keys)
+    {
+        TRACE_INDEX_BUILD_KEY &build_key = build_keys.at(((uint64_t)key.mod_id << 32) | key.off);
+        key.postings_off = this->postings.size();
+        key.skips_off = this->skips.size();
+        for (TRACE_INDEX_SKIP &skip : build_key.skips)
+            this->skips.push_back(TRACE_INDEX_SKIP{skip.hit_i, key.postings_off + skip.postings_off});
+        this->postings.insert(this->postings.end(), build_key.postings.begin(), build_key.postings.end());
+    }
+}
+
+void CodeTraceIndex::save()
+{
+    std::ofstream idx_f(this->idx_path, std::ios::binary | std::ios::out);
+    if (!idx_f.is_open())
+        return;
+    idx_f.write(TRACE_INDEX_FILE_MAGIC, strlen(TRACE_INDEX_FILE_MAGIC));
+    idx_f.write((char *)&TRACE_INDEX_FILE_VERSION, sizeof(uint32_t));
+    idx_f.write((char *)&this->trace_f_sz, sizeof(uint64_t));
+    idx_f.write((char *)&this->total_hits, sizeof(uint64_t));
+    idx_f.write((char *)&this->max_sz, sizeof(uint16_t));
+    uint64_t blocks_sz = this->blocks.size();
+    idx_f.write((char *)&blocks_sz, sizeof(uint64_t));
+    idx_f.write((char *)this->blocks.data(), blocks_sz * sizeof(TRACE_INDEX_BLOCK));
+    uint64_t keys_sz = this->keys.size();
+    idx_f.write((char *)&keys_sz, sizeof(uint64_t));
+    idx_f.write((char *)this->keys.data(), keys_sz * sizeof(TRACE_INDEX_KEY));
+    uint64_t postings_sz = this->postings.size();
+    idx_f.write((char *)&postings_sz, sizeof(uint64_t));
+    idx_f.write((char *)this->postings.data(), postings_sz);
+    uint64_t skips_sz = this->skips.size();
+    idx_f.write((char *)&skips_sz, sizeof(uint64_t));
+    idx_f.write((char *)this->skips.data(), skips_sz * sizeof(TRACE_INDEX_SKIP));
+    idx_f.close();
+    if (!idx_f)
+        std::filesystem::remove(this->idx_path);
+}
+
+const TRACE_INDEX_KEY *CodeTraceIndex::find_key(uint16_t mod_id, uint32_t off)
+{
+    auto key_it = std::lower_bound(this->keys.begin(), this->keys.end(), std::make_pair(mod_id, off),
+                                   [](const TRACE_INDEX_KEY &key, const std::pair<uint16_t, uint32_t> &mod_off) {
+                                       return std::make_pair(key.mod_id, key.off) < mod_off;
+                                   });
+    if (key_it == this->keys.end() || key_it->mod_id != mod_id || key_it->off != off)
+        return nullptr;
+    return &*key_it;
+}
+
+std::vector<const TRACE_INDEX_KEY *> CodeTraceIndex::find_keys_containing(uint16_t mod_id, uint32_t off)
+{
+    std::vector<const TRACE_INDEX_KEY *> found_keys;
+    uint32_t min_off = off >= this->max_sz ? off - this->max_sz + 1 : 0;
+    auto key_it = std::lower_bound(this->keys.begin(), this->keys.end(), std::make_pair(mod_id, min_off),
+                                   [](const TRACE_INDEX_KEY &key, const std::pair<uint16_t, uint32_t> &mod_off) {
+                                       return std::make_pair(key.mod_id, key.off) < mod_off;
+                                   });
+    for (; key_it != this->keys.end() && key_it->mod_id == mod_id && key_it->off <= off; key_it++)
+        if ((uint64_t)key_it->off + key_it->max_sz > off)
+            found_keys.push_back(&*key_it);
+    return found_keys;
+}
+
+size_t CodeTraceIndex::seek_postings(const TRACE_INDEX_KEY *key, off_t from_hit_i, uint64_t &hit_i,
+                                     uint64_t &posting_i)
+{
+    hit_i = 0;
+    posting_i = 0;
+    uint64_t key_skips_sz = key->count ? (key->count - 1) / ARION_TRACE_INDEX_SKIP_POSTINGS : 0;
+    auto skips_begin = this->skips.begin() + key->skips_off;
+    auto skips_end = skips_begin + key_skips_sz;
+    // Every posting before a skip entry whose hit index is lower than from_hit_i can be skipped
+    auto skip_it = std::lower_bound(skips_begin, skips_end, from_hit_i, [](const TRACE_INDEX_SKIP &skip, off_t hit_i) {
+        return (off_t)skip.hit_i < hit_i;
+    });
+    if (skip_it == skips_begin)
+        return key->postings_off;
+    skip_it--;
+    hit_i = skip_it->hit_i;
+    posting_i = (skip_it - skips_begin + 1) * ARION_TRACE_INDEX_SKIP_POSTINGS;
+    return skip_it->postings_off;
+}
+
+off_t CodeTraceIndex::next_hit(const TRACE_INDEX_KEY *key, off_t from_hit_i)
+{
+    uint64_t hit_i, posting_i;
+    size_t pos = this->seek_postings(key, from_hit_i, hit_i, posting_i);
+    for (; posting_i < key->count; posting_i++)
+    {
+        hit_i += decode_varint(this->postings.data(), pos, this->postings.size());
+        if ((off_t)hit_i >= from_hit_i)
+            return hit_i;
+    }
+    return -1;
+}
+
+std::vector<off_t> CodeTraceIndex::get_hits(const TRACE_INDEX_KEY *key, off_t from_hit_i)
+{
+    std::vector<off_t> hits;
+    uint64_t hit_i, posting_i;
+    size_t pos = this->seek_postings(key, from_hit_i, hit_i, posting_i);
+    for (; posting_i < key->count; posting_i++)
+    {
+        hit_i += decode_varint(this->postings.data(), pos, this->postings.size());
+        if ((off_t)hit_i >= from_hit_i)
+            hits.push_back(hit_i);
+    }
+    return hits;
+}
+
+const std::vector<TRACE_INDEX_BLOCK> &CodeTraceIndex::get_blocks()
+{
+    return this->blocks;
+}
@@ -0,0 +1,115 @@
+#include <arion/common/global_excepts.hpp>
+#include <arion/components/edge_coverage.hpp>
+#include <cstring>
+
+using namespace arion;
+using namespace arion_exception;
+
+EdgeCoverage::~EdgeCoverage()
+{
+    if (this->started && !this->arion.expired()) // Otherwise all hooks are cleared anyway
+        this->stop();
+}
+
+void EdgeCoverage::block_hook(Arion &arion, ADDR addr, size_t sz, void *user_data)
+{
+    EdgeCoverage *coverage = static_cast<EdgeCoverage *>(user_data);
+    uint32_t cur_loc = get_block_loc(addr, coverage->bitmap_sz);
+    uint8_t &hits = coverage->bitmap[cur_loc ^ coverage->prev_loc];
+    hits += 1 + (hits == 0xFF); // AFL++ NeverZero, a wrapping counter would hide the edge
+    coverage->prev_loc = cur_loc >> 1;
+}
+
+void EdgeCoverage::start(uint8_t *bitmap, size_t bitmap_sz, ADDR start, ADDR end)
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (this->started)
+        throw EdgeCoverageAlreadyStartedException();
+    if (!bitmap_sz || (bitmap_sz & (bitmap_sz - 1)))
+        throw WrongCoverageMapSizeException(bitmap_sz);
+    if (bitmap)
+        this->own_bitmap.clear();
+    else
+    {
+        this->own_bitmap.assign(bitmap_sz, 0);
+        bitmap = this->own_bitmap.data();
+    }
+    this->bitmap = bitmap;
+    this->bitmap_sz = bitmap_sz;
+    this->prev_loc = 0;
+    this->hook_id = arion->hooks->hook_block_fast(EdgeCoverage::block_hook, start, end, this);
+    arion->hooks->set_hook_label(this->hook_id, "EdgeCoverage::block_hook");
+    this->started = true;
+}
+
+void EdgeCoverage::stop()
+{
+    std::shared_ptr<Arion> arion = this->arion.lock();
+    if (!arion)
+        throw ExpiredWeakPtrException("Arion");
+
+    if (!this->started)
+        throw EdgeCoverageAlreadyStoppedException();
+    arion->hooks->unhook(this->hook_id);
+    this->started = false;
+}
+
+bool EdgeCoverage::is_started()
+{
+    return this->started;
+}
+
+void EdgeCoverage::reset()
+{
+    if (this->bitmap)
+        memset(this->bitmap, 0, this->bitmap_sz);
+    this->prev_loc = 0;
+}
+
+void EdgeCoverage::reset_prev_loc()
+{
+    this->prev_loc = 0;
+}
+
+const uint8_t *EdgeCoverage::get_bitmap()
+{
+    return this->bitmap;
+}
+
+size_t EdgeCoverage::get_bitmap_size()
+{
+    return this->bitmap_sz;
+}
+
+std::map<uint32_t, uint8_t> EdgeCoverage::get_edge_hits()
+{
+    std::map<uint32_t, uint8_t> edge_hits;
+    for (size_t edge_i = 0; edge_i < this->bitmap_sz; edge_i++)
+    {
+        if (this->bitmap[edge_i])
+            edge_hits[edge_i] = this->bitmap[edge_i];
+    }
+    return edge_hits;
+}
+
+uint8_t EdgeCoverage::get_edge_hits(ADDR prev_addr, ADDR cur_addr)
+{
+    if (!this->bitmap)
+        return 0;
+    uint32_t prev_loc = get_block_loc(prev_addr, this->bitmap_sz) >> 1;
+    return this->bitmap[get_block_loc(cur_addr, this->bitmap_sz) ^ prev_loc];
+}
+
+size_t EdgeCoverage::count_edges()
+{
+    size_t edges_count = 0;
+    for (size_t edge_i = 0; edge_i < this->bitmap_sz; edge_i++)
+    {
+        if (this->bitmap[edge_i])
+            edges_count++;
+    }
+    return edges_count;
+}
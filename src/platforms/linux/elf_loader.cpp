@@ -248,11 +248,11 @@ void ElfLoader::init_coredump_threads()
         thread = std::move(parsed_thread->thread);
 
         std::unique_ptr<ARION_THREAD> arion_t = std::make_unique<ARION_THREAD>(
-            0, 0, 0, 0, 0, std::make_unique<std::map<arion::REG, arion::RVAL>>(parsed_thread->regs), 0);
+            0, 0, 0, 0, 0, arion->arch->new_reg_file(parsed_thread->regs), 0);
         if (first_thread)
         {
             first_thread = false;
-            arion->arch->load_regs(std::move(arion_t->regs_state));
+            arion->arch->load_regs(*arion_t->regs_state);
             arion->threads->set_running_tid(arion_t->tid);
         }
         arion->threads->add_thread_entry(std::move(arion_t));
@@ -619,7 +619,7 @@ void LinuxSyscallManager::process_syscall(std::shared_ptr<Arion> arion)
         func_params.push_back(param_val);
     }
     bool syscall_handled = false;
-    arion->hooks->trigger_arion_hook(ARION_HOOK_TYPE::SYSCALL_HOOK, sysno, func_params, &syscall_handled);
+    arion->hooks->trigger_syscall_hook(sysno, func_params, &syscall_handled);
     uint64_t syscall_ret;
     bool cancel = false;
     if (!syscall_handled)
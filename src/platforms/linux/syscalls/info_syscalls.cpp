@@ -110,14 +110,12 @@ uint64_t arion::sys_capget(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
         return EINVAL;
     struct __user_cap_header_struct *header_struct =
         (struct __user_cap_header_struct *)malloc(sizeof(struct __user_cap_header_struct));
-    std::vector<BYTE> header_content = arion->mem->read(hdrp, sizeof(struct __user_cap_header_struct));
-    memcpy(header_struct, header_content.data(), sizeof(struct __user_cap_header_struct));
+    arion->mem->read_into(hdrp, header_struct, sizeof(struct __user_cap_header_struct));
     struct __user_cap_data_struct *data_struct = nullptr;
     if (data)
     {
         data_struct = (struct __user_cap_data_struct *)malloc(sizeof(struct __user_cap_data_struct));
-        std::vector<BYTE> data_content = arion->mem->read(data, sizeof(struct __user_cap_data_struct));
-        memcpy(data_struct, data_content.data(), sizeof(struct __user_cap_data_struct));
+        arion->mem->read_into(data, data_struct, sizeof(struct __user_cap_data_struct));
     }
 
     uint64_t capget_ret = syscall(SYS_capget, header_struct, data_struct);
@@ -133,7 +133,6 @@ uint64_t arion::sys_read(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> pa
     bool is_file = arion->fs->has_file_entry(fd);
     if (!is_file && !arion->sock->has_socket_entry(fd))
         return EBADF;
-    void *buf = malloc(count);
     int arion_fd;
     bool blocking;
     if (is_file)
@@ -160,12 +159,21 @@ uint64_t arion::sys_read(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> pa
         }
     }
 
+    // Read straight into guest memory when it is backed by host memory
+    BYTE *buf = arion->mem->view(buf_addr, count);
+    std::vector<BYTE> tmp_buf;
+    if (!buf)
+    {
+        tmp_buf.resize(count);
+        buf = tmp_buf.data();
+    }
     ssize_t read_ret = read(arion_fd, buf, count);
     if (read_ret == -1)
         read_ret = -errno;
+    else if (tmp_buf.size())
+        arion->mem->write(buf_addr, buf, read_ret);
     else
-        arion->mem->write(buf_addr, (BYTE *)buf, read_ret);
-    free(buf);
+        arion->mem->mark_written(buf_addr, read_ret);
     return read_ret;
 }
 
@@ -178,7 +186,6 @@ uint64_t arion::sys_write(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> p
     bool is_file = arion->fs->has_file_entry(fd);
     if (!is_file && !arion->sock->has_socket_entry(fd))
         return EBADF;
-    std::vector<BYTE> buf = arion->mem->read(buf_addr, count);
     int arion_fd;
     bool blocking;
     if (is_file)
@@ -205,7 +212,15 @@ uint64_t arion::sys_write(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> p
         }
     }
 
-    ssize_t write_ret = write(arion_fd, buf.data(), buf.size());
+    // Write straight from guest memory when it is backed by host memory
+    BYTE *buf = arion->mem->view(buf_addr, count);
+    std::vector<BYTE> tmp_buf;
+    if (!buf)
+    {
+        tmp_buf = arion->mem->read(buf_addr, count);
+        buf = tmp_buf.data();
+    }
+    ssize_t write_ret = write(arion_fd, buf, count);
     if (write_ret == -1)
         write_ret = -errno;
     return write_ret;
@@ -347,8 +362,7 @@ uint64_t arion::sys_poll(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> pa
     struct pollfd *fds = (struct pollfd *)calloc(sizeof(struct pollfd), nfds);
     for (size_t fd_i = 0; fd_i < nfds; fd_i++)
     {
-        std::vector<BYTE> poll_fd = arion->mem->read(fds_addr + sizeof(struct pollfd) * fd_i, sizeof(struct pollfd));
-        memcpy(&fds[fd_i], poll_fd.data(), poll_fd.size());
+        arion->mem->read_into(fds_addr + sizeof(struct pollfd) * fd_i, &fds[fd_i], sizeof(struct pollfd));
         bool is_file = arion->fs->has_file_entry(fds[fd_i].fd);
         if (!is_file && !arion->sock->has_socket_entry(fds[fd_i].fd))
             return EBADF;
@@ -644,8 +658,7 @@ uint64_t arion::sys_writev(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
             iov[iov_i].iov_len =
                 arion->mem->read_sz(iov_arr_addr + offsetof(struct iovec, iov_len) + sizeof(struct iovec) * iov_i);
             iov[iov_i].iov_base = malloc(iov[iov_i].iov_len);
-            std::vector<BYTE> iov_data = arion->mem->read(iov_base, iov[iov_i].iov_len);
-            memcpy(iov[iov_i].iov_base, iov_data.data(), iov_data.size());
+            arion->mem->read_into(iov_base, iov[iov_i].iov_base, iov[iov_i].iov_len);
         }
         break;
     }
@@ -656,8 +669,7 @@ uint64_t arion::sys_writev(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
             iov[iov_i].iov_len =
                 arion->mem->read_sz(iov_arr_addr + offsetof(struct iovec32, iov_len) + sizeof(struct iovec32) * iov_i);
             iov[iov_i].iov_base = malloc(iov[iov_i].iov_len);
-            std::vector<BYTE> iov_data = arion->mem->read(iov_base, iov[iov_i].iov_len);
-            memcpy(iov[iov_i].iov_base, iov_data.data(), iov_data.size());
+            arion->mem->read_into(iov_base, iov[iov_i].iov_base, iov[iov_i].iov_len);
         }
         break;
     }
@@ -711,26 +723,22 @@ uint64_t arion::sys_select(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
 
     if (inp_addr)
     {
-        std::vector<BYTE> inp_data = arion->mem->read(inp_addr, sizeof(fd_set));
-        memcpy(inp, inp_data.data(), sizeof(fd_set));
+        arion->mem->read_into(inp_addr, inp, sizeof(fd_set));
     }
     if (outp_addr)
     {
-        std::vector<BYTE> outp_data = arion->mem->read(outp_addr, sizeof(fd_set));
-        memcpy(outp, outp_data.data(), sizeof(fd_set));
+        arion->mem->read_into(outp_addr, outp, sizeof(fd_set));
     }
     if (exp_addr)
     {
-        std::vector<BYTE> exp_data = arion->mem->read(exp_addr, sizeof(fd_set));
-        memcpy(exp, exp_data.data(), sizeof(fd_set));
+        arion->mem->read_into(exp_addr, exp, sizeof(fd_set));
     }
 
     struct timeval *tsv = nullptr;
     if (tsv_addr)
     {
         struct timeval timeout;
-        std::vector<BYTE> tsv_data = arion->mem->read(tsv_addr, sizeof(struct timeval));
-        memcpy(&timeout, tsv_data.data(), sizeof(struct timeval));
+        arion->mem->read_into(tsv_addr, &timeout, sizeof(struct timeval));
         tsv = &timeout;
     }
 
@@ -1071,14 +1079,14 @@ uint64_t arion::sys_sendmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
         return EBADF;
     std::shared_ptr<ARION_SOCKET> arion_s = arion->sock->get_arion_socket(fd);
     struct msghdr *msg = (struct msghdr *)malloc(sizeof(struct msghdr));
-    memcpy(msg, arion->mem->read(msg_addr, sizeof(struct msghdr)).data(), sizeof(struct msghdr));
+    arion->mem->read_into(msg_addr, msg, sizeof(struct msghdr));
     bool has_addr = msg->msg_name && msg->msg_namelen;
     ADDR msg_name_addr;
     if (has_addr)
     {
         msg_name_addr = (ADDR)msg->msg_name;
         msg->msg_name = malloc(msg->msg_namelen);
-        memcpy(msg->msg_name, arion->mem->read(msg_name_addr, msg->msg_namelen).data(), msg->msg_namelen);
+        arion->mem->read_into(msg_name_addr, msg->msg_name, msg->msg_namelen);
         manage_pre_socket_conn(arion, (struct sockaddr *)msg->msg_name, msg->msg_namelen);
     }
     bool has_iov = msg->msg_iov && msg->msg_iovlen;
@@ -1087,7 +1095,7 @@ uint64_t arion::sys_sendmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
         size_t iov_arr_sz = sizeof(struct iovec) * msg->msg_iovlen;
         ADDR msg_iov_addr = (ADDR)msg->msg_iov;
         msg->msg_iov = (struct iovec *)malloc(iov_arr_sz);
-        memcpy(msg->msg_iov, arion->mem->read(msg_iov_addr, iov_arr_sz).data(), iov_arr_sz);
+        arion->mem->read_into(msg_iov_addr, msg->msg_iov, iov_arr_sz);
         for (size_t msg_i = 0; msg_i < msg->msg_iovlen; msg_i++)
         {
             struct iovec *iov = &msg->msg_iov[msg_i];
@@ -1096,7 +1104,7 @@ uint64_t arion::sys_sendmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
             ADDR iov_base_addr = (ADDR)iov->iov_base;
             iov->iov_base = malloc(iov->iov_len);
             memset(iov->iov_base, 0, iov->iov_len);
-            memcpy(iov->iov_base, arion->mem->read(iov_base_addr, iov->iov_len).data(), iov->iov_len);
+            arion->mem->read_into(iov_base_addr, iov->iov_base, iov->iov_len);
         }
     }
     bool has_control = msg->msg_control && msg->msg_controllen;
@@ -1104,7 +1112,7 @@ uint64_t arion::sys_sendmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
     {
         ADDR msg_control_addr = (ADDR)msg->msg_control;
         msg->msg_control = malloc(msg->msg_controllen);
-        memcpy(msg->msg_control, arion->mem->read(msg_control_addr, msg->msg_controllen).data(), msg->msg_controllen);
+        arion->mem->read_into(msg_control_addr, msg->msg_control, msg->msg_controllen);
     }
 
     bool thread_blocking_io = arion->config->get_field<bool>("thread_blocking_io");
@@ -1150,14 +1158,14 @@ uint64_t arion::sys_recvmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
         return EBADF;
     std::shared_ptr<ARION_SOCKET> arion_s = arion->sock->get_arion_socket(fd);
     struct msghdr *msg = (struct msghdr *)malloc(sizeof(struct msghdr));
-    memcpy(msg, arion->mem->read(msg_addr, sizeof(struct msghdr)).data(), sizeof(struct msghdr));
+    arion->mem->read_into(msg_addr, msg, sizeof(struct msghdr));
     bool has_addr = msg->msg_name && msg->msg_namelen;
     ADDR msg_name_addr;
     if (has_addr)
     {
         msg_name_addr = (ADDR)msg->msg_name;
         msg->msg_name = malloc(msg->msg_namelen);
-        memcpy(msg->msg_name, arion->mem->read((ADDR)msg_name_addr, msg->msg_namelen).data(), msg->msg_namelen);
+        arion->mem->read_into((ADDR)msg_name_addr, msg->msg_name, msg->msg_namelen);
         manage_pre_socket_conn(arion, (struct sockaddr *)msg->msg_name, msg->msg_namelen);
     }
     bool has_iov = msg->msg_iov && msg->msg_iovlen;
@@ -1167,7 +1175,7 @@ uint64_t arion::sys_recvmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
         size_t iov_arr_sz = sizeof(struct iovec) * msg->msg_iovlen;
         ADDR msg_iov_addr = (ADDR)msg->msg_iov;
         msg->msg_iov = (struct iovec *)malloc(iov_arr_sz);
-        memcpy(msg->msg_iov, arion->mem->read(msg_iov_addr, iov_arr_sz).data(), iov_arr_sz);
+        arion->mem->read_into(msg_iov_addr, msg->msg_iov, iov_arr_sz);
         for (size_t msg_i = 0; msg_i < msg->msg_iovlen; msg_i++)
         {
             struct iovec *iov = &msg->msg_iov[msg_i];
@@ -1185,7 +1193,7 @@ uint64_t arion::sys_recvmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
     {
         msg_control_addr = (ADDR)msg->msg_control;
         msg->msg_control = malloc(msg->msg_controllen);
-        memcpy(msg->msg_control, arion->mem->read(msg_control_addr, msg->msg_controllen).data(), msg->msg_controllen);
+        arion->mem->read_into(msg_control_addr, msg->msg_control, msg->msg_controllen);
     }
 
     bool thread_blocking_io = arion->config->get_field<bool>("thread_blocking_io");
@@ -1416,8 +1424,7 @@ uint64_t arion::sys_getsockopt(std::shared_ptr<Arion> arion, std::vector<SYS_PAR
     if (!arion->sock->has_socket_entry(fd))
         return EBADF;
     std::shared_ptr<ARION_SOCKET> arion_s = arion->sock->get_arion_socket(fd);
-    std::vector<BYTE> opt_len_vec = arion->mem->read(opt_len_addr, sizeof(socklen_t));
-    socklen_t opt_len = *((socklen_t *)opt_len_vec.data());
+    socklen_t opt_len = arion->mem->read<socklen_t>(opt_len_addr);
     BYTE *opt_val = (BYTE *)malloc(opt_len);
     int getsockopt_ret = getsockopt(arion_s->fd, level, opt_name, opt_val, &opt_len);
     if (getsockopt_ret == -1)
@@ -1425,7 +1432,7 @@ uint64_t arion::sys_getsockopt(std::shared_ptr<Arion> arion, std::vector<SYS_PAR
     else if (!getsockopt_ret)
     {
         arion->mem->write(opt_val_addr, opt_val, opt_len);
-        arion->mem->write(opt_len_addr, (BYTE *)&opt_len, sizeof(socklen_t));
+        arion->mem->write<socklen_t>(opt_len_addr, opt_len);
     }
     free(opt_val);
     return getsockopt_ret;
@@ -1725,13 +1732,20 @@ uint64_t arion::sys_getdents64(std::shared_ptr<Arion> arion, std::vector<SYS_PAR
     ADDR dirent_addr = params.at(1);
     unsigned int count = params.at(2);
 
-    struct linux_dirent *dirent = (struct linux_dirent *)malloc(count);
+    BYTE *dirent = arion->mem->view(dirent_addr, count);
+    std::vector<BYTE> tmp_dirent;
+    if (!dirent)
+    {
+        tmp_dirent.resize(count);
+        dirent = tmp_dirent.data();
+    }
     int getdents64_ret = getdents64(fd, dirent, count);
     if (getdents64_ret == -1)
         getdents64_ret = -errno;
+    else if (tmp_dirent.size())
+        arion->mem->write(dirent_addr, dirent, getdents64_ret);
     else
-        arion->mem->write(dirent_addr, (BYTE *)dirent, count);
-    free(dirent);
+        arion->mem->mark_written(dirent_addr, getdents64_ret);
     return getdents64_ret;
 }
 
@@ -1847,26 +1861,22 @@ uint64_t arion::sys_pselect6(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
 
     if (inp_addr)
     {
-        std::vector<BYTE> inp_data = arion->mem->read(inp_addr, sizeof(fd_set));
-        memcpy(inp, inp_data.data(), sizeof(fd_set));
+        arion->mem->read_into(inp_addr, inp, sizeof(fd_set));
     }
     if (outp_addr)
     {
-        std::vector<BYTE> outp_data = arion->mem->read(outp_addr, sizeof(fd_set));
-        memcpy(outp, outp_data.data(), sizeof(fd_set));
+        arion->mem->read_into(outp_addr, outp, sizeof(fd_set));
     }
     if (exp_addr)
     {
-        std::vector<BYTE> exp_data = arion->mem->read(exp_addr, sizeof(fd_set));
-        memcpy(exp, exp_data.data(), sizeof(fd_set));
+        arion->mem->read_into(exp_addr, exp, sizeof(fd_set));
     }
 
     struct timespec *tsp = nullptr;
     if (tsp_addr)
     {
         struct timespec timeout;
-        std::vector<BYTE> tsp_data = arion->mem->read(tsp_addr, sizeof(struct timespec));
-        memcpy(&timeout, tsp_data.data(), sizeof(struct timespec));
+        arion->mem->read_into(tsp_addr, &timeout, sizeof(struct timespec));
         tsp = &timeout;
     }
 
@@ -1874,8 +1884,7 @@ uint64_t arion::sys_pselect6(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
     if (sig_addr)
     {
         sigset_t sigset;
-        std::vector<BYTE> sig_data = arion->mem->read(sig_addr, sizeof(sigset_t));
-        memcpy(&sigset, sig_data.data(), sizeof(sigset_t));
+        arion->mem->read_into(sig_addr, &sigset, sizeof(sigset_t));
         sigmask = &sigset;
     }
 
@@ -1910,8 +1919,7 @@ uint64_t arion::sys_ppoll(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> p
     struct pollfd *fds = (struct pollfd *)calloc(sizeof(struct pollfd), nfds);
     for (size_t fd_i = 0; fd_i < nfds; fd_i++)
     {
-        std::vector<BYTE> poll_fd = arion->mem->read(fds_addr + sizeof(struct pollfd) * fd_i, sizeof(struct pollfd));
-        memcpy(&fds[fd_i], poll_fd.data(), poll_fd.size());
+        arion->mem->read_into(fds_addr + sizeof(struct pollfd) * fd_i, &fds[fd_i], sizeof(struct pollfd));
         bool is_file = arion->fs->has_file_entry(fds[fd_i].fd);
         if (!is_file && !arion->sock->has_socket_entry(fds[fd_i].fd))
             return EBADF;
@@ -1933,8 +1941,7 @@ uint64_t arion::sys_ppoll(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> p
     if (timeout_addr)
     {
         struct timespec timeout;
-        std::vector<BYTE> timeout_data = arion->mem->read(timeout_addr, sizeof(struct timespec));
-        memcpy(&timeout, timeout_data.data(), sizeof(struct timespec));
+        arion->mem->read_into(timeout_addr, &timeout, sizeof(struct timespec));
         timeout_ptr = &timeout;
 
         if (!thread_blocking_io)
@@ -1948,8 +1955,7 @@ uint64_t arion::sys_ppoll(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> p
     if (sigmask_addr)
     {
         sigset_t sigmask;
-        std::vector<BYTE> sigmask_data = arion->mem->read(sigmask_addr, sigset_sz);
-        memcpy(&sigmask, sigmask_data.data(), sigset_sz);
+        arion->mem->read_into(sigmask_addr, &sigmask, sigset_sz);
         sigmask_ptr = &sigmask;
     }
 
@@ -2029,15 +2035,13 @@ uint64_t arion::sys_recvmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
 
     struct mmsghdr *msgs = (struct mmsghdr *)malloc(sizeof(struct mmsghdr) * vlen);
 
-    std::vector<BYTE> mmsghdr_data = arion->mem->read(mmsghdr_addr, sizeof(struct mmsghdr) * vlen);
-    memcpy(msgs, mmsghdr_data.data(), mmsghdr_data.size());
+    arion->mem->read_into(mmsghdr_addr, msgs, sizeof(struct mmsghdr) * vlen);
 
     struct timespec *timeout = nullptr;
     if (timeout_addr)
     {
         timeout = (struct timespec *)malloc(sizeof(struct timespec));
-        std::vector<BYTE> timeout_data = arion->mem->read(timeout_addr, sizeof(struct timespec));
-        memcpy(timeout, timeout_data.data(), timeout_data.size());
+        arion->mem->read_into(timeout_addr, timeout, sizeof(struct timespec));
     }
 
     std::map<ADDR, ADDR> buf_addresses;
@@ -2050,8 +2054,7 @@ uint64_t arion::sys_recvmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
         {
             ADDR msg_name_addr = (ADDR)msg->msg_name;
             msg->msg_name = malloc(msg->msg_namelen);
-            std::vector<BYTE> msg_name_data = arion->mem->read(msg_name_addr, msg->msg_namelen);
-            memcpy(msg->msg_name, msg_name_data.data(), msg_name_data.size());
+            arion->mem->read_into(msg_name_addr, msg->msg_name, msg->msg_namelen);
             manage_pre_socket_conn(arion, (struct sockaddr *)msg->msg_name, msg->msg_namelen);
             buf_addresses[(ADDR)msg->msg_name] = msg_name_addr;
         }
@@ -2061,8 +2064,7 @@ uint64_t arion::sys_recvmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
             size_t iov_arr_sz = sizeof(struct iovec) * msg->msg_iovlen;
             ADDR msg_iov_addr = (ADDR)msg->msg_iov;
             msg->msg_iov = (struct iovec *)malloc(iov_arr_sz);
-            std::vector<BYTE> msg_iov_data = arion->mem->read(msg_iov_addr, iov_arr_sz);
-            memcpy(msg->msg_iov, msg_iov_data.data(), msg_iov_data.size());
+            arion->mem->read_into(msg_iov_addr, msg->msg_iov, iov_arr_sz);
 
             for (size_t msg_i = 0; msg_i < msg->msg_iovlen; msg_i++)
             {
@@ -2080,8 +2082,7 @@ uint64_t arion::sys_recvmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
         {
             ADDR msg_control_addr = (ADDR)msg->msg_control;
             msg->msg_control = malloc(msg->msg_controllen);
-            std::vector<BYTE> msg_control_data = arion->mem->read(msg_control_addr, msg->msg_controllen);
-            memcpy(msg->msg_control, msg_control_data.data(), msg_control_data.size());
+            arion->mem->read_into(msg_control_addr, msg->msg_control, msg->msg_controllen);
         }
     }
 
@@ -2163,8 +2164,7 @@ uint64_t arion::sys_sendmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
 
     struct mmsghdr *msgs = (struct mmsghdr *)malloc(sizeof(struct mmsghdr) * vlen);
 
-    std::vector<BYTE> mmsghdr_data = arion->mem->read(mmsghdr_addr, sizeof(struct mmsghdr) * vlen);
-    memcpy(msgs, mmsghdr_data.data(), mmsghdr_data.size());
+    arion->mem->read_into(mmsghdr_addr, msgs, sizeof(struct mmsghdr) * vlen);
 
     std::map<ADDR, ADDR> buf_addresses;
 
@@ -2176,8 +2176,7 @@ uint64_t arion::sys_sendmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
         {
             ADDR msg_name_addr = (ADDR)msg->msg_name;
             msg->msg_name = malloc(msg->msg_namelen);
-            std::vector<BYTE> msg_name_data = arion->mem->read(msg_name_addr, msg->msg_namelen);
-            memcpy(msg->msg_name, msg_name_data.data(), msg_name_data.size());
+            arion->mem->read_into(msg_name_addr, msg->msg_name, msg->msg_namelen);
             buf_addresses[(ADDR)msg->msg_name] = msg_name_addr;
         }
 
@@ -2186,8 +2185,7 @@ uint64_t arion::sys_sendmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
             size_t iov_arr_sz = sizeof(struct iovec) * msg->msg_iovlen;
             ADDR msg_iov_addr = (ADDR)msg->msg_iov;
             msg->msg_iov = (struct iovec *)malloc(iov_arr_sz);
-            std::vector<BYTE> msg_iov_data = arion->mem->read(msg_iov_addr, iov_arr_sz);
-            memcpy(msg->msg_iov, msg_iov_data.data(), msg_iov_data.size());
+            arion->mem->read_into(msg_iov_addr, msg->msg_iov, iov_arr_sz);
 
             for (size_t msg_i = 0; msg_i < msg->msg_iovlen; msg_i++)
             {
@@ -2196,8 +2194,7 @@ uint64_t arion::sys_sendmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
                     continue;
                 ADDR iov_base_addr = (ADDR)iov->iov_base;
                 iov->iov_base = malloc(iov->iov_len);
-                std::vector<BYTE> iov_base_data = arion->mem->read(iov_base_addr, iov->iov_len);
-                memcpy(iov->iov_base, iov_base_data.data(), iov_base_data.size());
+                arion->mem->read_into(iov_base_addr, iov->iov_base, iov->iov_len);
                 buf_addresses[(ADDR)iov->iov_base] = iov_base_addr;
             }
         }
@@ -2206,8 +2203,7 @@ uint64_t arion::sys_sendmmsg(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM
         {
             ADDR msg_control_addr = (ADDR)msg->msg_control;
             msg->msg_control = malloc(msg->msg_controllen);
-            std::vector<BYTE> msg_control_data = arion->mem->read(msg_control_addr, msg->msg_controllen);
-            memcpy(msg->msg_control, msg_control_data.data(), msg_control_data.size());
+            arion->mem->read_into(msg_control_addr, msg->msg_control, msg->msg_controllen);
         }
     }
 
@@ -21,11 +21,10 @@ ADDR do_mmap(std::shared_ptr<Arion> arion, ADDR addr, size_t len, int prot, int
     PROT_FLAGS arion_prot = kernel_prot_to_arion_prot(prot);
     ADDR map_addr;
     std::string mapping_name = "[mmap]";
-    std::vector<BYTE> data(len);
+    std::shared_ptr<ARION_FILE> arion_f;
 
     if (flags & MAP_ANONYMOUS)
     {
-        std::fill(data.begin(), data.end(), 0);
         if (flags & MAP_STACK)
             mapping_name = "[thread_stack]";
     }
@@ -33,27 +32,21 @@ ADDR do_mmap(std::shared_ptr<Arion> arion, ADDR addr, size_t len, int prot, int
     {
         if (!arion->fs->has_file_entry(fd))
             return EACCES;
-        std::shared_ptr<ARION_FILE> arion_f = arion->fs->get_arion_file(fd);
+        arion_f = arion->fs->get_arion_file(fd);
         mapping_name = arion_f->path;
-        off_t current_pos = lseek(arion_f->fd, 0, SEEK_CUR);
-        lseek(arion_f->fd, off, SEEK_SET);
-        ssize_t read_sz = read(arion_f->fd, data.data(), len);
-        if (read_sz < 0)
-            return EBADF;
-        lseek(arion_f->fd, current_pos, SEEK_SET);
     }
 
     if (flags & MAP_FIXED)
     {
         if (!arion->mem->can_map(addr, len))
             arion->mem->unmap(addr, addr + len);
-        map_addr = arion->mem->map(addr, len, arion_prot, mapping_name);
+        map_addr = addr;
     }
     else if (flags & MAP_FIXED_NOREPLACE)
     {
         if (!arion->mem->can_map(addr, len))
             return EEXIST;
-        map_addr = arion->mem->map(addr, len, arion_prot, mapping_name);
+        map_addr = addr;
     }
     else
     {
@@ -75,10 +68,15 @@ ADDR do_mmap(std::shared_ptr<Arion> arion, ADDR addr, size_t len, int prot, int
                 break;
             }
         }
-        map_addr = arion->mem->map_anywhere(addr, len, arion_prot, false, mapping_name);
+        map_addr = arion->mem->find_free_addr(addr, len, false);
     }
 
-    arion->mem->write(map_addr, data.data(), data.size());
+    // Anonymous mappings are not filled: freshly mapped memory is zeroed and lazily committed by the host on first touch.
+    // File mappings are backed by a private host mapping of the file when possible.
+    if (arion_f)
+        arion->mem->map_file(map_addr, len, arion_prot, arion_f->fd, off, mapping_name);
+    else
+        arion->mem->map(map_addr, len, arion_prot, mapping_name);
     return map_addr;
 }
 
@@ -10,12 +10,19 @@ uint64_t arion::sys_getrandom(std::shared_ptr<Arion> arion, std::vector<SYS_PARA
     size_t len = params.at(1);
     unsigned int flags = params.at(2);
 
-    char *buf = (char *)malloc(len);
+    BYTE *buf = arion->mem->view(buf_addr, len);
+    std::vector<BYTE> tmp_buf;
+    if (!buf)
+    {
+        tmp_buf.resize(len);
+        buf = tmp_buf.data();
+    }
     ssize_t getrandom_ret = getrandom(buf, len, flags);
     if (getrandom_ret == -1)
         getrandom_ret = -errno;
+    else if (tmp_buf.size())
+        arion->mem->write(buf_addr, buf, getrandom_ret);
     else
-        arion->mem->write(buf_addr, (BYTE *)buf, len);
-    free(buf);
+        arion->mem->mark_written(buf_addr, getrandom_ret);
     return getrandom_ret;
 }
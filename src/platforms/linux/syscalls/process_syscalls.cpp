@@ -241,16 +241,15 @@ uint64_t arion::sys_clone3(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM>
     ADDR args_addr = params.at(0);
     size_t args_sz = params.at(1);
 
-    std::vector<BYTE> args_vec = arion->mem->read(args_addr, args_sz);
-    struct clone_args *args = new struct clone_args;
-    memcpy(args, args_vec.data(), args_sz);
+    struct clone_args args = {};
+    arion->mem->read_into(args_addr, &args, std::min(args_sz, sizeof(struct clone_args)));
     pid_t child_pid;
-    if (args->flags & CLONE_THREAD)
-        child_pid = arion->threads->clone_thread(args->flags, args->stack + args->stack_size, args->tls,
-                                                 args->child_tid, args->parent_tid, args->exit_signal);
+    if (args.flags & CLONE_THREAD)
+        child_pid = arion->threads->clone_thread(args.flags, args.stack + args.stack_size, args.tls, args.child_tid,
+                                                 args.parent_tid, args.exit_signal);
     else
-        child_pid = arion->threads->fork_process(args->flags, args->stack + args->stack_size, args->tls,
-                                                 args->child_tid, args->parent_tid, args->exit_signal);
+        child_pid = arion->threads->fork_process(args.flags, args.stack + args.stack_size, args.tls, args.child_tid,
+                                                 args.parent_tid, args.exit_signal);
     arion->sync_threads();
     return child_pid;
 }
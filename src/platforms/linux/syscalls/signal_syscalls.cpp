@@ -19,15 +19,12 @@ uint64_t arion::sys_rt_sigaction(std::shared_ptr<Arion> arion, std::vector<SYS_P
     if (old_act_addr && arion->signals->has_sighandler(signo))
     {
         std::shared_ptr<struct ksigaction> old_act = arion->signals->get_sighandler(signo);
-        std::vector<BYTE> old_act_data(sizeof(struct arion_lnx_type::ksigaction));
-        memcpy(old_act_data.data(), old_act.get(), sizeof(struct arion_lnx_type::ksigaction));
-        arion->mem->write(old_act_addr, old_act_data.data(), old_act_data.size());
+        arion->mem->write<struct ksigaction>(old_act_addr, *old_act);
     }
     if (act_addr)
     {
-        std::vector<BYTE> act_data = arion->mem->read(act_addr, sizeof(struct arion_lnx_type::ksigaction));
-        std::shared_ptr<struct ksigaction> act = std::make_shared<struct ksigaction>();
-        memcpy(act.get(), act_data.data(), act_data.size());
+        std::shared_ptr<struct ksigaction> act =
+            std::make_shared<struct ksigaction>(arion->mem->read<struct ksigaction>(act_addr));
         arion->signals->set_sighandler(signo, act);
     }
     return 0;
@@ -57,10 +54,7 @@ uint64_t arion::sys_sigreturn(std::shared_ptr<Arion> arion, std::vector<SYS_PARA
 
 uint64_t arion::sys_pause(std::shared_ptr<Arion> arion, std::vector<SYS_PARAM> params, bool &cancel)
 {
-    pid_t curr_tid = arion->threads->get_running_tid();
-    std::unique_ptr<ARION_THREAD> arion_t = std::move(arion->threads->threads_map.at(curr_tid));
-    arion_t->stopped = true;
-    arion->threads->threads_map[curr_tid] = std::move(arion_t);
+    arion->threads->park_thread(arion->threads->get_running_tid());
     return 0;
 }
 
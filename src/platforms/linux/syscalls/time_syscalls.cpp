@@ -76,14 +76,7 @@ uint64_t arion::sys_clock_nanosleep(std::shared_ptr<Arion> arion, std::vector<SY
     if (!arion->config || !arion->config->get_field<bool>("enable_sleep_syscalls"))
         return 0;
 
-    struct timespec t;
-    std::vector<BYTE> value(sizeof(t));
-    value = arion->mem->read(t_addr, sizeof(t));
-    if (value.size() != sizeof(t))
-    {
-        return -EFAULT;
-    }
-    std::memcpy(&t, value.data(), sizeof(t));
+    struct timespec t = arion->mem->read<struct timespec>(t_addr);
 
     struct timespec remain;
     int nanosleep_ret = clock_nanosleep(clock_id, flags, &t, &remain);
@@ -55,10 +55,10 @@ CPU_ARCH arion_poly_struct::AbsArionStructType::arion_curr_arch(std::shared_ptr<
     return arion->arch->get_attrs()->arch;
 }
 
-std::vector<arion::BYTE> arion_poly_struct::AbsArionStructType::arion_read_mem(std::shared_ptr<arion::Arion> arion,
-                                                                               arion::ADDR addr, size_t sz)
+void arion_poly_struct::AbsArionStructType::arion_read_mem(std::shared_ptr<arion::Arion> arion, arion::ADDR addr,
+                                                           arion::BYTE *buf, size_t sz)
 {
-    return arion->mem->read(addr, sz);
+    arion->mem->read_into(addr, buf, sz);
 }
 
 std::string RawStringType::str(std::shared_ptr<arion::Arion> arion, uint64_t val)
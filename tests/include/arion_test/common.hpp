@@ -2,8 +2,11 @@
 #define ARION_TEST_COMMON_HPP
 
 #include <algorithm>
+#include <arion/arion.hpp>
+#include <arion/common/code_tracer.hpp>
 #include <filesystem>
 #include <gtest/gtest.h>
+#include <memory>
 #include <string>
 #include <vector>
 
@@ -75,6 +78,23 @@ class ArionTest : public ::testing::Test
     {
         this->arion_root_path = std::string(ARION_ROOT_PATH);
     }
+
+    void trace_simple_syscalls(std::string trace_path, arion::TRACE_MODE mode,
+                               std::unique_ptr<arion::Config> config = std::make_unique<arion::Config>())
+    {
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        std::shared_ptr<arion::ArionGroup> arion_group = std::make_shared<arion::ArionGroup>();
+        std::string rootfs_path = this->arion_root_path + "/rootfs/x86-64/rootfs";
+        std::shared_ptr<arion::Arion> arion =
+            arion::Arion::new_instance({rootfs_path + "/root/simple_syscalls/simple_syscalls"}, rootfs_path, {},
+                                       rootfs_path + "/root", std::move(config));
+        arion->tracer->start(trace_path, mode);
+        testing::internal::CaptureStdout();
+        arion_group->add_arion_instance(arion);
+        arion_group->run();
+        testing::internal::GetCapturedStdout();
+        arion->tracer->stop();
+    }
 };
 
 class ArionMultiarchTest : public ArionTest, public ::testing::WithParamInterface<std::string>
@@ -0,0 +1,38 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+#include <arion_test/shellcode/basic_shellcode.hpp>
+
+using namespace arion;
+
+std::map<arion::ADDR, size_t> addr_hook_hits;
+
+void addr_hook(std::shared_ptr<Arion> arion, arion::ADDR addr, size_t sz, void *user_data)
+{
+    addr_hook_hits[addr]++;
+}
+
+TEST_F(ArionTest, AddrHook)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    std::unique_ptr<BaremetalManager> baremetal =
+        std::make_unique<BaremetalManager>(CPU_ARCH::X8664_ARCH, BASIC_SHELLCODE_X86_64, 0x400000);
+    std::shared_ptr<Arion> arion = Arion::new_instance(std::move(baremetal), "/", {}, "/", std::move(config));
+    // Two hooks sharing the same address, then hooks sharing a group, one of them being removed
+    arion->hooks->hook_addr(addr_hook, 0x400000);
+    arion->hooks->hook_addr(addr_hook, 0x400000);
+    HOOK_ID removed_id = arion->hooks->hook_addr(addr_hook, 0x400004);
+    arion->hooks->hook_addr(addr_hook, 0x40000b);
+    for (arion::ADDR addr = 0x10000000; addr < 0x10010000; addr += 0x40)
+        arion->hooks->hook_addr(addr_hook, addr);
+    arion->hooks->unhook(removed_id);
+    testing::internal::CaptureStdout();
+    arion_group->add_arion_instance(arion);
+    arion_group->run();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(addr_hook_hits[0x400000], 2);
+    EXPECT_EQ(addr_hook_hits.count(0x400004), 0);
+    EXPECT_EQ(addr_hook_hits[0x40000b], 1);
+    EXPECT_EQ(addr_hook_hits.size(), 2);
+}
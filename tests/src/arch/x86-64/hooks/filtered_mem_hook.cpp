@@ -0,0 +1,54 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+#include <arion_test/shellcode/basic_shellcode.hpp>
+
+using namespace arion;
+
+bool filtered_mem_hook(std::shared_ptr<Arion> arion, uc_mem_type type, uint64_t addr, int size, int64_t val,
+                       void *user_data)
+{
+    (*static_cast<size_t *>(user_data))++;
+    return false;
+}
+
+TEST_F(ArionTest, FilteredMemHook)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    std::unique_ptr<BaremetalManager> baremetal =
+        std::make_unique<BaremetalManager>(CPU_ARCH::X8664_ARCH, BASIC_SHELLCODE_X86_64, 0x400000);
+    std::shared_ptr<Arion> arion = Arion::new_instance(std::move(baremetal), "/", {}, "/", std::move(config));
+    // The shellcode builds its string with 4 stores of 4 bytes, at 0x400004, 0x40000b, 0x400013 and 0x40001b
+    size_t val_hits = 0, size_hits = 0, pc_hits = 0, budget_hits = 0;
+    ARION_MEM_HOOK_FILTER val_filter;
+    val_filter.val_min = val_filter.val_max = 0x6f6c6c65; // "ello"
+    arion->hooks->hook_mem_write_filtered(filtered_mem_hook, val_filter, 0, ARION_MAX_U64, &val_hits);
+    ARION_MEM_HOOK_FILTER size_filter;
+    size_filter.sizes = 1 | 2 | 8;
+    arion->hooks->hook_mem_write_filtered(filtered_mem_hook, size_filter, 0, ARION_MAX_U64, &size_hits);
+    ARION_MEM_HOOK_FILTER pc_filter;
+    pc_filter.pc_start = 0x400013;
+    pc_filter.pc_end = 0x40001b;
+    arion->hooks->hook_mem_write_filtered(filtered_mem_hook, pc_filter, 0, ARION_MAX_U64, &pc_hits);
+    ARION_MEM_HOOK_FILTER budget_filter;
+    budget_filter.budget = 2;
+    HOOK_ID budget_id =
+        arion->hooks->hook_mem_write_filtered(filtered_mem_hook, budget_filter, 0, ARION_MAX_U64, &budget_hits);
+    testing::internal::CaptureStdout();
+    arion_group->add_arion_instance(arion);
+    arion_group->run();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(val_hits, 1);
+    EXPECT_EQ(size_hits, 0);
+    EXPECT_EQ(pc_hits, 2);
+    EXPECT_EQ(budget_hits, 2);
+    EXPECT_THROW(arion->hooks->unhook(budget_id), arion_exception::WrongHookIdException);
+    // The ID of the exhausted hook must not be handed to a new hook
+    HOOK_ID new_id = arion->hooks->hook_mem_write(filtered_mem_hook);
+    EXPECT_NE(new_id, budget_id);
+    EXPECT_THROW(arion->hooks->unhook(budget_id), arion_exception::WrongHookIdException);
+    EXPECT_NO_THROW(arion->hooks->unhook(new_id));
+    EXPECT_THROW(arion->hooks->hook_mem_read_filtered(filtered_mem_hook, val_filter),
+                 arion_exception::WrongHookParamsException);
+}
@@ -0,0 +1,43 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+void hook_stats_code_hook(Arion &arion, arion::ADDR addr, size_t sz, void *user_data)
+{
+}
+
+TEST_F(ArionTest, HookStats)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    std::string rootfs_path = this->arion_root_path + "/rootfs/x86-64/rootfs";
+    std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_syscalls/simple_syscalls"},
+                                                       rootfs_path, {}, rootfs_path + "/root", std::move(config));
+    HOOK_ID code_hook_id = arion->hooks->hook_code_fast(hook_stats_code_hook);
+    arion->hooks->set_hook_label(code_hook_id, "test");
+    testing::internal::CaptureStdout();
+    arion_group->add_arion_instance(arion);
+    arion_group->run();
+    testing::internal::GetCapturedStdout();
+
+    std::map<HOOK_ID, ARION_HOOK_STATS> stats = arion->hooks->get_stats();
+    ASSERT_NE(stats.find(code_hook_id), stats.end());
+    EXPECT_EQ(stats.at(code_hook_id).label, "test");
+    EXPECT_EQ(stats.at(code_hook_id).type, ARION_HOOK_TYPE::CODE_HOOK);
+    auto syscall_stats_it = std::find_if(stats.begin(), stats.end(), [](auto &stats_pair) {
+        return stats_pair.second.label == "ArchManagerX8664::syscall_hook";
+    });
+    ASSERT_NE(syscall_stats_it, stats.end());
+    if (!HooksManager::is_profiling_enabled())
+    {
+        EXPECT_EQ(stats.at(code_hook_id).counters.calls, 0);
+        return;
+    }
+    EXPECT_GT(stats.at(code_hook_id).counters.calls, 0);
+    EXPECT_GT(stats.at(code_hook_id).counters.ns, 0);
+    EXPECT_GE(syscall_stats_it->second.counters.calls, 3);
+    arion->hooks->reset_stats();
+    EXPECT_EQ(arion->hooks->get_stats().at(code_hook_id).counters.calls, 0);
+}
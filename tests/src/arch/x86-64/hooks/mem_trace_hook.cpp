@@ -0,0 +1,41 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+#include <arion_test/shellcode/basic_shellcode.hpp>
+
+using namespace arion;
+
+std::vector<ARION_MEM_ACCESS> mem_trace_accesses;
+size_t mem_trace_batches = 0;
+
+void mem_trace_hook(std::shared_ptr<Arion> arion, const ARION_MEM_ACCESS *accesses, size_t count, void *user_data)
+{
+    mem_trace_accesses.insert(mem_trace_accesses.end(), accesses, accesses + count);
+    mem_trace_batches++;
+}
+
+TEST_F(ArionTest, MemTraceHook)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    std::unique_ptr<BaremetalManager> baremetal =
+        std::make_unique<BaremetalManager>(CPU_ARCH::X8664_ARCH, BASIC_SHELLCODE_X86_64, 0x400000);
+    std::shared_ptr<Arion> arion = Arion::new_instance(std::move(baremetal), "/", {}, "/", std::move(config));
+    // The shellcode builds its string with 4 stores of 4 bytes, delivered in batches of 3
+    arion->hooks->hook_mem_trace(mem_trace_hook, UC_HOOK_MEM_WRITE, 3);
+    testing::internal::CaptureStdout();
+    arion_group->add_arion_instance(arion);
+    arion_group->run();
+    testing::internal::GetCapturedStdout();
+    ASSERT_EQ(mem_trace_accesses.size(), 4);
+    EXPECT_EQ(mem_trace_batches, 2);
+    std::vector<ADDR> expected_pcs = {0x400004, 0x40000b, 0x400013, 0x40001b};
+    for (size_t access_i = 0; access_i < mem_trace_accesses.size(); access_i++)
+    {
+        EXPECT_EQ(mem_trace_accesses[access_i].pc, expected_pcs[access_i]);
+        EXPECT_EQ(mem_trace_accesses[access_i].type, UC_MEM_WRITE);
+        EXPECT_EQ(mem_trace_accesses[access_i].size, 4);
+        EXPECT_EQ(mem_trace_accesses[access_i].addr, mem_trace_accesses[0].addr + access_i * 4);
+    }
+    EXPECT_EQ((uint32_t)mem_trace_accesses[1].val, 0x6f6c6c65); // "ello"
+}
@@ -0,0 +1,77 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+size_t sysno_hook_any_ctr = 0;
+size_t sysno_hook_write_ctr = 0;
+
+void sysno_any_hook(std::shared_ptr<Arion> arion, uint64_t sysno, std::vector<SYS_PARAM> params, bool *handled,
+                    void *user_data)
+{
+    sysno_hook_any_ctr++;
+}
+
+void sysno_write_hook(std::shared_ptr<Arion> arion, uint64_t sysno, std::vector<SYS_PARAM> params, bool *handled,
+                      void *user_data)
+{
+    if (sysno == 1) // write
+        sysno_hook_write_ctr++;
+    else
+        sysno_hook_write_ctr += 0x100;
+}
+
+TEST_F(ArionTest, SysnoHook)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    std::string rootfs_path = this->arion_root_path + "/rootfs/x86-64/rootfs";
+    std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_syscalls/simple_syscalls"},
+                                                       rootfs_path, {}, rootfs_path + "/root", std::move(config));
+    arion->hooks->hook_syscall(sysno_any_hook);
+    arion->hooks->hook_sysno(sysno_write_hook, 1);
+    HOOK_ID removed_id = arion->hooks->hook_sysno(sysno_write_hook, 1);
+    arion->hooks->unhook(removed_id);
+    testing::internal::CaptureStdout();
+    arion_group->add_arion_instance(arion);
+    arion_group->run();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(sysno_hook_write_ctr, 1);
+    EXPECT_GT(sysno_hook_any_ctr, sysno_hook_write_ctr);
+}
+
+HOOK_ID self_removing_hook_id = 0;
+size_t self_removing_hook_ctr = 0;
+size_t added_write_hook_ctr = 0;
+
+void added_write_hook(std::shared_ptr<Arion> arion, uint64_t sysno, std::vector<SYS_PARAM> params, bool *handled,
+                      void *user_data)
+{
+    added_write_hook_ctr++;
+}
+
+void self_removing_hook(std::shared_ptr<Arion> arion, uint64_t sysno, std::vector<SYS_PARAM> params, bool *handled,
+                        void *user_data)
+{
+    self_removing_hook_ctr++;
+    arion->hooks->unhook(self_removing_hook_id);
+    arion->hooks->hook_sysno(added_write_hook, 1);
+}
+
+TEST_F(ArionTest, SysnoHookEditedWhileTriggered)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    std::string rootfs_path = this->arion_root_path + "/rootfs/x86-64/rootfs";
+    std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_syscalls/simple_syscalls"},
+                                                       rootfs_path, {}, rootfs_path + "/root", std::move(config));
+    self_removing_hook_id = arion->hooks->hook_syscall(self_removing_hook);
+    testing::internal::CaptureStdout();
+    arion_group->add_arion_instance(arion);
+    arion_group->run();
+    testing::internal::GetCapturedStdout();
+    EXPECT_EQ(self_removing_hook_ctr, 1);
+    EXPECT_EQ(added_write_hook_ctr, 1);
+}
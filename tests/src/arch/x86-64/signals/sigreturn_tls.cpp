@@ -0,0 +1,28 @@
+#include <arion/arion.hpp>
+#include <arion/unicorn/x86.h>
+#include <arion_test/common.hpp>
+#include <csignal>
+
+using namespace arion;
+
+TEST_F(ArionTest, SigreturnTls)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::string rootfs_path = this->arion_root_path + "/rootfs/x86-64/rootfs";
+    std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_syscalls/simple_syscalls"},
+                                                       rootfs_path, {}, rootfs_path + "/root", std::move(config));
+    ADDR tls_addr = 0x7FFFF7D8A740;
+    arion->arch->load_tls(tls_addr);
+    ADDR pc = arion->arch->read_arch_reg(arion->arch->get_attrs()->regs.pc);
+
+    std::shared_ptr<arion_lnx_type::ksigaction> sighandler = std::make_shared<arion_lnx_type::ksigaction>();
+    sighandler->handler = (void *)pc;
+    sighandler->flags = SA_SIGINFO;
+    arion->signals->set_sighandler(SIGUSR1, sighandler);
+    arion->signals->handle_signal(arion->get_pid(), SIGUSR1);
+    // The handler may change the TLS address, which must not leak out of it
+    arion->arch->load_tls(0);
+    EXPECT_TRUE(arion->signals->sigreturn());
+    EXPECT_EQ(arion->arch->read_reg<RVAL64>(UC_X86_REG_FS_BASE), tls_addr);
+}
@@ -0,0 +1,52 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, CowContext)
+{
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        config->set_field<bool>("host_backed_mem", true);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_print/simple_print"},
+                                                           rootfs_path, {}, rootfs_path + "/root", std::move(config));
+
+        arion->mem->map(0x10000000, 0x100000, 6, "[cow]");
+        arion->mem->write<uint32_t>(0x10000010, 0xDEADBEEF);
+        BYTE *view = arion->mem->view(0x10000000, 0x100000);
+        ASSERT_NE(view, nullptr);
+
+        std::shared_ptr<ARION_CONTEXT> ctx = arion->context->save(true);
+        for (std::unique_ptr<ARION_MAPPING> &arion_m : ctx->mapping_list)
+        {
+            if (arion_m->info != "[cow]")
+                continue;
+            EXPECT_EQ(arion_m->saved_data, nullptr);
+            ASSERT_NE(arion_m->host_file, nullptr);
+        }
+        // Sharing keeps the same host buffer
+        EXPECT_EQ(arion->mem->view(0x10000000, 0x100000), view);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10000010), 0xDEADBEEF);
+
+        arion->mem->write<uint32_t>(0x10000010, 0xCAFEBABE);
+        arion->mem->write<uint32_t>(0x10080000, 0x12345678);
+        arion->context->restore(ctx);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10000010), 0xDEADBEEF);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10080000), 0);
+
+        // Sharing an already shared mapping keeps both the frozen and the newly written pages
+        arion->mem->write<uint32_t>(0x10080000, 0x12345678);
+        std::shared_ptr<ARION_CONTEXT> ctx2 = arion->context->save(true);
+        arion->mem->write<uint32_t>(0x10000010, 0);
+        arion->context->restore(ctx2);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10000010), 0xDEADBEEF);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10080000), 0x12345678);
+    }
+    catch (std::exception &e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+}
@@ -0,0 +1,35 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, RegisterFile)
+{
+    ADDR pc_before = 0, pc_written = 0, pc_after = 0, pc_restored = 0;
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_print/simple_print"},
+                                                           rootfs_path, {}, rootfs_path + "/root", std::move(config));
+        REG pc_reg = arion->arch->get_attrs()->regs.pc;
+        pc_before = arion->arch->read_arch_reg(pc_reg);
+        std::unique_ptr<RegisterFile> regs = arion->arch->dump_regs();
+        RegisterFile saved_regs = *regs;
+        RVAL pc_val = regs->get(pc_reg);
+        pc_val.r64 = (pc_before + 0x10) & 0xFFFFFFFF;
+        pc_written = pc_val.r64;
+        regs->set(pc_reg, pc_val);
+        arion->arch->load_regs(*regs);
+        pc_after = arion->arch->read_arch_reg(pc_reg);
+        arion->arch->load_regs(saved_regs);
+        pc_restored = arion->arch->read_arch_reg(pc_reg);
+    }
+    catch (std::exception e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+    EXPECT_EQ(pc_after, pc_written);
+    EXPECT_EQ(pc_restored, pc_before);
+}
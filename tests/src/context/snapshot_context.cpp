@@ -0,0 +1,43 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, SnapshotContext)
+{
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        config->set_field<bool>("host_backed_mem", true);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_print/simple_print"},
+                                                           rootfs_path, {}, rootfs_path + "/root", std::move(config));
+
+        arion->mem->map(0x10000000, 0x10000, 6, "[snapshot]");
+        arion->mem->write<uint32_t>(0x10000010, 0xDEADBEEF);
+        std::shared_ptr<ARION_CONTEXT> ctx = arion->context->save_snapshot();
+        ASSERT_NE(ctx->uc_snapshot, nullptr);
+        // Host-backed memory was moved to Unicorn engine
+        EXPECT_EQ(arion->mem->view(0x10000000, 0x10000), nullptr);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10000010), 0xDEADBEEF);
+
+        for (size_t round = 0; round < 3; round++)
+        {
+            arion->mem->write<uint32_t>(0x10000010, 0xCAFEBABE);
+            arion->mem->write<uint32_t>(0x10008000, 0x12345678);
+            // Mappings created after the snapshot are dropped, removed ones are mapped back
+            arion->mem->map(0x20000000, 0x1000, 6, "[round]");
+            arion->mem->unmap(0x10000000, 0x10010000);
+            arion->context->restore_snapshot(ctx);
+            EXPECT_EQ(arion->mem->read<uint32_t>(0x10000010), 0xDEADBEEF);
+            EXPECT_EQ(arion->mem->read<uint32_t>(0x10008000), 0);
+            EXPECT_EQ(arion->mem->get_mapping_at(0x10000000)->end_addr, 0x10010000);
+            EXPECT_FALSE(arion->mem->has_mapping_with_info("[round]"));
+        }
+    }
+    catch (std::exception &e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+}
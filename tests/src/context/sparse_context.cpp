@@ -0,0 +1,44 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, SparseContext)
+{
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_print/simple_print"},
+                                                           rootfs_path, {}, rootfs_path + "/root", std::move(config));
+
+        // Large reservation with a single touched page
+        arion->mem->map(0x10000000, 0x1000000, 6, "[sparse]");
+        arion->mem->write<uint32_t>(0x10800010, 0xDEADBEEF);
+
+        std::shared_ptr<ARION_CONTEXT> ctx = arion->context->save();
+        bool found = false;
+        for (std::unique_ptr<ARION_MAPPING> &arion_m : ctx->mapping_list)
+        {
+            if (arion_m->info != "[sparse]")
+                continue;
+            found = true;
+            EXPECT_EQ(arion_m->end_addr - arion_m->start_addr, 0x1000000);
+            EXPECT_EQ(*(uint32_t *)(arion_m->saved_data + 0x800010), 0xDEADBEEF);
+            EXPECT_EQ(arion_m->saved_data[0x7FFFFF], 0);
+        }
+        EXPECT_TRUE(found);
+
+        arion->mem->unmap(0x10000000, 0x11000000);
+        arion->context->restore(ctx);
+        EXPECT_EQ(arion->mem->get_mapping_at(0x10FFF000)->start_addr, 0x10000000);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10800010), 0xDEADBEEF);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10000000), 0);
+        EXPECT_NE(arion->mem->mappings_str().find("[sparse]"), std::string::npos);
+    }
+    catch (std::exception &e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+}
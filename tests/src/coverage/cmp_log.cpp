@@ -0,0 +1,33 @@
+#include <arion/arion.hpp>
+#include <arion/components/cmp_log.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_F(ArionTest, CmpLog)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+    std::string rootfs_path = this->arion_root_path + "/rootfs/x86-64/rootfs";
+    std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_syscalls/simple_syscalls"},
+                                                       rootfs_path, {}, rootfs_path + "/root", std::move(config));
+    std::unique_ptr<CmpLog> cmp_log = std::make_unique<CmpLog>(arion);
+    cmp_log->start();
+    testing::internal::CaptureStdout();
+    arion_group->add_arion_instance(arion);
+    arion_group->run();
+    testing::internal::GetCapturedStdout();
+    cmp_log->stop();
+    std::vector<ARION_CMP_ENTRY> cmps = cmp_log->get_cmps();
+    ASSERT_GT(cmps.size(), 0);
+    for (ARION_CMP_ENTRY &cmp : cmps)
+    {
+        EXPECT_GE(cmp.size, 1);
+        EXPECT_LE(cmp.size, 8);
+    }
+    std::vector<ARION_CMP_ENTRY> site_cmps = cmp_log->get_cmps(cmps.front().pc);
+    EXPECT_GT(site_cmps.size(), 0);
+    cmp_log->reset();
+    EXPECT_EQ(cmp_log->get_cmps().size(), 0);
+}
@@ -0,0 +1,51 @@
+#include <arion/arion.hpp>
+#include <arion/components/edge_coverage.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, EdgeCoverage)
+{
+    testing::internal::CaptureStdout();
+    size_t edges = 0;
+    bool bad_size_thrown = false;
+    bool reset_cleared = true;
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/simple_print/simple_print"},
+                                                           rootfs_path, {}, rootfs_path + "/root", std::move(config));
+        arion_group->add_arion_instance(arion);
+        std::unique_ptr<EdgeCoverage> coverage = std::make_unique<EdgeCoverage>(arion);
+        try
+        {
+            coverage->start(nullptr, ARION_EDGE_MAP_SZ - 1);
+        }
+        catch (arion_exception::WrongCoverageMapSizeException &e)
+        {
+            bad_size_thrown = true;
+        }
+        std::vector<uint8_t> shm(ARION_EDGE_MAP_SZ, 0);
+        coverage->start(shm.data(), shm.size());
+        arion_group->run();
+        coverage->stop();
+        edges = coverage->count_edges();
+        coverage->reset();
+        for (uint8_t hits : shm)
+            if (hits)
+                reset_cleared = false;
+    }
+    catch (std::exception e)
+    {
+        testing::internal::GetCapturedStdout(); // Prevent using GetCapturedStdout() multiple times
+        FAIL() << "Exception caught: " << e.what();
+    }
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_STREQ(output.c_str(), "A simple print\n");
+    EXPECT_TRUE(bad_size_thrown);
+    EXPECT_GT(edges, 0);
+    EXPECT_TRUE(reset_cleared);
+}
@@ -0,0 +1,57 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, DirtyPages)
+{
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        auto arch_it = arion::ARCH_FROM_NAME.find(str_to_uppercase(this->arch));
+        if (arch_it == arion::ARCH_FROM_NAME.end())
+            FAIL() << "No architecture with name : " << this->arch;
+        std::unique_ptr<BaremetalManager> baremetal =
+            std::make_unique<BaremetalManager>(arch_it->second, 0x400000, 0x400000);
+        std::shared_ptr<Arion> arion =
+            Arion::new_instance(std::move(baremetal), rootfs_path, {}, rootfs_path + "/root", std::move(config));
+
+        arion->mem->map(0x10000000, 0x4000, 6, "[dirty]");
+        arion->mem->map(0x10004000, 0x1000, 6, "[dirty_next]");
+        arion->mem->write_string(0x10000000, "untracked");
+        arion->mem->recorder->start();
+        EXPECT_TRUE(arion->mem->is_dirty_tracking());
+        EXPECT_TRUE(arion->mem->recorder->get_edits().empty());
+
+        arion->mem->write<uint32_t>(0x10001010, 0x41414141);
+        arion->mem->write<uint32_t>(0x10001020, 0x42424242);
+        arion->mem->write_string(0x10003FFC, "contiguous");
+        std::vector<std::shared_ptr<ARION_MEM_EDIT>> edits = arion->mem->recorder->get_edits();
+        ASSERT_EQ(edits.size(), 2);
+        EXPECT_EQ(edits.at(0)->addr, 0x10001000);
+        EXPECT_EQ(edits.at(0)->sz, 0x1000);
+        // Written pages of contiguous mappings are reported as a single range
+        EXPECT_EQ(edits.at(1)->addr, 0x10003000);
+        EXPECT_EQ(edits.at(1)->sz, 0x2000);
+
+        // Splitting a mapping keeps track of its written pages
+        arion->mem->protect(0x10001000, 0x10002000, 4);
+        edits = arion->mem->recorder->get_edits();
+        ASSERT_EQ(edits.size(), 2);
+        EXPECT_EQ(edits.at(0)->addr, 0x10001000);
+        EXPECT_EQ(arion->mem->read<uint32_t>(0x10001020), 0x42424242);
+
+        arion->mem->recorder->clear();
+        EXPECT_TRUE(arion->mem->recorder->get_edits().empty());
+        arion->mem->recorder->stop();
+        EXPECT_FALSE(arion->mem->is_dirty_tracking());
+        arion->mem->write_string(0x10002000, "untracked");
+        EXPECT_TRUE(arion->mem->recorder->get_edits().empty());
+    }
+    catch (std::exception &e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+}
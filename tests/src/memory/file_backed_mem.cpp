@@ -0,0 +1,58 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+#include <fcntl.h>
+#include <unistd.h>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, FileBackedMem)
+{
+    std::string file_path = "/tmp/arion_file_backed_" + this->arch;
+    try
+    {
+        std::vector<BYTE> content(0x1800, 'A');
+        int write_fd = open(file_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+        ASSERT_GE(write_fd, 0);
+        ASSERT_EQ(write(write_fd, content.data(), content.size()), content.size());
+        close(write_fd);
+
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        auto arch_it = arion::ARCH_FROM_NAME.find(str_to_uppercase(this->arch));
+        if (arch_it == arion::ARCH_FROM_NAME.end())
+            FAIL() << "No architecture with name : " << this->arch;
+        std::unique_ptr<BaremetalManager> baremetal =
+            std::make_unique<BaremetalManager>(arch_it->second, 0x400000, 0x400000);
+        std::shared_ptr<Arion> arion =
+            Arion::new_instance(std::move(baremetal), rootfs_path, {}, rootfs_path + "/root", std::move(config));
+
+        int fd = open(file_path.c_str(), O_RDONLY);
+        ASSERT_GE(fd, 0);
+        arion->mem->map_file(0x10000000, 0x3000, 6, fd, 0x1000, file_path);
+        close(fd);
+        EXPECT_NE(arion->mem->view(0x10000000, 0x3000), nullptr);
+        EXPECT_EQ(arion->mem->read<BYTE>(0x10000000), 'A');
+        EXPECT_EQ(arion->mem->read<BYTE>(0x100007FF), 'A');
+        EXPECT_EQ(arion->mem->read<BYTE>(0x10000800), 0);
+        EXPECT_EQ(arion->mem->read<BYTE>(0x10002FFF), 0); // Past the end of the file
+
+        // Writes are private to the mapping
+        arion->mem->write<BYTE>(0x10000000, 'B');
+        EXPECT_EQ(arion->mem->read<BYTE>(0x10000000), 'B');
+        int read_fd = open(file_path.c_str(), O_RDONLY);
+        ASSERT_GE(read_fd, 0);
+        BYTE file_byte = 0;
+        ASSERT_EQ(pread(read_fd, &file_byte, 1, 0x1000), 1);
+        close(read_fd);
+        EXPECT_EQ(file_byte, 'A');
+
+        arion->mem->unmap(0x10000000, 0x10003000);
+        EXPECT_FALSE(arion->mem->is_mapped(0x10000000));
+    }
+    catch (std::exception &e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+    unlink(file_path.c_str());
+}
@@ -0,0 +1,48 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, HostBackedMem)
+{
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        config->set_field<bool>("host_backed_mem", true);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        auto arch_it = arion::ARCH_FROM_NAME.find(str_to_uppercase(this->arch));
+        if (arch_it == arion::ARCH_FROM_NAME.end())
+            FAIL() << "No architecture with name : " << this->arch;
+        std::unique_ptr<BaremetalManager> baremetal =
+            std::make_unique<BaremetalManager>(arch_it->second, 0x400000, 0x400000);
+        std::shared_ptr<Arion> arion =
+            Arion::new_instance(std::move(baremetal), rootfs_path, {}, rootfs_path + "/root", std::move(config));
+
+        arion->mem->map(0x10000000, 0x3000, 6, "[host]");
+        arion->mem->write_string(0x10001FFC, "split");
+        BYTE *view = arion->mem->view(0x10001FFC, 6);
+        ASSERT_NE(view, nullptr);
+        EXPECT_STREQ((char *)view, "split");
+
+        // Splitting the mapping keeps a single view over contiguous host memory
+        arion->mem->protect(0x10002000, 0x10003000, 4);
+        EXPECT_EQ(arion->mem->view(0x10001FFC, 6), view);
+        view[0] = 'S';
+        EXPECT_EQ(arion->mem->read_ascii(0x10001FFC, 5), "Split");
+
+        arion->mem->unmap(0x10002000, 0x10003000);
+        EXPECT_EQ(arion->mem->view(0x10001FFC, 6), nullptr);
+
+        arion->mem->write_string(0x10001000, "grow");
+        arion->mem->resize_mapping(0x10000000, 0x10000000, 0x10010000);
+        EXPECT_EQ(arion->mem->read_c_string(0x10001000), "grow");
+        EXPECT_NE(arion->mem->view(0x1000F000, 0x1000), nullptr);
+        arion->mem->unmap(0x10000000, 0x10010000);
+        EXPECT_EQ(arion->mem->view(0x10000000, 1), nullptr);
+    }
+    catch (std::exception &e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+}
@@ -0,0 +1,52 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, MappingsIndex)
+{
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        auto arch_it = arion::ARCH_FROM_NAME.find(str_to_uppercase(this->arch));
+        if (arch_it == arion::ARCH_FROM_NAME.end())
+            FAIL() << "No architecture with name : " << this->arch;
+        std::unique_ptr<BaremetalManager> baremetal =
+            std::make_unique<BaremetalManager>(arch_it->second, 0x400000, 0x400000);
+        std::shared_ptr<Arion> arion =
+            Arion::new_instance(std::move(baremetal), rootfs_path, {}, rootfs_path + "/root", std::move(config));
+
+        arion->mem->map(0x10000000, 0x3000, 6, "[first]");
+        arion->mem->map(0x10010000, 0x1000, 4, "[second]");
+        arion->mem->map(0x10020000, 0x2000, 6, "[first]");
+
+        EXPECT_TRUE(arion->mem->is_mapped(0x10000000));
+        EXPECT_TRUE(arion->mem->is_mapped(0x10002FFF));
+        EXPECT_FALSE(arion->mem->is_mapped(0x10003000));
+        EXPECT_EQ(arion->mem->get_mapping_at(0x10010800)->info, "[second]");
+        EXPECT_EQ(arion->mem->get_mapping_by_info("[first]")->start_addr, 0x10000000);
+        EXPECT_FALSE(arion->mem->has_mapping_with_info("[third]"));
+
+        EXPECT_TRUE(arion->mem->can_map(0x10003000, 0xD000));
+        EXPECT_FALSE(arion->mem->can_map(0x10003000, 0xE000));
+        EXPECT_FALSE(arion->mem->can_map(0x1000F000, 0x3000)); // Fully contains [second]
+
+        arion->mem->protect(0x10001000, 0x10002000, 4);
+        EXPECT_EQ(arion->mem->get_mapping_at(0x10000000)->end_addr, 0x10001000);
+        EXPECT_EQ(arion->mem->get_mapping_at(0x10001000)->perms, 4);
+        EXPECT_EQ(arion->mem->get_mapping_at(0x10002000)->start_addr, 0x10002000);
+
+        arion->mem->unmap(0x10000000, 0x10003000);
+        EXPECT_FALSE(arion->mem->is_mapped(0x10001000));
+        EXPECT_EQ(arion->mem->get_mapping_by_info("[first]")->start_addr, 0x10020000);
+        arion->mem->unmap(0x10020000);
+        EXPECT_FALSE(arion->mem->has_mapping_with_info("[first]"));
+        EXPECT_TRUE(arion->mem->has_mapping_with_info("[second]"));
+    }
+    catch (std::exception &e)
+    {
+        FAIL() << "Exception caught: " << e.what();
+    }
+}
@@ -0,0 +1,30 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+
+using namespace arion;
+
+TEST_P(ArionMultiarchTest, AdaptiveQuantumThreads)
+{
+    testing::internal::CaptureStdout();
+    try
+    {
+        std::unique_ptr<Config> config = std::make_unique<Config>();
+        config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+        // Narrow bounds, so that quantums reach them quickly
+        config->set_field<size_t>("min_quantum", 0x100);
+        config->set_field<size_t>("max_quantum", 0x800);
+        std::shared_ptr<ArionGroup> arion_group = std::make_shared<ArionGroup>();
+        std::string rootfs_path = this->arion_root_path + "/rootfs/" + this->arch + "/rootfs";
+        std::shared_ptr<Arion> arion = Arion::new_instance({rootfs_path + "/root/multi_thread/multi_thread"},
+                                                           rootfs_path, {}, rootfs_path + "/root", std::move(config));
+        arion_group->add_arion_instance(arion);
+        arion_group->run();
+    }
+    catch (std::exception &e)
+    {
+        testing::internal::GetCapturedStdout(); // Prevent using GetCapturedStdout() multiple times
+        FAIL() << "Exception caught: " << e.what();
+    }
+    std::string output = testing::internal::GetCapturedStdout();
+    EXPECT_STREQ(output.c_str(), "1\n1\n2\n2\n3\n3\n");
+}
@@ -0,0 +1,58 @@
+#include <arion/arion.hpp>
+#include <arion_test/common.hpp>
+#include <arion_test/shellcode/basic_shellcode.hpp>
+
+using namespace arion;
+
+std::shared_ptr<Arion> new_scheduling_instance()
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<arion::LOG_LEVEL>("log_lvl", arion::LOG_LEVEL::OFF);
+    std::unique_ptr<BaremetalManager> baremetal =
+        std::make_unique<BaremetalManager>(CPU_ARCH::X8664_ARCH, BASIC_SHELLCODE_X86_64, 0x400000);
+    return Arion::new_instance(std::move(baremetal), "/", {}, "/", std::move(config));
+}
+
+pid_t add_sibling_thread(std::shared_ptr<Arion> arion)
+{
+    std::unique_ptr<ARION_THREAD> arion_t =
+        std::make_unique<ARION_THREAD>(0, 0, 0, 0, 0, arion->arch->dump_regs(), 0);
+    return arion->threads->add_thread_entry(std::move(arion_t));
+}
+
+TEST_F(ArionTest, ExitWhileSiblingsParked)
+{
+    std::shared_ptr<Arion> arion = new_scheduling_instance();
+    pid_t main_tid = arion->threads->get_running_tid();
+    pid_t sibling_tid = add_sibling_thread(arion);
+    pid_t worker_tid = add_sibling_thread(arion);
+    arion->threads->switch_to_thread(worker_tid);
+    // The main thread waits for a child process and the sibling waits on a futex
+    arion->threads->park_thread(main_tid);
+    arion->threads->park_thread(sibling_tid);
+    arion->threads->remove_thread_entry(worker_tid);
+    pid_t running_tid = arion->threads->get_running_tid();
+    EXPECT_TRUE(running_tid == main_tid || running_tid == sibling_tid);
+    EXPECT_NO_THROW(arion->threads->is_curr_locked());
+    EXPECT_NO_THROW(arion->threads->get_quantum());
+    arion->threads->unpark_thread(sibling_tid);
+    arion->threads->switch_to_next_thread();
+    EXPECT_EQ(arion->threads->get_running_tid(), sibling_tid);
+}
+
+TEST_F(ArionTest, AdaptiveQuantumPolicy)
+{
+    std::shared_ptr<Arion> arion = new_scheduling_instance();
+    add_sibling_thread(arion);
+    size_t quantum = arion->threads->get_quantum();
+    EXPECT_EQ(quantum, ARION_CYCLES_PER_THREAD);
+    arion->threads->end_time_slice(true); // Stopped early, e.g. by a system call
+    EXPECT_EQ(arion->threads->get_quantum(), quantum);
+    arion->threads->end_time_slice(false);
+    EXPECT_EQ(arion->threads->get_quantum(), quantum * 2);
+    arion->threads->futex_wait_curr(0x1000, ARION_MAX_U32);
+    arion->threads->end_time_slice(true);
+    EXPECT_EQ(arion->threads->get_quantum(), quantum);
+    arion->config->set_field<size_t>("min_quantum", ARION_MAX_CYCLES_PER_THREAD * 2);
+    EXPECT_THROW(arion->threads->end_time_slice(false), arion_exception::InvalidArgumentException);
+}
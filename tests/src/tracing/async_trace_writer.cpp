@@ -0,0 +1,42 @@
+#include <arion/arion.hpp>
+#include <arion/common/code_tracer.hpp>
+#include <arion/components/code_trace_analysis.hpp>
+#include <arion/utils/fs_utils.hpp>
+#include <arion_test/common.hpp>
+#include <filesystem>
+
+using namespace arion;
+
+size_t count_hits(std::string trace_path)
+{
+    size_t hits = 0;
+    std::unique_ptr<CodeTraceAnalyzer> analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path);
+    analyzer->loop_on_every_hit([&hits](std::unique_ptr<ANALYSIS_HIT> hit) {
+        hits++;
+        return true;
+    });
+    return hits;
+}
+
+std::unique_ptr<Config> new_async_config(bool blocking)
+{
+    std::unique_ptr<Config> config = std::make_unique<Config>();
+    config->set_field<size_t>("trace_buffers", 2);
+    config->set_field<bool>("trace_blocking", blocking);
+    return config;
+}
+
+TEST_F(ArionTest, AsyncTraceWriter)
+{
+    std::string blocking_path = gen_tmp_path();
+    std::string growing_path = gen_tmp_path();
+    this->trace_simple_syscalls(blocking_path, TRACE_MODE::CTXT, new_async_config(true));
+    this->trace_simple_syscalls(growing_path, TRACE_MODE::CTXT, new_async_config(false));
+    size_t blocking_hits = count_hits(blocking_path);
+    size_t growing_hits = count_hits(growing_path);
+    EXPECT_GT(blocking_hits, ARION_MAX_HEAVY_HITS * 2);
+    EXPECT_EQ(blocking_hits, growing_hits);
+    EXPECT_EQ(std::filesystem::file_size(blocking_path), std::filesystem::file_size(growing_path));
+    std::filesystem::remove(blocking_path);
+    std::filesystem::remove(growing_path);
+}
@@ -0,0 +1,33 @@
+#include <arion/arion.hpp>
+#include <arion/common/code_tracer.hpp>
+#include <arion/components/code_trace_analysis.hpp>
+#include <arion/unicorn/x86.h>
+#include <arion/utils/fs_utils.hpp>
+#include <arion_test/common.hpp>
+#include <filesystem>
+
+using namespace arion;
+
+TEST_F(ArionTest, CompactTraceFormat)
+{
+    std::string trace_path = gen_tmp_path();
+    this->trace_simple_syscalls(trace_path, TRACE_MODE::CTXT);
+
+    // Registers are only stored when they change, so their values must be rebuilt across hits and chunks
+    size_t hits = 0;
+    std::unique_ptr<ANALYSIS_HIT> prev_hit;
+    std::unique_ptr<CodeTraceAnalyzer> analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path);
+    analyzer->loop_on_every_hit([&](std::unique_ptr<ANALYSIS_HIT> hit) {
+        EXPECT_EQ(hit->hit_i, hits);
+        if (prev_hit && prev_hit->mod_name == hit->mod_name && prev_hit->off + prev_hit->sz == hit->off)
+        {
+            EXPECT_EQ(hit->regs->at(UC_X86_REG_RIP).r64 - prev_hit->regs->at(UC_X86_REG_RIP).r64, prev_hit->sz);
+        }
+        prev_hit = std::move(hit);
+        hits++;
+        return true;
+    });
+    EXPECT_GT(hits, ARION_MAX_HEAVY_HITS * 2);
+    EXPECT_LT(std::filesystem::file_size(trace_path), hits * sizeof(RVAL));
+    std::filesystem::remove(trace_path);
+}
@@ -0,0 +1,38 @@
+#include <arion/arion.hpp>
+#include <arion/common/code_tracer.hpp>
+#include <arion/components/code_trace_analysis.hpp>
+#include <arion/unicorn/x86.h>
+#include <arion/utils/fs_utils.hpp>
+#include <arion_test/common.hpp>
+#include <filesystem>
+
+using namespace arion;
+
+TEST_F(ArionTest, TraceHitViews)
+{
+    std::string trace_path = gen_tmp_path();
+    this->trace_simple_syscalls(trace_path, TRACE_MODE::CTXT);
+
+    std::unique_ptr<CodeTraceAnalyzer> analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path);
+    std::vector<std::unique_ptr<ANALYSIS_HIT>> hits;
+    analyzer->loop_on_every_hit([&hits](std::unique_ptr<ANALYSIS_HIT> hit) {
+        hits.push_back(std::move(hit));
+        return true;
+    });
+    ASSERT_GT(hits.size(), 0);
+
+    size_t rip_i = analyzer->get_reg_index(UC_X86_REG_RIP);
+    size_t views = 0;
+    analyzer->loop_on_every_hit_view([&](off_t hit_i, const TRACE_MODULE &mod, const CODE_HIT_VIEW &hit) {
+        EXPECT_EQ(hit_i, views);
+        std::unique_ptr<ANALYSIS_HIT> &expected_hit = hits.at(views);
+        EXPECT_EQ(mod.name, expected_hit->mod_name);
+        EXPECT_EQ(hit.off, expected_hit->off);
+        EXPECT_EQ(hit.sz, expected_hit->sz);
+        EXPECT_EQ(hit.regs[rip_i].r64, expected_hit->regs->at(UC_X86_REG_RIP).r64);
+        views++;
+        return true;
+    });
+    EXPECT_EQ(views, hits.size());
+    std::filesystem::remove(trace_path);
+}
@@ -0,0 +1,99 @@
+#include <algorithm>
+#include <arion/arion.hpp>
+#include <arion/common/code_tracer.hpp>
+#include <arion/components/code_trace_analysis.hpp>
+#include <arion/components/code_trace_index.hpp>
+#include <arion/utils/fs_utils.hpp>
+#include <arion_test/common.hpp>
+#include <filesystem>
+#include <map>
+
+using namespace arion;
+
+std::vector<off_t> search_hits(std::string trace_path, bool use_index, std::string name, uint32_t start_off,
+                               uint32_t end_off)
+{
+    std::vector<off_t> hits_i;
+    std::unique_ptr<CodeTraceAnalyzer> analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path, use_index);
+    auto collect_hit = [&hits_i](std::unique_ptr<ANALYSIS_HIT> hit) {
+        hits_i.push_back(hit->hit_i);
+        return true;
+    };
+    analyzer->search_hit_offset(collect_hit, name, start_off);
+    analyzer->search_hit_offset_range(collect_hit, name, start_off, end_off);
+    return hits_i;
+}
+
+TEST_F(ArionTest, TraceIndex)
+{
+    std::string trace_path = gen_tmp_path();
+    std::string idx_path = trace_path + TRACE_INDEX_FILE_EXT;
+    this->trace_simple_syscalls(trace_path, TRACE_MODE::INSTR);
+
+    std::vector<std::unique_ptr<ANALYSIS_HIT>> hits;
+    std::unique_ptr<CodeTraceAnalyzer> analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path, false);
+    analyzer->loop_on_every_hit([&hits](std::unique_ptr<ANALYSIS_HIT> hit) {
+        hits.push_back(std::move(hit));
+        return true;
+    });
+    ASSERT_GT(hits.size(), ARION_TRACE_INDEX_BLOCK_HITS + 1);
+    std::unique_ptr<ANALYSIS_HIT> &mid_hit = hits.at(ARION_TRACE_INDEX_BLOCK_HITS + 1);
+
+    // Searching inside the instruction must also find it
+    uint32_t start_off = mid_hit->off + mid_hit->sz - 1, end_off = mid_hit->off + 0x40;
+    std::vector<off_t> scanned_hits = search_hits(trace_path, false, mid_hit->mod_name, start_off, end_off);
+    EXPECT_FALSE(std::filesystem::exists(idx_path));
+    std::vector<off_t> built_hits = search_hits(trace_path, true, mid_hit->mod_name, start_off, end_off);
+    EXPECT_TRUE(std::filesystem::exists(idx_path));
+    std::vector<off_t> loaded_hits = search_hits(trace_path, true, mid_hit->mod_name, start_off, end_off);
+    EXPECT_NE(std::find(scanned_hits.begin(), scanned_hits.end(), mid_hit->hit_i), scanned_hits.end());
+    EXPECT_EQ(scanned_hits, built_hits);
+    EXPECT_EQ(scanned_hits, loaded_hits);
+
+    std::unique_ptr<CodeTraceAnalyzer> idx_analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path);
+    idx_analyzer->reach_offset(mid_hit->mod_name, mid_hit->off);
+    // The cursor stays on the reached hit, so the next one follows it
+    off_t reached_hit_i = -1;
+    idx_analyzer->loop_on_every_hit(
+        [&reached_hit_i](std::unique_ptr<ANALYSIS_HIT> hit) {
+            reached_hit_i = hit->hit_i - 1;
+            return false;
+        },
+        false);
+    // An earlier hit may share the same offset, in which case it is reached first
+    auto first_hit = std::find_if(hits.begin(), hits.end(), [&mid_hit](std::unique_ptr<ANALYSIS_HIT> &hit) {
+        return hit->mod_name == mid_hit->mod_name && hit->off == mid_hit->off;
+    });
+    ASSERT_NE(first_hit, hits.end());
+    EXPECT_LE((*first_hit)->hit_i, mid_hit->hit_i);
+    EXPECT_EQ(reached_hit_i, (*first_hit)->hit_i);
+
+    // Reaching the most hit offset from the middle of its hits seeks through the skip entries of its key
+    std::map<std::pair<std::string, uint32_t>, std::vector<off_t>> off_hits;
+    for (std::unique_ptr<ANALYSIS_HIT> &hit : hits)
+        off_hits[std::make_pair(hit->mod_name, hit->off)].push_back(hit->hit_i);
+    auto hot_off = std::max_element(off_hits.begin(), off_hits.end(), [](auto &off_hits1, auto &off_hits2) {
+        return off_hits1.second.size() < off_hits2.second.size();
+    });
+    std::vector<off_t> &hot_hits = hot_off->second;
+    ASSERT_GT(hot_hits.size(), ARION_TRACE_INDEX_SKIP_POSTINGS * 2);
+    off_t expected_hit_i = hot_hits.at(hot_hits.size() / 2);
+    for (bool use_index : {false, true})
+    {
+        std::unique_ptr<CodeTraceAnalyzer> hot_analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path, use_index);
+        hot_analyzer->loop_on_every_hit([expected_hit_i](std::unique_ptr<ANALYSIS_HIT> hit) {
+            return hit->hit_i < expected_hit_i;
+        });
+        hot_analyzer->reach_offset(hot_off->first.first, hot_off->first.second);
+        reached_hit_i = -1;
+        hot_analyzer->loop_on_every_hit(
+            [&reached_hit_i](std::unique_ptr<ANALYSIS_HIT> hit) {
+                reached_hit_i = hit->hit_i - 1;
+                return false;
+            },
+            false);
+        EXPECT_EQ(reached_hit_i, expected_hit_i);
+    }
+    std::filesystem::remove(trace_path);
+    std::filesystem::remove(idx_path);
+}
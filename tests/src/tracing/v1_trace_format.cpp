@@ -0,0 +1,98 @@
+#include <arion/arion.hpp>
+#include <arion/common/code_tracer.hpp>
+#include <arion/components/code_trace_analysis.hpp>
+#include <arion/unicorn/x86.h>
+#include <arion/utils/fs_utils.hpp>
+#include <arion_test/common.hpp>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <map>
+
+using namespace arion;
+
+template <typename T> void write_field(std::ofstream &trace_f, T val)
+{
+    trace_f.write((char *)&val, sizeof(T));
+}
+
+RVAL make_rval(uint64_t val)
+{
+    RVAL rval{};
+    rval.r64 = val;
+    return rval;
+}
+
+// Writes a trace file the way version 1 writers did, with hit registers in ascending register order
+void write_v1_trace(std::string trace_path, std::vector<REG> ctxt_regs, std::vector<std::map<REG, RVAL>> hits_regs)
+{
+    std::ofstream trace_f(trace_path, std::ios::binary | std::ios::out);
+    trace_f.write(TRACER_FILE_MAGIC, strlen(TRACER_FILE_MAGIC));
+    write_field<float>(trace_f, 1.0);
+    write_field<TRACE_MODE>(trace_f, TRACE_MODE::CTXT);
+    write_field<size_t>(trace_f, hits_regs.size());
+    uint8_t padding = 8 - (trace_f.tellp() % 8);
+    if (padding == 8)
+        padding = 0;
+    write_field<off_t>(trace_f, (off_t)trace_f.tellp() + padding + sizeof(off_t));
+    for (uint8_t pad_i = 0; pad_i < padding; pad_i++)
+        write_field<uint8_t>(trace_f, 0);
+
+    off_t mod_sec_off_pos = trace_f.tellp();
+    write_field<off_t>(trace_f, 0);
+    write_field<off_t>(trace_f, (off_t)trace_f.tellp() + sizeof(off_t) * 2);
+    off_t data_sec_off = (off_t)trace_f.tellp() + sizeof(off_t) + sizeof(size_t) + ctxt_regs.size() * sizeof(REG);
+    write_field<off_t>(trace_f, data_sec_off);
+    write_field<size_t>(trace_f, ctxt_regs.size());
+    for (REG reg : ctxt_regs)
+        write_field<REG>(trace_f, reg);
+
+    uint32_t off = 0;
+    for (std::map<REG, RVAL> &hit_regs : hits_regs)
+    {
+        write_field<uint32_t>(trace_f, off);
+        write_field<uint16_t>(trace_f, 4);
+        write_field<uint16_t>(trace_f, 0);
+        for (auto &reg_it : hit_regs)
+            write_field<RVAL>(trace_f, reg_it.second);
+        off += 4;
+    }
+
+    off_t mod_sec_off = trace_f.tellp();
+    std::string mod_name = "/root/fixture";
+    write_field<uint16_t>(trace_f, 1);
+    write_field<uint16_t>(trace_f, mod_name.size());
+    trace_f.write(mod_name.c_str(), mod_name.size());
+    write_field<ADDR>(trace_f, 0x400000);
+    write_field<uint32_t>(trace_f, 0x1000);
+    write_field<uint16_t>(trace_f, 0);
+    trace_f.seekp(mod_sec_off_pos);
+    write_field<off_t>(trace_f, mod_sec_off);
+}
+
+TEST_F(ArionTest, V1TraceFormat)
+{
+    std::string trace_path = gen_tmp_path();
+    // Unlike the hit registers, the registers section is not sorted
+    std::vector<REG> ctxt_regs = {UC_X86_REG_RSP, UC_X86_REG_RIP, UC_X86_REG_RAX};
+    std::vector<std::map<REG, RVAL>> hits_regs = {{{UC_X86_REG_RAX, make_rval(0x1111)},
+                                                   {UC_X86_REG_RIP, make_rval(0x400000)},
+                                                   {UC_X86_REG_RSP, make_rval(0x7FF0)}},
+                                                  {{UC_X86_REG_RAX, make_rval(0x2222)},
+                                                   {UC_X86_REG_RIP, make_rval(0x400004)},
+                                                   {UC_X86_REG_RSP, make_rval(0x7FE8)}}};
+    write_v1_trace(trace_path, ctxt_regs, hits_regs);
+
+    size_t hits = 0;
+    std::unique_ptr<CodeTraceAnalyzer> analyzer = std::make_unique<CodeTraceAnalyzer>(trace_path, false);
+    analyzer->loop_on_every_hit([&](std::unique_ptr<ANALYSIS_HIT> hit) {
+        EXPECT_EQ(hit->mod_name, "/root/fixture");
+        EXPECT_EQ(hit->off, hits * 4);
+        for (REG reg : ctxt_regs)
+            EXPECT_EQ(hit->regs->at(reg).r64, hits_regs.at(hits).at(reg).r64);
+        hits++;
+        return true;
+    });
+    EXPECT_EQ(hits, hits_regs.size());
+    std::filesystem::remove(trace_path);
+}